@@ -0,0 +1,43 @@
+// Generated by dplc from ./tests/01-add.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        (void)(({ double t1 = ({ double t2 = 123.0; double t3 = 456.0; t2 + t3; }); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 2 /* print(Number): Number */, 1, (DPL_Value[]){dpl_value_make_number(t1)})); }));
+        dplv_release(&vm, ({ DPL_Value t4 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t4})); }));
+        (void)(({ double t5 = ({ double t6 = 123.0; double t7 = 456.0; t6 + t7; }); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 2 /* print(Number): Number */, 1, (DPL_Value[]){dpl_value_make_number(t5)})); }));
+        dplv_release(&vm, ({ DPL_Value t8 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t8})); }));
+        (void)(({ double t9 = ({ double t10 = 123.0; double t11 = 456.0; t10 + t11; }); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 2 /* print(Number): Number */, 1, (DPL_Value[]){dpl_value_make_number(t9)})); }));
+        DPL_Value t0 = ({ DPL_Value t12 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t12})); });
+        t0;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,39 @@
+// Generated by dplc from ./tests/02-comments.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        dplv_release(&vm, ({ DPL_Value t1 = dpl_value_make_string(&vm.stack_pool, 4, "123\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t1})); }));
+        DPL_Value t0 = ({ DPL_Value t2 = dpl_value_make_string(&vm.stack_pool, 4, "456\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t2})); });
+        t0;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,54 @@
+// Generated by dplc from ./tests/03-booleans.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        (void)(({ bool t1 = true; dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t1)})); }));
+        dplv_release(&vm, ({ DPL_Value t2 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t2})); }));
+        (void)(({ bool t3 = false; dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t3)})); }));
+        dplv_release(&vm, ({ DPL_Value t4 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t4})); }));
+        dplv_release(&vm, ({ DPL_Value t5 = ({ DPL_Value t6 = ({ bool t8 = true; (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t8)})); }); DPL_Value t7 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t6, t7}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t5})); }));
+        dplv_release(&vm, ({ DPL_Value t9 = ({ DPL_Value t10 = ({ bool t12 = false; (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t12)})); }); DPL_Value t11 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t10, t11}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t9})); }));
+        bool l0 = true; (void)l0;
+        (void)(({ bool t13 = l0; dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t13)})); }));
+        dplv_release(&vm, ({ DPL_Value t14 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t14})); }));
+        dplv_release(&vm, ({ DPL_Value t15 = ({ DPL_Value t16 = ({ bool t18 = l0; (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t18)})); }); DPL_Value t17 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t16, t17}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t15})); }));
+        bool l1 = false; (void)l1;
+        (void)(({ bool t19 = l1; dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t19)})); }));
+        dplv_release(&vm, ({ DPL_Value t20 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t20})); }));
+        dplv_release(&vm, ({ DPL_Value t21 = ({ DPL_Value t22 = ({ bool t24 = l1; (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t24)})); }); DPL_Value t23 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t22, t23}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t21})); }));
+        (void)(({ bool t25 = true; dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t25)})); }));
+        dplv_release(&vm, ({ DPL_Value t26 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t26})); }));
+        DPL_Value t0 = ({ DPL_Value t27 = ({ DPL_Value t28 = ({ bool t30 = true; (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t30)})); }); DPL_Value t29 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t28, t29}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t27})); });
+        t0;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+// Generated by dplc from ./tests/04-comparisons.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        (void)(({ bool t1 = ({ double t2 = 1.0; double t3 = 0.0; dpl_value_compare_numbers(t2, t3) >= 0; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t1)})); }));
+        dplv_release(&vm, ({ DPL_Value t4 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t4})); }));
+        (void)(({ bool t5 = ({ double t6 = 0.0; double t7 = 1.0; dpl_value_compare_numbers(t6, t7) >= 0; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t5)})); }));
+        dplv_release(&vm, ({ DPL_Value t8 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t8})); }));
+        (void)(({ bool t9 = ({ double t10 = 1.0; double t11 = 1.0; dpl_value_compare_numbers(t10, t11) >= 0; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t9)})); }));
+        dplv_release(&vm, ({ DPL_Value t12 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t12})); }));
+        (void)(({ bool t13 = ({ double t14 = 1.0; double t15 = 0.0; dpl_value_compare_numbers(t14, t15) <= 0; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t13)})); }));
+        dplv_release(&vm, ({ DPL_Value t16 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t16})); }));
+        (void)(({ bool t17 = ({ double t18 = 0.0; double t19 = 1.0; dpl_value_compare_numbers(t18, t19) <= 0; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t17)})); }));
+        dplv_release(&vm, ({ DPL_Value t20 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t20})); }));
+        (void)(({ bool t21 = ({ double t22 = 1.0; double t23 = 1.0; dpl_value_compare_numbers(t22, t23) <= 0; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t21)})); }));
+        dplv_release(&vm, ({ DPL_Value t24 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t24})); }));
+        (void)(({ bool t25 = ({ double t26 = 1.0; double t27 = 0.0; dpl_value_compare_numbers(t26, t27) > 0; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t25)})); }));
+        dplv_release(&vm, ({ DPL_Value t28 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t28})); }));
+        (void)(({ bool t29 = ({ double t30 = 0.0; double t31 = 1.0; dpl_value_compare_numbers(t30, t31) > 0; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t29)})); }));
+        dplv_release(&vm, ({ DPL_Value t32 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t32})); }));
+        (void)(({ bool t33 = ({ double t34 = 1.0; double t35 = 1.0; dpl_value_compare_numbers(t34, t35) > 0; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t33)})); }));
+        dplv_release(&vm, ({ DPL_Value t36 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t36})); }));
+        (void)(({ bool t37 = ({ double t38 = 1.0; double t39 = 0.0; dpl_value_compare_numbers(t38, t39) < 0; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t37)})); }));
+        dplv_release(&vm, ({ DPL_Value t40 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t40})); }));
+        (void)(({ bool t41 = ({ double t42 = 0.0; double t43 = 1.0; dpl_value_compare_numbers(t42, t43) < 0; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t41)})); }));
+        dplv_release(&vm, ({ DPL_Value t44 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t44})); }));
+        (void)(({ bool t45 = ({ double t46 = 1.0; double t47 = 1.0; dpl_value_compare_numbers(t46, t47) < 0; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t45)})); }));
+        dplv_release(&vm, ({ DPL_Value t48 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t48})); }));
+        (void)(({ bool t49 = ({ double t50 = 1.0; double t51 = 0.0; dpl_value_compare_numbers(t50, t51) == 0; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t49)})); }));
+        dplv_release(&vm, ({ DPL_Value t52 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t52})); }));
+        (void)(({ bool t53 = ({ double t54 = 0.0; double t55 = 1.0; dpl_value_compare_numbers(t54, t55) == 0; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t53)})); }));
+        dplv_release(&vm, ({ DPL_Value t56 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t56})); }));
+        (void)(({ bool t57 = ({ double t58 = 1.0; double t59 = 1.0; dpl_value_compare_numbers(t58, t59) == 0; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t57)})); }));
+        dplv_release(&vm, ({ DPL_Value t60 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t60})); }));
+        (void)(({ bool t61 = ({ double t62 = 1.0; double t63 = 0.0; dpl_value_compare_numbers(t62, t63) != 0; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t61)})); }));
+        dplv_release(&vm, ({ DPL_Value t64 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t64})); }));
+        (void)(({ bool t65 = ({ double t66 = 0.0; double t67 = 1.0; dpl_value_compare_numbers(t66, t67) != 0; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t65)})); }));
+        dplv_release(&vm, ({ DPL_Value t68 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t68})); }));
+        (void)(({ bool t69 = ({ double t70 = 1.0; double t71 = 1.0; dpl_value_compare_numbers(t70, t71) != 0; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t69)})); }));
+        dplv_release(&vm, ({ DPL_Value t72 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t72})); }));
+        (void)(({ bool t73 = ({ DPL_Value t74 = dpl_value_make_string(&vm.stack_pool, 3, "foo"); DPL_Value t75 = dpl_value_make_string(&vm.stack_pool, 3, "foo"); dplv_runtime_string_equals(&vm, t74, t75); }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t73)})); }));
+        dplv_release(&vm, ({ DPL_Value t76 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t76})); }));
+        (void)(({ bool t77 = ({ DPL_Value t78 = dpl_value_make_string(&vm.stack_pool, 3, "foo"); DPL_Value t79 = dpl_value_make_string(&vm.stack_pool, 3, "foo"); !dplv_runtime_string_equals(&vm, t78, t79); }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t77)})); }));
+        dplv_release(&vm, ({ DPL_Value t80 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t80})); }));
+        (void)(({ bool t81 = ({ DPL_Value t82 = dpl_value_make_string(&vm.stack_pool, 3, "foo"); DPL_Value t83 = dpl_value_make_string(&vm.stack_pool, 3, "bar"); dplv_runtime_string_equals(&vm, t82, t83); }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t81)})); }));
+        dplv_release(&vm, ({ DPL_Value t84 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t84})); }));
+        (void)(({ bool t85 = ({ DPL_Value t86 = dpl_value_make_string(&vm.stack_pool, 3, "foo"); DPL_Value t87 = dpl_value_make_string(&vm.stack_pool, 3, "bar"); !dplv_runtime_string_equals(&vm, t86, t87); }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t85)})); }));
+        dplv_release(&vm, ({ DPL_Value t88 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t88})); }));
+        (void)(({ bool t89 = ({ bool t90 = true; bool t91 = true; t90 == t91; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t89)})); }));
+        dplv_release(&vm, ({ DPL_Value t92 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t92})); }));
+        (void)(({ bool t93 = ({ bool t94 = true; bool t95 = true; t94 != t95; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t93)})); }));
+        dplv_release(&vm, ({ DPL_Value t96 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t96})); }));
+        (void)(({ bool t97 = ({ bool t98 = true; bool t99 = false; t98 == t99; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t97)})); }));
+        dplv_release(&vm, ({ DPL_Value t100 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t100})); }));
+        (void)(({ bool t101 = ({ bool t102 = true; bool t103 = false; t102 != t103; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t101)})); }));
+        DPL_Value t0 = ({ DPL_Value t104 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t104})); });
+        t0;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
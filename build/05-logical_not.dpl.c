@@ -0,0 +1,41 @@
+// Generated by dplc from ./tests/05-logical_not.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        (void)(({ bool t1 = ({ bool t2 = true; !t2; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t1)})); }));
+        dplv_release(&vm, ({ DPL_Value t3 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t3})); }));
+        (void)(({ bool t4 = ({ bool t5 = false; !t5; }); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t4)})); }));
+        DPL_Value t0 = ({ DPL_Value t6 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t6})); });
+        t0;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,52 @@
+// Generated by dplc from ./tests/06-conditionals.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+static double dpl_function_0(double l0, double l1);
+
+// max
+static double dpl_function_0(double l0, double l1)
+{
+    double result;
+    result = (({ double t0 = l0; double t1 = l1; dpl_value_compare_numbers(t0, t1) > 0; })
+        ? l0
+        : l1);
+    return result;
+}
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        (void)(({ double t3 = ({ double t4 = 1.0; double t5 = 2.0; dpl_function_0(t4, t5); }); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 2 /* print(Number): Number */, 1, (DPL_Value[]){dpl_value_make_number(t3)})); }));
+        dplv_release(&vm, ({ DPL_Value t6 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t6})); }));
+        (void)(({ double t7 = ({ double t8 = 420.0; double t9 = ({ double t10 = 34.0; double t11 = 35.0; t10 + t11; }); dpl_function_0(t8, t9); }); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 2 /* print(Number): Number */, 1, (DPL_Value[]){dpl_value_make_number(t7)})); }));
+        DPL_Value t2 = ({ DPL_Value t12 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t12})); });
+        t2;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
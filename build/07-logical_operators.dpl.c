@@ -0,0 +1,59 @@
+// Generated by dplc from ./tests/07-logical_operators.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        (void)(({ bool t1 = (true && true); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t1)})); }));
+        dplv_release(&vm, ({ DPL_Value t2 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t2})); }));
+        (void)(({ bool t3 = (true && false); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t3)})); }));
+        dplv_release(&vm, ({ DPL_Value t4 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t4})); }));
+        (void)(({ bool t5 = (false && true); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t5)})); }));
+        dplv_release(&vm, ({ DPL_Value t6 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t6})); }));
+        (void)(({ bool t7 = (false && false); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t7)})); }));
+        dplv_release(&vm, ({ DPL_Value t8 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t8})); }));
+        (void)(({ bool t9 = (true || true); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t9)})); }));
+        dplv_release(&vm, ({ DPL_Value t10 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t10})); }));
+        (void)(({ bool t11 = (true || false); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t11)})); }));
+        dplv_release(&vm, ({ DPL_Value t12 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t12})); }));
+        (void)(({ bool t13 = (false || true); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t13)})); }));
+        dplv_release(&vm, ({ DPL_Value t14 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t14})); }));
+        (void)(({ bool t15 = (false || false); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t15)})); }));
+        dplv_release(&vm, ({ DPL_Value t16 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t16})); }));
+        (void)(({ bool t17 = ((false || false) || true); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t17)})); }));
+        dplv_release(&vm, ({ DPL_Value t18 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t18})); }));
+        (void)(({ bool t19 = (false || (true && false)); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t19)})); }));
+        dplv_release(&vm, ({ DPL_Value t20 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t20})); }));
+        (void)(({ bool t21 = ((false && true) || false); dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 0 /* print(Boolean): Boolean */, 1, (DPL_Value[]){dpl_value_make_boolean(t21)})); }));
+        DPL_Value t0 = ({ DPL_Value t22 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t22})); });
+        t0;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
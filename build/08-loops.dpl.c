@@ -0,0 +1,82 @@
+// Generated by dplc from ./tests/08-loops.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+static double dpl_function_0(double l0);
+
+// fibonacci
+static double dpl_function_0(double l0)
+{
+    double result;
+    result = (({ double t0 = l0; double t1 = 1.0; dpl_value_compare_numbers(t0, t1) <= 0; })
+        ? l0
+        : ({
+            double l1 = 1.0; (void)l1;
+            double l2 = 1.0; (void)l2;
+            double l3 = 2.0; (void)l3;
+            dplv_release(&vm, ({
+                DPL_Value t3 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (({ double t4 = l3; double t5 = l0; dpl_value_compare_numbers(t4, t5) < 0; }))
+                {
+                    (void)(({
+                        double l5 = l1; (void)l5;
+                        (void)((l1 = ({ double t7 = l1; double t8 = l2; t7 + t8; })));
+                        (void)((l2 = l5));
+                        double t6 = (l3 = ({ double t9 = l3; double t10 = 1.0; t9 + t10; }));
+                        t6;
+                    }));
+                }
+                t3;
+            }));
+            double t2 = l1;
+            t2;
+        }));
+    return result;
+}
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        double l0 = 1.0; (void)l0;
+        DPL_Value t11 = ({
+            DPL_Value t12 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+            while (({ double t13 = l0; double t14 = 20.0; dpl_value_compare_numbers(t13, t14) < 0; }))
+            {
+                (void)(({
+                    (void)(({ double t16 = ({ double t17 = l0; dpl_function_0(t17); }); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 2 /* print(Number): Number */, 1, (DPL_Value[]){dpl_value_make_number(t16)})); }));
+                    dplv_release(&vm, ({ DPL_Value t18 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t18})); }));
+                    double t15 = (l0 = ({ double t19 = l0; double t20 = 1.0; t19 + t20; }));
+                    t15;
+                }));
+            }
+            t12;
+        });
+        t11;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
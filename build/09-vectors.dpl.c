@@ -0,0 +1,81 @@
+// Generated by dplc from ./tests/09-vectors.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+static DPL_Value dpl_function_0(DPL_Value l0);
+static DPL_Value dpl_function_1(DPL_Value l0, DPL_Value l1);
+
+// toString
+static DPL_Value dpl_function_0(DPL_Value l0)
+{
+    DPL_Value result;
+    result = ({ DPL_Value t0 = dpl_value_make_string(&vm.stack_pool, 4, "[x: "); DPL_Value t1 = ({ double t5 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 0); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t5)})); }); DPL_Value t2 = dpl_value_make_string(&vm.stack_pool, 5, ", y: "); DPL_Value t3 = ({ double t6 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 1); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t6)})); }); DPL_Value t4 = dpl_value_make_string(&vm.stack_pool, 1, "]"); dplv_runtime_interpolation(&vm, 5, (DPL_Value[]){t0, t1, t2, t3, t4}); });
+    dplv_release(&vm, l0);
+    return result;
+}
+
+// add
+static DPL_Value dpl_function_1(DPL_Value l0, DPL_Value l1)
+{
+    DPL_Value result;
+    result = ({ DPL_Value t7 = dpl_value_make_number(({ double t9 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 0); double t10 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l1), 0); t9 + t10; })); DPL_Value t8 = dpl_value_make_number(({ double t11 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 1); double t12 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l1), 1); t11 + t12; })); dplv_runtime_create_object_reuse(&vm, l0, 2, (DPL_Value[]){t7, t8}); });
+    dplv_release(&vm, l0);
+    dplv_release(&vm, l1);
+    return result;
+}
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        double l0 = 2.0; (void)l0;
+        DPL_Value l1 = ({ DPL_Value t14 = dpl_value_make_number(1.0); DPL_Value t15 = dpl_value_make_number(l0); dpl_value_make_object(&vm.stack_pool, 2, (DPL_Value[]){t14, t15}); });
+        DPL_Value l2 = ({ DPL_Value t16 = dpl_value_make_number(1.0); DPL_Value t17 = dpl_value_make_number(({ double t18 = 2.0; double t19 = 3.0; t18 * t19; })); dpl_value_make_object(&vm.stack_pool, 2, (DPL_Value[]){t16, t17}); });
+        dplv_release(&vm, ({ DPL_Value t20 = ({ DPL_Value t21 = dpl_value_make_string(&vm.stack_pool, 9, "p1     : "); DPL_Value t22 = ({ DPL_Value t24 = dplv_reference(&vm, l1); dpl_function_0(t24); }); DPL_Value t23 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 3, (DPL_Value[]){t21, t22, t23}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t20})); }));
+        dplv_release(&vm, ({ DPL_Value t25 = ({ DPL_Value t26 = dpl_value_make_string(&vm.stack_pool, 9, "p2     : "); DPL_Value t27 = ({ DPL_Value t29 = dplv_reference(&vm, l2); dpl_function_0(t29); }); DPL_Value t28 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 3, (DPL_Value[]){t26, t27, t28}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t25})); }));
+        dplv_release(&vm, ({ DPL_Value t30 = ({ DPL_Value t31 = dpl_value_make_string(&vm.stack_pool, 9, "p1 + p2: "); DPL_Value t32 = ({ DPL_Value t34 = ({ DPL_Value t35 = dplv_reference(&vm, l1); DPL_Value t36 = dplv_reference(&vm, l2); dpl_function_1(t35, t36); }); dpl_function_0(t34); }); DPL_Value t33 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 3, (DPL_Value[]){t31, t32, t33}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t30})); }));
+        dplv_release(&vm, ({ DPL_Value t37 = ({
+            DPL_Value l3 = dplv_runtime_move(&l1);
+            DPL_Value t38 = ({ DPL_Value t39 = dpl_value_make_number(({ double t41 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l3), 0); double t42 = 3.0; t41 * t42; })); DPL_Value t40 = dpl_value_make_number(dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l3), 1)); dplv_runtime_create_object_reuse(&vm, l3, 2, (DPL_Value[]){t39, t40}); });
+            dplv_release(&vm, l3);
+            t38;
+        }); dplv_release(&vm, l1); l1 = dplv_reference(&vm, t37); t37; }));
+        dplv_release(&vm, ({ DPL_Value t43 = ({
+            DPL_Value l3 = dplv_runtime_move(&l2);
+            DPL_Value t44 = ({ DPL_Value t45 = dpl_value_make_number(dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l3), 0)); DPL_Value t46 = dpl_value_make_number(({ double t47 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l3), 0); double t48 = 21.0; t47 * t48; })); dplv_runtime_create_object_reuse(&vm, l3, 2, (DPL_Value[]){t45, t46}); });
+            dplv_release(&vm, l3);
+            t44;
+        }); dplv_release(&vm, l2); l2 = dplv_reference(&vm, t43); t43; }));
+        dplv_release(&vm, ({ DPL_Value t49 = ({ DPL_Value t50 = dpl_value_make_string(&vm.stack_pool, 9, "p1     : "); DPL_Value t51 = ({ DPL_Value t53 = dplv_reference(&vm, l1); dpl_function_0(t53); }); DPL_Value t52 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 3, (DPL_Value[]){t50, t51, t52}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t49})); }));
+        dplv_release(&vm, ({ DPL_Value t54 = ({ DPL_Value t55 = dpl_value_make_string(&vm.stack_pool, 9, "p2     : "); DPL_Value t56 = ({ DPL_Value t58 = dplv_reference(&vm, l2); dpl_function_0(t58); }); DPL_Value t57 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 3, (DPL_Value[]){t55, t56, t57}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t54})); }));
+        DPL_Value t13 = ({ DPL_Value t59 = ({ DPL_Value t60 = dpl_value_make_string(&vm.stack_pool, 9, "p1 + p2: "); DPL_Value t61 = ({ DPL_Value t63 = ({ DPL_Value t64 = dplv_reference(&vm, l1); DPL_Value t65 = dplv_reference(&vm, l2); dpl_function_1(t64, t65); }); dpl_function_0(t63); }); DPL_Value t62 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 3, (DPL_Value[]){t60, t61, t62}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t59})); });
+        dplv_release(&vm, l1);
+        dplv_release(&vm, l2);
+        t13;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,51 @@
+// Generated by dplc from ./tests/10-string-interpolation.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+static DPL_Value dpl_function_0(DPL_Value l0);
+
+// toString
+static DPL_Value dpl_function_0(DPL_Value l0)
+{
+    DPL_Value result;
+    result = ({ DPL_Value t0 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l0), 0); DPL_Value t1 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t2 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l0), 1); dplv_runtime_interpolation(&vm, 3, (DPL_Value[]){t0, t1, t2}); });
+    dplv_release(&vm, l0);
+    return result;
+}
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        dplv_release(&vm, ({ DPL_Value t4 = ({ DPL_Value t5 = dpl_value_make_string(&vm.stack_pool, 8, "1 + 2 = "); DPL_Value t6 = ({ double t8 = ({ double t9 = 1.0; double t10 = 2.0; t9 + t10; }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t8)})); }); DPL_Value t7 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 3, (DPL_Value[]){t5, t6, t7}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t4})); }));
+        DPL_Value l0 = ({ DPL_Value t11 = dpl_value_make_string(&vm.stack_pool, 4, "John"); DPL_Value t12 = dpl_value_make_string(&vm.stack_pool, 3, "Doe"); dpl_value_make_object(&vm.stack_pool, 2, (DPL_Value[]){t11, t12}); });
+        DPL_Value t3 = ({ DPL_Value t13 = ({ DPL_Value t14 = dpl_value_make_string(&vm.stack_pool, 5, "p is "); DPL_Value t15 = ({ DPL_Value t17 = dplv_reference(&vm, l0); dpl_function_0(t17); }); DPL_Value t16 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 3, (DPL_Value[]){t14, t15, t16}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t13})); });
+        dplv_release(&vm, l0);
+        t3;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+// Generated by dplc from ./tests/12-iterators.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        dplv_release(&vm, ({
+            DPL_Value l0 = ({ DPL_Value t2 = ({ DPL_Value t3 = dpl_value_make_number(0.0); DPL_Value t4 = dpl_value_make_number(8.0); dpl_value_make_object(&vm.stack_pool, 2, (DPL_Value[]){t3, t4}); }); (dplv_runtime_call_intrinsic(&vm, 5 /* iterator(Range<Number>): Iterator<Number> */, 1, (DPL_Value[]){t2})); });
+            DPL_Value t1 = ({
+                DPL_Value t5 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (({ bool t6 = dplv_runtime_load_field_boolean(&vm, dplv_reference(&vm, l0), 1); !t6; }))
+                {
+                    dplv_release(&vm, ({
+                        double l2 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 0); (void)l2;
+                        dplv_release(&vm, ({ DPL_Value t8 = ({ DPL_Value t9 = ({ double t11 = l2; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t11)})); }); DPL_Value t10 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t9, t10}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t8})); }));
+                        DPL_Value t7 = ({ DPL_Value t12 = ({ DPL_Value t13 = dplv_runtime_move(&l0); (dplv_runtime_call_intrinsic(&vm, 4 /* next(Iterator<Number>): Iterator<Number> */, 1, (DPL_Value[]){t13})); }); dplv_release(&vm, l0); l0 = dplv_reference(&vm, t12); t12; });
+                        t7;
+                    }));
+                }
+                t5;
+            });
+            dplv_release(&vm, l0);
+            t1;
+        }));
+        dplv_release(&vm, ({
+            DPL_Value l0 = ({ DPL_Value t15 = ({ DPL_Value t16 = dpl_value_make_number(0.0); DPL_Value t17 = dpl_value_make_number(8.0); dpl_value_make_object(&vm.stack_pool, 2, (DPL_Value[]){t16, t17}); }); (dplv_runtime_call_intrinsic(&vm, 5 /* iterator(Range<Number>): Iterator<Number> */, 1, (DPL_Value[]){t15})); });
+            DPL_Value t14 = ({
+                DPL_Value t18 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (({ bool t19 = dplv_runtime_load_field_boolean(&vm, dplv_reference(&vm, l0), 1); !t19; }))
+                {
+                    dplv_release(&vm, ({
+                        double l2 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 0); (void)l2;
+                        DPL_Value l3 = ({ DPL_Value t21 = ({ DPL_Value t22 = ({ double t24 = l2; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t24)})); }); DPL_Value t23 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t22, t23}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t21})); });
+                        dplv_release(&vm, ({ DPL_Value t25 = ({ DPL_Value t26 = dplv_runtime_move(&l0); (dplv_runtime_call_intrinsic(&vm, 4 /* next(Iterator<Number>): Iterator<Number> */, 1, (DPL_Value[]){t26})); }); dplv_release(&vm, l0); l0 = dplv_reference(&vm, t25); t25; }));
+                        DPL_Value t20 = dplv_reference(&vm, l3);
+                        dplv_release(&vm, l3);
+                        t20;
+                    }));
+                }
+                t18;
+            });
+            dplv_release(&vm, l0);
+            t14;
+        }));
+        dplv_release(&vm, ({
+            DPL_Value l0 = ({ DPL_Value t28 = dpl_value_make_number(0.0); DPL_Value t29 = dpl_value_make_number(8.0); dpl_value_make_object(&vm.stack_pool, 2, (DPL_Value[]){t28, t29}); });
+            double l1 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 0); (void)l1;
+            double l2 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 1); (void)l2;
+            DPL_Value t27 = ({
+                DPL_Value t30 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l1 > l2))
+                {
+                    dplv_release(&vm, ({
+                        double l4 = l1; (void)l4;
+                        DPL_Value l5 = ({ DPL_Value t32 = ({ DPL_Value t33 = ({ double t35 = l4; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t35)})); }); DPL_Value t34 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t33, t34}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t32})); });
+                        (void)((l1 = ({ double t36 = l1; double t37 = 1.0; t36 + t37; })));
+                        DPL_Value t31 = dplv_reference(&vm, l5);
+                        dplv_release(&vm, l5);
+                        t31;
+                    }));
+                }
+                t30;
+            });
+            dplv_release(&vm, l0);
+            t27;
+        }));
+        DPL_Value t0 = ({
+            double l0 = 0.0; (void)l0;
+            double l1 = 8.0; (void)l1;
+            DPL_Value t38 = ({
+                DPL_Value t39 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l0 > l1))
+                {
+                    dplv_release(&vm, ({
+                        double l3 = l0; (void)l3;
+                        DPL_Value l4 = ({ DPL_Value t41 = ({ DPL_Value t42 = ({ double t44 = l3; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t44)})); }); DPL_Value t43 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t42, t43}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t41})); });
+                        (void)((l0 = ({ double t45 = l0; double t46 = 1.0; t45 + t46; })));
+                        DPL_Value t40 = dplv_reference(&vm, l4);
+                        dplv_release(&vm, l4);
+                        t40;
+                    }));
+                }
+                t39;
+            });
+            t38;
+        });
+        t0;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+// Generated by dplc from ./tests/13-fibonacci-iterator.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+static DPL_Value dpl_function_0(double l0);
+static DPL_Value dpl_function_1(DPL_Value l0);
+
+// fibonacci
+static DPL_Value dpl_function_0(double l0)
+{
+    DPL_Value result;
+    result = ({ DPL_Value t0 = dpl_value_make_number(1.0); DPL_Value t1 = dpl_value_make_boolean(({ double t5 = l0; double t6 = 0.0; dpl_value_compare_numbers(t5, t6) <= 0; })); DPL_Value t2 = dpl_value_make_number(0.0); DPL_Value t3 = dpl_value_make_number(0.0); DPL_Value t4 = dpl_value_make_number(l0); dpl_value_make_object(&vm.stack_pool, 5, (DPL_Value[]){t0, t1, t2, t3, t4}); });
+    return result;
+}
+
+// next
+static DPL_Value dpl_function_1(DPL_Value l0)
+{
+    DPL_Value result;
+    result = ({ DPL_Value t7 = dpl_value_make_number(({ double t12 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 3); double t13 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 0); t12 + t13; })); DPL_Value t8 = dpl_value_make_boolean(({ double t14 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 2); double t15 = ({ double t16 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 4); double t17 = 1.0; t16 - t17; }); dpl_value_compare_numbers(t14, t15) >= 0; })); DPL_Value t9 = dpl_value_make_number(({ double t18 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 2); double t19 = 1.0; t18 + t19; })); DPL_Value t10 = dpl_value_make_number(dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 0)); DPL_Value t11 = dpl_value_make_number(dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 4)); dplv_runtime_create_object_reuse(&vm, l0, 5, (DPL_Value[]){t7, t8, t9, t10, t11}); });
+    dplv_release(&vm, l0);
+    return result;
+}
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        DPL_Value t20 = ({
+            DPL_Value l0 = ({ double t22 = 10.0; dpl_function_0(t22); });
+            DPL_Value t21 = ({
+                DPL_Value t23 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (({ bool t24 = dplv_runtime_load_field_boolean(&vm, dplv_reference(&vm, l0), 1); !t24; }))
+                {
+                    dplv_release(&vm, ({
+                        double l2 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 0); (void)l2;
+                        DPL_Value l3 = ({ DPL_Value t26 = ({ DPL_Value t27 = ({ double t29 = l2; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t29)})); }); DPL_Value t28 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t27, t28}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t26})); });
+                        dplv_release(&vm, ({ DPL_Value t30 = ({ DPL_Value t31 = dplv_runtime_move(&l0); dpl_function_1(t31); }); dplv_release(&vm, l0); l0 = dplv_reference(&vm, t30); t30; }));
+                        DPL_Value t25 = dplv_reference(&vm, l3);
+                        dplv_release(&vm, l3);
+                        t25;
+                    }));
+                }
+                t23;
+            });
+            dplv_release(&vm, l0);
+            t21;
+        });
+        t20;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
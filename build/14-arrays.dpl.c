@@ -0,0 +1,117 @@
+// Generated by dplc from ./tests/14-arrays.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        DPL_Value l0 = ({ DPL_Runtime_Array t1 = {0}; dplv_runtime_array_append(&t1, dpl_value_make_number(10.0)); dplv_runtime_array_append(&t1, dpl_value_make_number(20.0)); dplv_runtime_array_append(&t1, dpl_value_make_number(30.0)); dplv_runtime_array_append(&t1, dpl_value_make_number(40.0)); dplv_runtime_array_append(&t1, dpl_value_make_number(50.0)); dplv_runtime_array_end(&vm, &t1); });
+        dplv_release(&vm, ({ DPL_Value t2 = ({ DPL_Value t3 = ({ double t5 = ({ DPL_Value t6 = dplv_reference(&vm, l0); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 8 /* <T>length([T]): Number */, 1, (DPL_Value[]){t6})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t5)})); }); DPL_Value t4 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t3, t4}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t2})); }));
+        dplv_release(&vm, ({
+            double l1 = 0.0; (void)l1;
+            double l2 = ({ double t8 = ({ DPL_Value t10 = dplv_reference(&vm, l0); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 8 /* <T>length([T]): Number */, 1, (DPL_Value[]){t10})); }); double t9 = 1.0; t8 - t9; }); (void)l2;
+            DPL_Value t7 = ({
+                DPL_Value t11 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l1 > l2))
+                {
+                    dplv_release(&vm, ({
+                        double l4 = l1; (void)l4;
+                        DPL_Value l5 = ({
+                            DPL_Value t13 = ({ DPL_Value t14 = ({ DPL_Value t15 = dpl_value_make_string(&vm.stack_pool, 1, "#"); DPL_Value t16 = ({ double t20 = ({ double t21 = l4; double t22 = 1.0; t21 + t22; }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t20)})); }); DPL_Value t17 = dpl_value_make_string(&vm.stack_pool, 2, ": "); DPL_Value t18 = ({ double t23 = ({ DPL_Value t24 = dplv_reference(&vm, l0); double t25 = l4; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t24, dpl_value_make_number(t25)})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t23)})); }); DPL_Value t19 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 5, (DPL_Value[]){t15, t16, t17, t18, t19}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t14})); });
+                            t13;
+                        });
+                        (void)((l1 = ({ double t26 = l1; double t27 = 1.0; t26 + t27; })));
+                        DPL_Value t12 = dplv_reference(&vm, l5);
+                        dplv_release(&vm, l5);
+                        t12;
+                    }));
+                }
+                t11;
+            });
+            t7;
+        }));
+        DPL_Value l1 = ({ DPL_Runtime_Array t28 = {0}; dplv_runtime_array_end(&vm, &t28); });
+        dplv_release(&vm, ({ DPL_Value t29 = ({ DPL_Value t30 = ({ double t32 = ({ DPL_Value t33 = dplv_reference(&vm, l1); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 8 /* <T>length([T]): Number */, 1, (DPL_Value[]){t33})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t32)})); }); DPL_Value t31 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t30, t31}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t29})); }));
+        DPL_Value l2 = dplv_reference(&vm, l1);
+        dplv_release(&vm, ({ DPL_Value t34 = ({ DPL_Value t35 = ({ double t37 = ({ DPL_Value t38 = dplv_reference(&vm, l2); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 8 /* <T>length([T]): Number */, 1, (DPL_Value[]){t38})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t37)})); }); DPL_Value t36 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t35, t36}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t34})); }));
+        dplv_release(&vm, ({ DPL_Value t39 = ({ DPL_Runtime_Array t40 = {0}; dplv_runtime_array_append(&t40, dpl_value_make_number(0.0)); dplv_runtime_array_spread(&vm, &t40, dplv_reference(&vm, l0)); dplv_runtime_array_append(&t40, dpl_value_make_number(({ double t41 = ({ double t43 = ({ DPL_Value t45 = dplv_reference(&vm, l0); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 8 /* <T>length([T]): Number */, 1, (DPL_Value[]){t45})); }); double t44 = 1.0; t43 + t44; }); double t42 = 10.0; t41 * t42; }))); dplv_runtime_array_end(&vm, &t40); }); dplv_release(&vm, l0); l0 = dplv_reference(&vm, t39); t39; }));
+        dplv_release(&vm, ({
+            double l3 = 0.0; (void)l3;
+            double l4 = ({ double t47 = ({ DPL_Value t49 = dplv_reference(&vm, l0); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 8 /* <T>length([T]): Number */, 1, (DPL_Value[]){t49})); }); double t48 = 1.0; t47 - t48; }); (void)l4;
+            DPL_Value t46 = ({
+                DPL_Value t50 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l3 > l4))
+                {
+                    dplv_release(&vm, ({
+                        double l6 = l3; (void)l6;
+                        DPL_Value l7 = ({
+                            DPL_Value t52 = ({ DPL_Value t53 = ({ DPL_Value t54 = dpl_value_make_string(&vm.stack_pool, 1, "#"); DPL_Value t55 = ({ double t59 = ({ double t60 = l6; double t61 = 1.0; t60 + t61; }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t59)})); }); DPL_Value t56 = dpl_value_make_string(&vm.stack_pool, 2, ": "); DPL_Value t57 = ({ double t62 = ({ DPL_Value t63 = dplv_reference(&vm, l0); double t64 = l6; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t63, dpl_value_make_number(t64)})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t62)})); }); DPL_Value t58 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 5, (DPL_Value[]){t54, t55, t56, t57, t58}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t53})); });
+                            t52;
+                        });
+                        (void)((l3 = ({ double t65 = l3; double t66 = 1.0; t65 + t66; })));
+                        DPL_Value t51 = dplv_reference(&vm, l7);
+                        dplv_release(&vm, l7);
+                        t51;
+                    }));
+                }
+                t50;
+            });
+            t46;
+        }));
+        DPL_Value t0 = ({
+            DPL_Value l3 = dplv_reference(&vm, l0);
+            double l4 = 0.0; (void)l4;
+            DPL_Value t67 = ({
+                DPL_Value t68 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while ((l4 < dpl_value_array_element_count(dpl_value_as_array(l3))))
+                {
+                    dplv_release(&vm, ({
+                        double l6 = ({ DPL_Value t70 = dplv_reference(&vm, l3); double t71 = l4; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t70, dpl_value_make_number(t71)})); }); (void)l6;
+                        DPL_Value l7 = ({
+                            DPL_Value t72 = ({ DPL_Value t73 = ({ DPL_Value t74 = dpl_value_make_string(&vm.stack_pool, 1, "#"); DPL_Value t75 = ({ double t77 = l6; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t77)})); }); DPL_Value t76 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 3, (DPL_Value[]){t74, t75, t76}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t73})); });
+                            t72;
+                        });
+                        (void)((l4 = ({ double t78 = l4; double t79 = 1.0; t78 + t79; })));
+                        DPL_Value t69 = dplv_reference(&vm, l7);
+                        dplv_release(&vm, l7);
+                        t69;
+                    }));
+                }
+                t68;
+            });
+            dplv_release(&vm, l3);
+            t67;
+        });
+        dplv_release(&vm, l0);
+        dplv_release(&vm, l1);
+        dplv_release(&vm, l2);
+        t0;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
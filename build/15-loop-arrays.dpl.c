@@ -0,0 +1,84 @@
+// Generated by dplc from ./tests/15-loop-arrays.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        DPL_Value l0 = ({
+            double l0 = 1.0; (void)l0;
+            double l1 = 10.0; (void)l1;
+            DPL_Value t1 = ({
+                DPL_Value t2 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l0 > l1))
+                {
+                    t2 = dplv_runtime_concat_array(&vm, t2, dpl_value_make_number(({
+                        double l3 = l0; (void)l3;
+                        double l4 = ({ double t4 = 2.0; double t5 = l3; t4 * t5; }); (void)l4;
+                        (void)((l0 = ({ double t6 = l0; double t7 = 1.0; t6 + t7; })));
+                        double t3 = l4;
+                        t3;
+                    })));
+                }
+                t2;
+            });
+            t1;
+        });
+        dplv_release(&vm, ({ DPL_Value t8 = dpl_value_make_string(&vm.stack_pool, 1, "["); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t8})); }));
+        dplv_release(&vm, ({
+            double l1 = 0.0; (void)l1;
+            double l2 = ({ double t10 = ({ DPL_Value t12 = dplv_reference(&vm, l0); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 8 /* <T>length([T]): Number */, 1, (DPL_Value[]){t12})); }); double t11 = 1.0; t10 - t11; }); (void)l2;
+            DPL_Value t9 = ({
+                DPL_Value t13 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l1 > l2))
+                {
+                    (void)(({
+                        double l4 = l1; (void)l4;
+                        double l5 = ({
+                            dplv_release(&vm, (({ double t16 = l4; double t17 = 0.0; dpl_value_compare_numbers(t16, t17) > 0; })
+                                ? ({ DPL_Value t18 = dpl_value_make_string(&vm.stack_pool, 2, ", "); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t18})); })
+                                : dpl_value_make_string(&vm.stack_pool, 0, "")));
+                            double t15 = ({ double t19 = ({ DPL_Value t20 = dplv_reference(&vm, l0); double t21 = l4; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t20, dpl_value_make_number(t21)})); }); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 2 /* print(Number): Number */, 1, (DPL_Value[]){dpl_value_make_number(t19)})); });
+                            t15;
+                        }); (void)l5;
+                        (void)((l1 = ({ double t22 = l1; double t23 = 1.0; t22 + t23; })));
+                        double t14 = l5;
+                        t14;
+                    }));
+                }
+                t13;
+            });
+            t9;
+        }));
+        DPL_Value t0 = ({ DPL_Value t24 = dpl_value_make_string(&vm.stack_pool, 2, "]\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t24})); });
+        dplv_release(&vm, l0);
+        t0;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
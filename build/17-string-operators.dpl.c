@@ -0,0 +1,50 @@
+// Generated by dplc from ./tests/17-string-operators.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        DPL_Value l0 = ({ DPL_Value t1 = dpl_value_make_string(&vm.stack_pool, 5, "Hello"); DPL_Value t2 = dpl_value_make_string(&vm.stack_pool, 2, ", "); dplv_runtime_concat_string(&vm, t1, t2); });
+        DPL_Value l1 = dpl_value_make_string(&vm.stack_pool, 5, "World");
+        dplv_release(&vm, ({ DPL_Value t3 = ({ DPL_Value t4 = ({ DPL_Value t6 = dplv_reference(&vm, l0); DPL_Value t7 = dplv_reference(&vm, l1); dplv_runtime_concat_string(&vm, t6, t7); }); DPL_Value t5 = dpl_value_make_string(&vm.stack_pool, 2, "!\n"); dplv_runtime_concat_string(&vm, t4, t5); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t3})); }));
+        dplv_release(&vm, ({ DPL_Value t8 = ({ DPL_Value t9 = ({ bool t11 = ({ DPL_Value t12 = dpl_value_make_string(&vm.stack_pool, 3, "abc"); DPL_Value t13 = dpl_value_make_string(&vm.stack_pool, 3, "abc"); dplv_runtime_string_equals(&vm, t12, t13); }); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t11)})); }); DPL_Value t10 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t9, t10}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t8})); }));
+        dplv_release(&vm, ({ DPL_Value t14 = ({ DPL_Value t15 = ({ bool t17 = ({ DPL_Value t18 = dpl_value_make_string(&vm.stack_pool, 3, "abc"); DPL_Value t19 = dpl_value_make_string(&vm.stack_pool, 3, "abd"); dplv_runtime_string_equals(&vm, t18, t19); }); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t17)})); }); DPL_Value t16 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t15, t16}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t14})); }));
+        dplv_release(&vm, ({ DPL_Value t20 = ({ DPL_Value t21 = ({ bool t23 = ({ DPL_Value t24 = dpl_value_make_string(&vm.stack_pool, 3, "abc"); DPL_Value t25 = dpl_value_make_string(&vm.stack_pool, 3, "abd"); !dplv_runtime_string_equals(&vm, t24, t25); }); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t23)})); }); DPL_Value t22 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t21, t22}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t20})); }));
+        dplv_release(&vm, ({ DPL_Value t26 = ({ DPL_Value t27 = ({ bool t29 = ({ DPL_Value t30 = ({ DPL_Value t32 = dplv_reference(&vm, l0); DPL_Value t33 = dplv_reference(&vm, l1); dplv_runtime_concat_string(&vm, t32, t33); }); DPL_Value t31 = dpl_value_make_string(&vm.stack_pool, 12, "Hello, World"); dplv_runtime_string_equals(&vm, t30, t31); }); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t29)})); }); DPL_Value t28 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t27, t28}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t26})); }));
+        dplv_release(&vm, ({ DPL_Value t34 = ({ DPL_Value t35 = ({ bool t37 = ({ bool t38 = true; bool t39 = true; t38 == t39; }); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t37)})); }); DPL_Value t36 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t35, t36}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t34})); }));
+        dplv_release(&vm, ({ DPL_Value t40 = ({ DPL_Value t41 = ({ bool t43 = ({ bool t44 = true; bool t45 = false; t44 != t45; }); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t43)})); }); DPL_Value t42 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t41, t42}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t40})); }));
+        dplv_release(&vm, ({ DPL_Value t46 = ({ DPL_Value t47 = ({ bool t49 = ({ double t50 = 1.0; double t51 = 1.0; dpl_value_compare_numbers(t50, t51) == 0; }); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t49)})); }); DPL_Value t48 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t47, t48}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t46})); }));
+        DPL_Value t0 = ({ DPL_Value t52 = ({ DPL_Value t53 = ({ bool t55 = ({ double t56 = 1.0; double t57 = 1.0; dpl_value_compare_numbers(t56, t57) != 0; }); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t55)})); }); DPL_Value t54 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t53, t54}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t52})); });
+        dplv_release(&vm, l0);
+        dplv_release(&vm, l1);
+        t0;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+// Generated by dplc from ./tests/18-tail-calls.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+static double dpl_function_0(double l0, double l1);
+static double dpl_function_1(double l0);
+static double dpl_function_2(double l0);
+static double dpl_function_3(double l0, double l1);
+static DPL_Value dpl_function_4(double l0, DPL_Value l1);
+
+// sum
+static double dpl_function_0(double l0, double l1)
+{
+    double result;
+tail_call:
+    result = (({ double t0 = l0; double t1 = 0.0; dpl_value_compare_numbers(t0, t1) == 0; })
+        ? l1
+        : ({ double t2 = ({ double t4 = l0; double t5 = 1.0; t4 - t5; }); double t3 = ({ double t6 = l1; double t7 = l0; t6 + t7; }); l0 = t2; l1 = t3; goto tail_call; (double){0}; }));
+    return result;
+}
+
+// countdown
+static double dpl_function_1(double l0)
+{
+    double result;
+tail_call:
+    result = ({
+        double l1 = ({ double t9 = l0; double t10 = 1.0; t9 - t10; }); (void)l1;
+        double t8 = (({ double t11 = l1; double t12 = 0.0; dpl_value_compare_numbers(t11, t12) < 0; })
+            ? l0
+            : ({ double t13 = l1; l0 = t13; goto tail_call; (double){0}; }));
+        t8;
+    });
+    return result;
+}
+
+// factorial
+static double dpl_function_2(double l0)
+{
+    double result;
+    result = (({ double t14 = l0; double t15 = 2.0; dpl_value_compare_numbers(t14, t15) < 0; })
+        ? 1.0
+        : ({ double t16 = l0; double t17 = ({ double t18 = ({ double t19 = l0; double t20 = 1.0; t19 - t20; }); dpl_function_2(t18); }); t16 * t17; }));
+    return result;
+}
+
+// count
+static double dpl_function_3(double l0, double l1)
+{
+    double result;
+tail_call:
+    result = (({ double t21 = l0; double t22 = 0.0; dpl_value_compare_numbers(t21, t22) == 0; })
+        ? l1
+        : ({ double t23 = ({ double t25 = l0; double t26 = 1.0; t25 - t26; }); double t24 = ({ double t27 = l1; double t28 = 1.0; t27 + t28; }); l0 = t23; l1 = t24; goto tail_call; (double){0}; }));
+    return result;
+}
+
+// keep
+static DPL_Value dpl_function_4(double l0, DPL_Value l1)
+{
+    DPL_Value result;
+tail_call:
+    result = ({
+        DPL_Value l2 = dplv_runtime_move(&l1);
+        DPL_Value t29 = (({ double t30 = l0; double t31 = 0.0; dpl_value_compare_numbers(t30, t31) == 0; })
+            ? dplv_reference(&vm, l2)
+            : ({ double t32 = ({ double t34 = l0; double t35 = 1.0; t34 - t35; }); DPL_Value t33 = dplv_reference(&vm, l2); dplv_release(&vm, l1); dplv_release(&vm, l2); l0 = t32; l1 = t33; goto tail_call; (DPL_Value){0}; }));
+        dplv_release(&vm, l2);
+        t29;
+    });
+    dplv_release(&vm, l1);
+    return result;
+}
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        (void)(({ double t37 = ({ double t38 = 10000.0; double t39 = 0.0; dpl_function_0(t38, t39); }); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 2 /* print(Number): Number */, 1, (DPL_Value[]){dpl_value_make_number(t37)})); }));
+        dplv_release(&vm, ({ DPL_Value t40 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t40})); }));
+        (void)(({ double t41 = ({ double t42 = 5000.0; dpl_function_1(t42); }); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 2 /* print(Number): Number */, 1, (DPL_Value[]){dpl_value_make_number(t41)})); }));
+        dplv_release(&vm, ({ DPL_Value t43 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t43})); }));
+        (void)(({ double t44 = ({ double t45 = 10.0; dpl_function_2(t45); }); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 2 /* print(Number): Number */, 1, (DPL_Value[]){dpl_value_make_number(t44)})); }));
+        dplv_release(&vm, ({ DPL_Value t46 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t46})); }));
+        (void)(({ double t47 = ({ double t48 = 1000000.0; double t49 = 0.0; dpl_function_3(t48, t49); }); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 2 /* print(Number): Number */, 1, (DPL_Value[]){dpl_value_make_number(t47)})); }));
+        dplv_release(&vm, ({ DPL_Value t50 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t50})); }));
+        dplv_release(&vm, ({ DPL_Value t51 = ({ double t52 = 1000000.0; DPL_Value t53 = dpl_value_make_string(&vm.stack_pool, 4, "kept"); dpl_function_4(t52, t53); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t51})); }));
+        DPL_Value t36 = ({ DPL_Value t54 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t54})); });
+        t36;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+// Generated by dplc from ./tests/19-stack-growth.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+static double dpl_function_0(double l0);
+static double dpl_function_1(double l0);
+
+// depth
+static double dpl_function_0(double l0)
+{
+    double result;
+    result = (({ double t0 = l0; double t1 = 0.0; dpl_value_compare_numbers(t0, t1) == 0; })
+        ? 0.0
+        : ({ double t2 = 1.0; double t3 = ({ double t4 = ({ double t5 = l0; double t6 = 1.0; t5 - t6; }); dpl_function_0(t4); }); t2 + t3; }));
+    return result;
+}
+
+// countNested
+static double dpl_function_1(double l0)
+{
+    double result;
+    result = (({ double t7 = l0; double t8 = 0.0; dpl_value_compare_numbers(t7, t8) == 0; })
+        ? 0.0
+        : ({
+            double l1 = ({ double t10 = ({ double t11 = l0; double t12 = 1.0; t11 - t12; }); dpl_function_1(t10); }); (void)l1;
+            double t9 = ({ double t13 = l1; double t14 = 1.0; t13 + t14; });
+            t9;
+        }));
+    return result;
+}
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        (void)(({ double t16 = ({ double t17 = 5000.0; dpl_function_0(t17); }); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 2 /* print(Number): Number */, 1, (DPL_Value[]){dpl_value_make_number(t16)})); }));
+        dplv_release(&vm, ({ DPL_Value t18 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t18})); }));
+        (void)(({ double t19 = ({ double t20 = 3000.0; dpl_function_1(t20); }); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 2 /* print(Number): Number */, 1, (DPL_Value[]){dpl_value_make_number(t19)})); }));
+        DPL_Value t15 = ({ DPL_Value t21 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t21})); });
+        t15;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
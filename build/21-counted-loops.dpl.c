@@ -0,0 +1,246 @@
+// Generated by dplc from ./tests/21-counted-loops.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+static double dpl_function_0(double l0);
+
+// sum
+static double dpl_function_0(double l0)
+{
+    double result;
+    result = ({
+        double l1 = 0.0; (void)l1;
+        dplv_release(&vm, ({
+            double l2 = 1.0; (void)l2;
+            double l3 = l0; (void)l3;
+            DPL_Value t1 = ({
+                DPL_Value t2 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l2 > l3))
+                {
+                    (void)(({
+                        double l5 = l2; (void)l5;
+                        double l6 = (l1 = ({ double t4 = l1; double t5 = l5; t4 + t5; })); (void)l6;
+                        (void)((l2 = ({ double t6 = l2; double t7 = 1.0; t6 + t7; })));
+                        double t3 = l6;
+                        t3;
+                    }));
+                }
+                t2;
+            });
+            t1;
+        }));
+        double t0 = l1;
+        t0;
+    });
+    return result;
+}
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        double l0 = 2.0; (void)l0;
+        double l1 = 5.0; (void)l1;
+        dplv_release(&vm, ({
+            double l2 = l0; (void)l2;
+            double l3 = l1; (void)l3;
+            DPL_Value t9 = ({
+                DPL_Value t10 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l2 > l3))
+                {
+                    dplv_release(&vm, ({
+                        double l5 = l2; (void)l5;
+                        DPL_Value l6 = ({ DPL_Value t12 = ({ DPL_Value t13 = ({ double t15 = l5; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t15)})); }); DPL_Value t14 = dpl_value_make_string(&vm.stack_pool, 1, " "); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t13, t14}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t12})); });
+                        (void)((l2 = ({ double t16 = l2; double t17 = 1.0; t16 + t17; })));
+                        DPL_Value t11 = dplv_reference(&vm, l6);
+                        dplv_release(&vm, l6);
+                        t11;
+                    }));
+                }
+                t10;
+            });
+            t9;
+        }));
+        dplv_release(&vm, ({ DPL_Value t18 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t18})); }));
+        dplv_release(&vm, ({
+            double l2 = 3.0; (void)l2;
+            double l3 = 1.0; (void)l3;
+            DPL_Value t19 = ({
+                DPL_Value t20 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l2 > l3))
+                {
+                    dplv_release(&vm, ({
+                        double l5 = l2; (void)l5;
+                        DPL_Value l6 = ({ DPL_Value t22 = dpl_value_make_string(&vm.stack_pool, 5, "never"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t22})); });
+                        (void)((l2 = ({ double t23 = l2; double t24 = 1.0; t23 + t24; })));
+                        DPL_Value t21 = dplv_reference(&vm, l6);
+                        dplv_release(&vm, l6);
+                        t21;
+                    }));
+                }
+                t20;
+            });
+            t19;
+        }));
+        DPL_Value l2 = ({
+            double l2 = 1.0; (void)l2;
+            double l3 = ({
+                double l3 = 4.0; (void)l3;
+                double t26 = l3;
+                t26;
+            }); (void)l3;
+            DPL_Value t25 = ({
+                DPL_Value t27 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l2 > l3))
+                {
+                    t27 = dplv_runtime_concat_array(&vm, t27, dpl_value_make_number(({
+                        double l5 = l2; (void)l5;
+                        double l6 = ({ double t29 = l5; double t30 = l5; t29 * t30; }); (void)l6;
+                        (void)((l2 = ({ double t31 = l2; double t32 = 1.0; t31 + t32; })));
+                        double t28 = l6;
+                        t28;
+                    })));
+                }
+                t27;
+            });
+            t25;
+        });
+        dplv_release(&vm, ({
+            DPL_Value l3 = dplv_reference(&vm, l2);
+            double l4 = 0.0; (void)l4;
+            DPL_Value t33 = ({
+                DPL_Value t34 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while ((l4 < dpl_value_array_element_count(dpl_value_as_array(l3))))
+                {
+                    dplv_release(&vm, ({
+                        double l6 = ({ DPL_Value t36 = dplv_reference(&vm, l3); double t37 = l4; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t36, dpl_value_make_number(t37)})); }); (void)l6;
+                        DPL_Value l7 = ({ DPL_Value t38 = ({ DPL_Value t39 = ({ double t41 = l6; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t41)})); }); DPL_Value t40 = dpl_value_make_string(&vm.stack_pool, 1, " "); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t39, t40}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t38})); });
+                        (void)((l4 = ({ double t42 = l4; double t43 = 1.0; t42 + t43; })));
+                        DPL_Value t35 = dplv_reference(&vm, l7);
+                        dplv_release(&vm, l7);
+                        t35;
+                    }));
+                }
+                t34;
+            });
+            dplv_release(&vm, l3);
+            t33;
+        }));
+        dplv_release(&vm, ({ DPL_Value t44 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t44})); }));
+        DPL_Value l3 = ({ DPL_Runtime_Array t45 = {0}; dplv_runtime_array_append(&t45, dpl_value_make_string(&vm.stack_pool, 1, "a")); dplv_runtime_array_append(&t45, dpl_value_make_string(&vm.stack_pool, 2, "bb")); dplv_runtime_array_append(&t45, dpl_value_make_string(&vm.stack_pool, 3, "ccc")); dplv_runtime_array_end(&vm, &t45); });
+        DPL_Value l4 = ({
+            DPL_Value l4 = dplv_reference(&vm, l3);
+            double l5 = 0.0; (void)l5;
+            DPL_Value t46 = ({
+                DPL_Value t47 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while ((l5 < dpl_value_array_element_count(dpl_value_as_array(l4))))
+                {
+                    t47 = dplv_runtime_concat_array(&vm, t47, dpl_value_make_number(({
+                        DPL_Value l7 = ({ DPL_Value t49 = dplv_reference(&vm, l4); double t50 = l5; (dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t49, dpl_value_make_number(t50)})); });
+                        double l8 = ({ DPL_Value t51 = dplv_reference(&vm, l7); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 6 /* length(String): Number */, 1, (DPL_Value[]){t51})); }); (void)l8;
+                        (void)((l5 = ({ double t52 = l5; double t53 = 1.0; t52 + t53; })));
+                        double t48 = l8;
+                        dplv_release(&vm, l7);
+                        t48;
+                    })));
+                }
+                t47;
+            });
+            dplv_release(&vm, l4);
+            t46;
+        });
+        dplv_release(&vm, ({
+            DPL_Value l5 = dplv_reference(&vm, l4);
+            double l6 = 0.0; (void)l6;
+            DPL_Value t54 = ({
+                DPL_Value t55 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while ((l6 < dpl_value_array_element_count(dpl_value_as_array(l5))))
+                {
+                    dplv_release(&vm, ({
+                        double l8 = ({ DPL_Value t57 = dplv_reference(&vm, l5); double t58 = l6; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t57, dpl_value_make_number(t58)})); }); (void)l8;
+                        DPL_Value l9 = ({ DPL_Value t59 = ({ DPL_Value t60 = ({ double t62 = l8; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t62)})); }); DPL_Value t61 = dpl_value_make_string(&vm.stack_pool, 1, " "); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t60, t61}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t59})); });
+                        (void)((l6 = ({ double t63 = l6; double t64 = 1.0; t63 + t64; })));
+                        DPL_Value t56 = dplv_reference(&vm, l9);
+                        dplv_release(&vm, l9);
+                        t56;
+                    }));
+                }
+                t55;
+            });
+            dplv_release(&vm, l5);
+            t54;
+        }));
+        dplv_release(&vm, ({ DPL_Value t65 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t65})); }));
+        dplv_release(&vm, ({ DPL_Value t66 = ({ DPL_Value t67 = ({ double t69 = ({ double t70 = 100.0; dpl_function_0(t70); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t69)})); }); DPL_Value t68 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t67, t68}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t66})); }));
+        dplv_release(&vm, ({
+            double l5 = 0.0; (void)l5;
+            double l6 = 2.0; (void)l6;
+            DPL_Value t71 = ({
+                DPL_Value t72 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l5 > l6))
+                {
+                    dplv_release(&vm, ({
+                        double l8 = l5; (void)l8;
+                        DPL_Value l9 = ({
+                            DPL_Value l9 = ({ DPL_Runtime_Array t75 = {0}; dplv_runtime_array_append(&t75, dpl_value_make_number(10.0)); dplv_runtime_array_append(&t75, dpl_value_make_number(20.0)); dplv_runtime_array_end(&vm, &t75); });
+                            double l10 = 0.0; (void)l10;
+                            DPL_Value t74 = ({
+                                DPL_Value t76 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                                while ((l10 < dpl_value_array_element_count(dpl_value_as_array(l9))))
+                                {
+                                    dplv_release(&vm, ({
+                                        double l12 = ({ DPL_Value t78 = dplv_reference(&vm, l9); double t79 = l10; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t78, dpl_value_make_number(t79)})); }); (void)l12;
+                                        DPL_Value l13 = ({ DPL_Value t80 = ({ DPL_Value t81 = ({ double t83 = ({ double t84 = l8; double t85 = l12; t84 + t85; }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t83)})); }); DPL_Value t82 = dpl_value_make_string(&vm.stack_pool, 1, " "); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t81, t82}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t80})); });
+                                        (void)((l10 = ({ double t86 = l10; double t87 = 1.0; t86 + t87; })));
+                                        DPL_Value t77 = dplv_reference(&vm, l13);
+                                        dplv_release(&vm, l13);
+                                        t77;
+                                    }));
+                                }
+                                t76;
+                            });
+                            dplv_release(&vm, l9);
+                            t74;
+                        });
+                        (void)((l5 = ({ double t88 = l5; double t89 = 1.0; t88 + t89; })));
+                        DPL_Value t73 = dplv_reference(&vm, l9);
+                        dplv_release(&vm, l9);
+                        t73;
+                    }));
+                }
+                t72;
+            });
+            t71;
+        }));
+        DPL_Value t8 = ({ DPL_Value t90 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t90})); });
+        dplv_release(&vm, l2);
+        dplv_release(&vm, l3);
+        dplv_release(&vm, l4);
+        t8;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+// Generated by dplc from ./tests/23-large-arrays.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        DPL_Value l0 = ({
+            double l0 = 0.0; (void)l0;
+            double l1 = 999.0; (void)l1;
+            DPL_Value t1 = ({
+                DPL_Value t2 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l0 > l1))
+                {
+                    t2 = dplv_runtime_concat_array(&vm, t2, dpl_value_make_number(({
+                        double l3 = l0; (void)l3;
+                        double l4 = l3; (void)l4;
+                        (void)((l0 = ({ double t4 = l0; double t5 = 1.0; t4 + t5; })));
+                        double t3 = l4;
+                        t3;
+                    })));
+                }
+                t2;
+            });
+            t1;
+        });
+        dplv_release(&vm, ({ DPL_Value t6 = ({ DPL_Value t7 = ({ double t9 = ({ DPL_Value t10 = dplv_reference(&vm, l0); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 8 /* <T>length([T]): Number */, 1, (DPL_Value[]){t10})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t9)})); }); DPL_Value t8 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t7, t8}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t6})); }));
+        dplv_release(&vm, ({ DPL_Value t11 = ({ DPL_Value t12 = ({ double t18 = ({ DPL_Value t19 = dplv_reference(&vm, l0); double t20 = 255.0; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t19, dpl_value_make_number(t20)})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t18)})); }); DPL_Value t13 = dpl_value_make_string(&vm.stack_pool, 2, ", "); DPL_Value t14 = ({ double t21 = ({ DPL_Value t22 = dplv_reference(&vm, l0); double t23 = 256.0; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t22, dpl_value_make_number(t23)})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t21)})); }); DPL_Value t15 = dpl_value_make_string(&vm.stack_pool, 2, ", "); DPL_Value t16 = ({ double t24 = ({ DPL_Value t25 = dplv_reference(&vm, l0); double t26 = 999.0; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t25, dpl_value_make_number(t26)})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t24)})); }); DPL_Value t17 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 6, (DPL_Value[]){t12, t13, t14, t15, t16, t17}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t11})); }));
+        double l1 = 0.0; (void)l1;
+        dplv_release(&vm, ({
+            DPL_Value l2 = dplv_reference(&vm, l0);
+            double l3 = 0.0; (void)l3;
+            DPL_Value t27 = ({
+                DPL_Value t28 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while ((l3 < dpl_value_array_element_count(dpl_value_as_array(l2))))
+                {
+                    (void)(({
+                        double l5 = ({ DPL_Value t30 = dplv_reference(&vm, l2); double t31 = l3; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t30, dpl_value_make_number(t31)})); }); (void)l5;
+                        double l6 = (l1 = ({ double t32 = l1; double t33 = l5; t32 + t33; })); (void)l6;
+                        (void)((l3 = ({ double t34 = l3; double t35 = 1.0; t34 + t35; })));
+                        double t29 = l6;
+                        t29;
+                    }));
+                }
+                t28;
+            });
+            dplv_release(&vm, l2);
+            t27;
+        }));
+        dplv_release(&vm, ({ DPL_Value t36 = ({ DPL_Value t37 = ({ double t39 = l1; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t39)})); }); DPL_Value t38 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t37, t38}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t36})); }));
+        DPL_Value l2 = ({ DPL_Runtime_Array t40 = {0}; dplv_runtime_array_append(&t40, dpl_value_make_number(1000.0)); dplv_runtime_array_spread(&vm, &t40, dplv_reference(&vm, l0)); dplv_runtime_array_spread(&vm, &t40, dplv_reference(&vm, l0)); dplv_runtime_array_end(&vm, &t40); });
+        dplv_release(&vm, ({ DPL_Value t41 = ({ DPL_Value t42 = ({ double t44 = ({ DPL_Value t45 = dplv_reference(&vm, l2); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 8 /* <T>length([T]): Number */, 1, (DPL_Value[]){t45})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t44)})); }); DPL_Value t43 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t42, t43}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t41})); }));
+        dplv_release(&vm, ({ DPL_Value t46 = ({ DPL_Value t47 = ({ double t53 = ({ DPL_Value t54 = dplv_reference(&vm, l2); double t55 = 0.0; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t54, dpl_value_make_number(t55)})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t53)})); }); DPL_Value t48 = dpl_value_make_string(&vm.stack_pool, 2, ", "); DPL_Value t49 = ({ double t56 = ({ DPL_Value t57 = dplv_reference(&vm, l2); double t58 = 1000.0; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t57, dpl_value_make_number(t58)})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t56)})); }); DPL_Value t50 = dpl_value_make_string(&vm.stack_pool, 2, ", "); DPL_Value t51 = ({ double t59 = ({ DPL_Value t60 = dplv_reference(&vm, l2); double t61 = 2000.0; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t60, dpl_value_make_number(t61)})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t59)})); }); DPL_Value t52 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 6, (DPL_Value[]){t47, t48, t49, t50, t51, t52}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t46})); }));
+        DPL_Value l3 = ({
+            double l3 = 0.0; (void)l3;
+            double l4 = 299.0; (void)l4;
+            DPL_Value t62 = ({
+                DPL_Value t63 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l3 > l4))
+                {
+                    t63 = dplv_runtime_concat_array(&vm, t63, ({
+                        double l6 = l3; (void)l6;
+                        DPL_Value l7 = ({ DPL_Value t65 = dpl_value_make_string(&vm.stack_pool, 1, "w"); DPL_Value t66 = ({ double t67 = l6; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t67)})); }); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t65, t66}); });
+                        (void)((l3 = ({ double t68 = l3; double t69 = 1.0; t68 + t69; })));
+                        DPL_Value t64 = dplv_reference(&vm, l7);
+                        dplv_release(&vm, l7);
+                        t64;
+                    }));
+                }
+                t63;
+            });
+            t62;
+        });
+        DPL_Value t0 = ({ DPL_Value t70 = ({ DPL_Value t71 = ({ double t79 = ({ DPL_Value t80 = dplv_reference(&vm, l3); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 8 /* <T>length([T]): Number */, 1, (DPL_Value[]){t80})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t79)})); }); DPL_Value t72 = dpl_value_make_string(&vm.stack_pool, 2, ": "); DPL_Value t73 = ({ DPL_Value t81 = dplv_reference(&vm, l3); double t82 = 0.0; (dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t81, dpl_value_make_number(t82)})); }); DPL_Value t74 = dpl_value_make_string(&vm.stack_pool, 2, ", "); DPL_Value t75 = ({ DPL_Value t83 = dplv_reference(&vm, l3); double t84 = 256.0; (dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t83, dpl_value_make_number(t84)})); }); DPL_Value t76 = dpl_value_make_string(&vm.stack_pool, 2, ", "); DPL_Value t77 = ({ DPL_Value t85 = dplv_reference(&vm, l3); double t86 = 299.0; (dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t85, dpl_value_make_number(t86)})); }); DPL_Value t78 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 8, (DPL_Value[]){t71, t72, t73, t74, t75, t76, t77, t78}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t70})); });
+        dplv_release(&vm, l0);
+        dplv_release(&vm, l2);
+        dplv_release(&vm, l3);
+        t0;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+// Generated by dplc from ./tests/25-string-building.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        DPL_Value l0 = dpl_value_make_string(&vm.stack_pool, 0, "");
+        dplv_release(&vm, ({
+            double l1 = 1.0; (void)l1;
+            double l2 = 1000.0; (void)l2;
+            DPL_Value t1 = ({
+                DPL_Value t2 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l1 > l2))
+                {
+                    dplv_release(&vm, ({
+                        double l4 = l1; (void)l4;
+                        DPL_Value l5 = ({ DPL_Value t4 = ({ DPL_Value t5 = dplv_runtime_move(&l0); DPL_Value t6 = dpl_value_make_string(&vm.stack_pool, 2, "ab"); dplv_runtime_concat_string(&vm, t5, t6); }); dplv_release(&vm, l0); l0 = dplv_reference(&vm, t4); t4; });
+                        (void)((l1 = ({ double t7 = l1; double t8 = 1.0; t7 + t8; })));
+                        DPL_Value t3 = dplv_reference(&vm, l5);
+                        dplv_release(&vm, l5);
+                        t3;
+                    }));
+                }
+                t2;
+            });
+            t1;
+        }));
+        dplv_release(&vm, ({ DPL_Value t9 = ({ DPL_Value t10 = ({ double t12 = ({ DPL_Value t13 = dplv_reference(&vm, l0); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 6 /* length(String): Number */, 1, (DPL_Value[]){t13})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t12)})); }); DPL_Value t11 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t10, t11}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t9})); }));
+        DPL_Value l1 = dpl_value_make_string(&vm.stack_pool, 1, "x");
+        DPL_Value l2 = dplv_reference(&vm, l1);
+        dplv_release(&vm, ({ DPL_Value t14 = ({ DPL_Value t15 = dplv_runtime_move(&l1); DPL_Value t16 = dpl_value_make_string(&vm.stack_pool, 1, "y"); dplv_runtime_concat_string(&vm, t15, t16); }); dplv_release(&vm, l1); l1 = dplv_reference(&vm, t14); t14; }));
+        dplv_release(&vm, ({ DPL_Value t17 = ({ DPL_Value t18 = dplv_reference(&vm, l1); DPL_Value t19 = dplv_reference(&vm, l1); dplv_runtime_concat_string(&vm, t18, t19); }); dplv_release(&vm, l1); l1 = dplv_reference(&vm, t17); t17; }));
+        dplv_release(&vm, ({ DPL_Value t20 = ({ DPL_Value t21 = dplv_reference(&vm, l1); DPL_Value t22 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t23 = dplv_reference(&vm, l2); DPL_Value t24 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 4, (DPL_Value[]){t21, t22, t23, t24}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t20})); }));
+        DPL_Value l3 = ({ DPL_Value t25 = ({ DPL_Value t27 = ({ DPL_Value t29 = ({ DPL_Value t31 = dpl_value_make_string(&vm.stack_pool, 1, "a"); DPL_Value t32 = dplv_reference(&vm, l2); dplv_runtime_concat_string(&vm, t31, t32); }); DPL_Value t30 = dpl_value_make_string(&vm.stack_pool, 1, "b"); dplv_runtime_concat_string(&vm, t29, t30); }); DPL_Value t28 = dplv_reference(&vm, l1); dplv_runtime_concat_string(&vm, t27, t28); }); DPL_Value t26 = dpl_value_make_string(&vm.stack_pool, 1, "c"); dplv_runtime_concat_string(&vm, t25, t26); });
+        dplv_release(&vm, ({ DPL_Value t33 = ({ DPL_Value t34 = dplv_reference(&vm, l3); DPL_Value t35 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t34, t35}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t33})); }));
+        DPL_Value l4 = dpl_value_make_string(&vm.stack_pool, 0, "");
+        dplv_release(&vm, ({
+            double l5 = 1.0; (void)l5;
+            double l6 = 5.0; (void)l6;
+            DPL_Value t36 = ({
+                DPL_Value t37 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l5 > l6))
+                {
+                    dplv_release(&vm, ({
+                        double l8 = l5; (void)l8;
+                        DPL_Value l9 = ({ DPL_Value t39 = ({ DPL_Value t40 = dplv_runtime_move(&l4); DPL_Value t41 = ({ DPL_Value t42 = ({ double t44 = l8; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t44)})); }); DPL_Value t43 = dpl_value_make_string(&vm.stack_pool, 1, ","); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t42, t43}); }); dplv_runtime_concat_string(&vm, t40, t41); }); dplv_release(&vm, l4); l4 = dplv_reference(&vm, t39); t39; });
+                        (void)((l5 = ({ double t45 = l5; double t46 = 1.0; t45 + t46; })));
+                        DPL_Value t38 = dplv_reference(&vm, l9);
+                        dplv_release(&vm, l9);
+                        t38;
+                    }));
+                }
+                t37;
+            });
+            t36;
+        }));
+        DPL_Value t0 = ({ DPL_Value t47 = ({ DPL_Value t48 = dplv_reference(&vm, l4); DPL_Value t49 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t48, t49}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t47})); });
+        dplv_release(&vm, l0);
+        dplv_release(&vm, l1);
+        dplv_release(&vm, l2);
+        dplv_release(&vm, l3);
+        dplv_release(&vm, l4);
+        t0;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
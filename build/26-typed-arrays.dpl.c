@@ -0,0 +1,133 @@
+// Generated by dplc from ./tests/26-typed-arrays.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        DPL_Value l0 = ({ DPL_Runtime_Array t1 = {0}; dplv_runtime_array_append(&t1, dpl_value_make_boolean(true)); dplv_runtime_array_append(&t1, dpl_value_make_boolean(false)); dplv_runtime_array_append(&t1, dpl_value_make_boolean(true)); dplv_runtime_array_end(&vm, &t1); });
+        DPL_Value l1 = ({ DPL_Runtime_Array t2 = {0}; dplv_runtime_array_append(&t2, dpl_value_make_boolean(false)); dplv_runtime_array_spread(&vm, &t2, dplv_reference(&vm, l0)); dplv_runtime_array_spread(&vm, &t2, dplv_reference(&vm, l0)); dplv_runtime_array_end(&vm, &t2); });
+        dplv_release(&vm, ({
+            DPL_Value l2 = dplv_reference(&vm, l1);
+            double l3 = 0.0; (void)l3;
+            DPL_Value t3 = ({
+                DPL_Value t4 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while ((l3 < dpl_value_array_element_count(dpl_value_as_array(l2))))
+                {
+                    dplv_release(&vm, ({
+                        bool l5 = ({ DPL_Value t6 = dplv_reference(&vm, l2); double t7 = l3; dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t6, dpl_value_make_number(t7)})); }); (void)l5;
+                        DPL_Value l6 = ({ DPL_Value t8 = ({ DPL_Value t9 = ({ bool t11 = l5; (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t11)})); }); DPL_Value t10 = dpl_value_make_string(&vm.stack_pool, 1, " "); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t9, t10}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t8})); });
+                        (void)((l3 = ({ double t12 = l3; double t13 = 1.0; t12 + t13; })));
+                        DPL_Value t5 = dplv_reference(&vm, l6);
+                        dplv_release(&vm, l6);
+                        t5;
+                    }));
+                }
+                t4;
+            });
+            dplv_release(&vm, l2);
+            t3;
+        }));
+        dplv_release(&vm, ({ DPL_Value t14 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t14})); }));
+        DPL_Value l2 = ({
+            double l2 = 1.0; (void)l2;
+            double l3 = 300.0; (void)l3;
+            DPL_Value t15 = ({
+                DPL_Value t16 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l2 > l3))
+                {
+                    t16 = dplv_runtime_concat_array(&vm, t16, dpl_value_make_boolean(({
+                        double l5 = l2; (void)l5;
+                        bool l6 = ({ double t18 = l5; double t19 = 100.0; dpl_value_compare_numbers(t18, t19) > 0; }); (void)l6;
+                        (void)((l2 = ({ double t20 = l2; double t21 = 1.0; t20 + t21; })));
+                        bool t17 = l6;
+                        t17;
+                    })));
+                }
+                t16;
+            });
+            t15;
+        });
+        double l3 = 0.0; (void)l3;
+        dplv_release(&vm, ({
+            DPL_Value l4 = dplv_reference(&vm, l2);
+            double l5 = 0.0; (void)l5;
+            DPL_Value t22 = ({
+                DPL_Value t23 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while ((l5 < dpl_value_array_element_count(dpl_value_as_array(l4))))
+                {
+                    (void)(({
+                        bool l7 = ({ DPL_Value t25 = dplv_reference(&vm, l4); double t26 = l5; dpl_value_as_boolean(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t25, dpl_value_make_number(t26)})); }); (void)l7;
+                        double l8 = (l7
+                            ? (l3 = ({ double t27 = l3; double t28 = 1.0; t27 + t28; }))
+                            : l3); (void)l8;
+                        (void)((l5 = ({ double t29 = l5; double t30 = 1.0; t29 + t30; })));
+                        double t24 = l8;
+                        t24;
+                    }));
+                }
+                t23;
+            });
+            dplv_release(&vm, l4);
+            t22;
+        }));
+        dplv_release(&vm, ({ DPL_Value t31 = ({ DPL_Value t32 = ({ double t36 = ({ DPL_Value t37 = dplv_reference(&vm, l2); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 8 /* <T>length([T]): Number */, 1, (DPL_Value[]){t37})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t36)})); }); DPL_Value t33 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t34 = ({ double t38 = l3; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t38)})); }); DPL_Value t35 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 4, (DPL_Value[]){t32, t33, t34, t35}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t31})); }));
+        DPL_Value l4 = ({
+            double l4 = 1.0; (void)l4;
+            double l5 = 0.0; (void)l5;
+            DPL_Value t39 = ({
+                DPL_Value t40 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l4 > l5))
+                {
+                    t40 = dplv_runtime_concat_array(&vm, t40, dpl_value_make_number(({
+                        double l7 = l4; (void)l7;
+                        double l8 = ({ double t42 = l7; double t43 = 1.5; t42 * t43; }); (void)l8;
+                        (void)((l4 = ({ double t44 = l4; double t45 = 1.0; t44 + t45; })));
+                        double t41 = l8;
+                        t41;
+                    })));
+                }
+                t40;
+            });
+            t39;
+        });
+        DPL_Value l5 = ({ DPL_Runtime_Array t46 = {0}; dplv_runtime_array_append(&t46, dpl_value_make_number(1.5)); dplv_runtime_array_spread(&vm, &t46, dplv_reference(&vm, l4)); dplv_runtime_array_append(&t46, dpl_value_make_number(2.5)); dplv_runtime_array_end(&vm, &t46); });
+        dplv_release(&vm, ({ DPL_Value t47 = ({ DPL_Value t48 = ({ double t50 = ({ double t51 = ({ DPL_Value t53 = dplv_reference(&vm, l5); double t54 = 0.0; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t53, dpl_value_make_number(t54)})); }); double t52 = ({ DPL_Value t55 = dplv_reference(&vm, l5); double t56 = 1.0; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t55, dpl_value_make_number(t56)})); }); t51 + t52; }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t50)})); }); DPL_Value t49 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t48, t49}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t47})); }));
+        DPL_Value l6 = ({ DPL_Runtime_Array t57 = {0}; dplv_runtime_array_append(&t57, dpl_value_make_string(&vm.stack_pool, 1, "a")); dplv_runtime_array_append(&t57, dpl_value_make_string(&vm.stack_pool, 1, "b")); dplv_runtime_array_end(&vm, &t57); });
+        DPL_Value t0 = ({ DPL_Value t58 = ({ DPL_Value t59 = ({ DPL_Value t62 = dplv_reference(&vm, l6); double t63 = 1.0; (dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t62, dpl_value_make_number(t63)})); }); DPL_Value t60 = ({ DPL_Value t64 = dplv_reference(&vm, l6); double t65 = 0.0; (dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t64, dpl_value_make_number(t65)})); }); DPL_Value t61 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 3, (DPL_Value[]){t59, t60, t61}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t58})); });
+        dplv_release(&vm, l0);
+        dplv_release(&vm, l1);
+        dplv_release(&vm, l2);
+        dplv_release(&vm, l4);
+        dplv_release(&vm, l5);
+        dplv_release(&vm, l6);
+        t0;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
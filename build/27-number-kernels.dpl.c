@@ -0,0 +1,150 @@
+// Generated by dplc from ./tests/27-number-kernels.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+static bool dpl_function_0(double l0);
+
+// isNaN
+static bool dpl_function_0(double l0)
+{
+    bool result;
+    result = ({ double t0 = l0; double t1 = l0; dpl_value_compare_numbers(t0, t1) != 0; });
+    return result;
+}
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        DPL_Value l0 = ({ DPL_Runtime_Array t3 = {0}; dplv_runtime_array_append(&t3, dpl_value_make_number(1.0)); dplv_runtime_array_append(&t3, dpl_value_make_number(2.0)); dplv_runtime_array_append(&t3, dpl_value_make_number(3.0)); dplv_runtime_array_append(&t3, dpl_value_make_number(4.0)); dplv_runtime_array_append(&t3, dpl_value_make_number(5.0)); dplv_runtime_array_append(&t3, dpl_value_make_number(6.0)); dplv_runtime_array_append(&t3, dpl_value_make_number(7.0)); dplv_runtime_array_append(&t3, dpl_value_make_number(8.0)); dplv_runtime_array_append(&t3, dpl_value_make_number(9.0)); dplv_runtime_array_append(&t3, dpl_value_make_number(10.0)); dplv_runtime_array_append(&t3, dpl_value_make_number(11.0)); dplv_runtime_array_end(&vm, &t3); });
+        DPL_Value l1 = ({
+            double l1 = 1.0; (void)l1;
+            double l2 = 11.0; (void)l2;
+            DPL_Value t4 = ({
+                DPL_Value t5 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l1 > l2))
+                {
+                    t5 = dplv_runtime_concat_array(&vm, t5, dpl_value_make_number(({
+                        double l4 = l1; (void)l4;
+                        double l5 = ({ double t7 = 12.0; double t8 = l4; t7 - t8; }); (void)l5;
+                        (void)((l1 = ({ double t9 = l1; double t10 = 1.0; t9 + t10; })));
+                        double t6 = l5;
+                        t6;
+                    })));
+                }
+                t5;
+            });
+            t4;
+        });
+        dplv_release(&vm, ({ DPL_Value t11 = ({ DPL_Value t12 = ({ double t18 = ({ DPL_Value t19 = dplv_reference(&vm, l0); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 12 /* sum([Number]): Number */, 1, (DPL_Value[]){t19})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t18)})); }); DPL_Value t13 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t14 = ({ double t20 = ({ DPL_Value t21 = dplv_reference(&vm, l0); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 13 /* min([Number]): Number */, 1, (DPL_Value[]){t21})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t20)})); }); DPL_Value t15 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t16 = ({ double t22 = ({ DPL_Value t23 = dplv_reference(&vm, l0); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 14 /* max([Number]): Number */, 1, (DPL_Value[]){t23})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t22)})); }); DPL_Value t17 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 6, (DPL_Value[]){t12, t13, t14, t15, t16, t17}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t11})); }));
+        dplv_release(&vm, ({ DPL_Value t24 = ({ DPL_Value t25 = ({ double t31 = ({ DPL_Value t32 = dplv_reference(&vm, l1); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 13 /* min([Number]): Number */, 1, (DPL_Value[]){t32})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t31)})); }); DPL_Value t26 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t27 = ({ double t33 = ({ DPL_Value t34 = dplv_reference(&vm, l1); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 14 /* max([Number]): Number */, 1, (DPL_Value[]){t34})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t33)})); }); DPL_Value t28 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t29 = ({ double t35 = ({ DPL_Value t36 = dplv_reference(&vm, l0); DPL_Value t37 = dplv_reference(&vm, l1); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 15 /* dot([Number], [Number]): Number */, 2, (DPL_Value[]){t36, t37})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t35)})); }); DPL_Value t30 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 6, (DPL_Value[]){t25, t26, t27, t28, t29, t30}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t24})); }));
+        DPL_Value l2 = ({ DPL_Value t38 = dplv_reference(&vm, l0); DPL_Value t39 = dplv_reference(&vm, l1); (dplv_runtime_call_intrinsic(&vm, 17 /* add([Number], [Number]): [Number] */, 2, (DPL_Value[]){t38, t39})); });
+        DPL_Value l3 = ({ DPL_Value t40 = dplv_reference(&vm, l0); DPL_Value t41 = dplv_reference(&vm, l1); (dplv_runtime_call_intrinsic(&vm, 18 /* multiply([Number], [Number]): [Number] */, 2, (DPL_Value[]){t40, t41})); });
+        DPL_Value l4 = ({ DPL_Value t42 = dplv_reference(&vm, l0); double t43 = 0.5; (dplv_runtime_call_intrinsic(&vm, 16 /* scale([Number], Number): [Number] */, 2, (DPL_Value[]){t42, dpl_value_make_number(t43)})); });
+        dplv_release(&vm, ({ DPL_Value t44 = ({ DPL_Value t45 = ({ double t53 = ({ DPL_Value t54 = dplv_reference(&vm, l2); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 12 /* sum([Number]): Number */, 1, (DPL_Value[]){t54})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t53)})); }); DPL_Value t46 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t47 = ({ double t55 = ({ DPL_Value t56 = dplv_reference(&vm, l2); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 13 /* min([Number]): Number */, 1, (DPL_Value[]){t56})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t55)})); }); DPL_Value t48 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t49 = ({ double t57 = ({ DPL_Value t58 = dplv_reference(&vm, l3); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 12 /* sum([Number]): Number */, 1, (DPL_Value[]){t58})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t57)})); }); DPL_Value t50 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t51 = ({ double t59 = ({ DPL_Value t60 = dplv_reference(&vm, l4); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 12 /* sum([Number]): Number */, 1, (DPL_Value[]){t60})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t59)})); }); DPL_Value t52 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 8, (DPL_Value[]){t45, t46, t47, t48, t49, t50, t51, t52}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t44})); }));
+        dplv_release(&vm, ({ DPL_Value t61 = ({ DPL_Value t62 = ({ double t68 = ({ DPL_Value t69 = dplv_reference(&vm, l3); double t70 = 0.0; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t69, dpl_value_make_number(t70)})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t68)})); }); DPL_Value t63 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t64 = ({ double t71 = ({ DPL_Value t72 = dplv_reference(&vm, l3); double t73 = 5.0; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t72, dpl_value_make_number(t73)})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t71)})); }); DPL_Value t65 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t66 = ({ double t74 = ({ DPL_Value t75 = dplv_reference(&vm, l4); double t76 = 10.0; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t75, dpl_value_make_number(t76)})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t74)})); }); DPL_Value t67 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 6, (DPL_Value[]){t62, t63, t64, t65, t66, t67}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t61})); }));
+        DPL_Value l5 = ({
+            double l5 = 1.0; (void)l5;
+            double l6 = 10001.0; (void)l6;
+            DPL_Value t77 = ({
+                DPL_Value t78 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l5 > l6))
+                {
+                    t78 = dplv_runtime_concat_array(&vm, t78, dpl_value_make_number(({
+                        double l8 = l5; (void)l8;
+                        double l9 = l8; (void)l9;
+                        (void)((l5 = ({ double t80 = l5; double t81 = 1.0; t80 + t81; })));
+                        double t79 = l9;
+                        t79;
+                    })));
+                }
+                t78;
+            });
+            t77;
+        });
+        dplv_release(&vm, ({ DPL_Value t82 = ({ DPL_Value t83 = ({ double t89 = ({ DPL_Value t90 = dplv_reference(&vm, l5); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 12 /* sum([Number]): Number */, 1, (DPL_Value[]){t90})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t89)})); }); DPL_Value t84 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t85 = ({ double t91 = ({ DPL_Value t92 = dplv_reference(&vm, l5); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 14 /* max([Number]): Number */, 1, (DPL_Value[]){t92})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t91)})); }); DPL_Value t86 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t87 = ({ double t93 = ({ DPL_Value t94 = dplv_reference(&vm, l5); DPL_Value t95 = dplv_reference(&vm, l5); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 15 /* dot([Number], [Number]): Number */, 2, (DPL_Value[]){t94, t95})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t93)})); }); DPL_Value t88 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 6, (DPL_Value[]){t83, t84, t85, t86, t87, t88}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t82})); }));
+        DPL_Value l6 = ({ DPL_Runtime_Array t96 = {0}; dplv_runtime_array_append(&t96, dpl_value_make_number(({ double t97 = 3.0; -t97; }))); dplv_runtime_array_end(&vm, &t96); });
+        dplv_release(&vm, ({ DPL_Value t98 = ({ DPL_Value t99 = ({ double t107 = ({ DPL_Value t108 = dplv_reference(&vm, l6); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 12 /* sum([Number]): Number */, 1, (DPL_Value[]){t108})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t107)})); }); DPL_Value t100 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t101 = ({ double t109 = ({ DPL_Value t110 = dplv_reference(&vm, l6); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 13 /* min([Number]): Number */, 1, (DPL_Value[]){t110})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t109)})); }); DPL_Value t102 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t103 = ({ double t111 = ({ DPL_Value t112 = dplv_reference(&vm, l6); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 14 /* max([Number]): Number */, 1, (DPL_Value[]){t112})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t111)})); }); DPL_Value t104 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t105 = ({ double t113 = ({ DPL_Value t114 = ({ DPL_Value t116 = dplv_reference(&vm, l6); double t117 = 2.0; (dplv_runtime_call_intrinsic(&vm, 16 /* scale([Number], Number): [Number] */, 2, (DPL_Value[]){t116, dpl_value_make_number(t117)})); }); double t115 = 0.0; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t114, dpl_value_make_number(t115)})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t113)})); }); DPL_Value t106 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 8, (DPL_Value[]){t99, t100, t101, t102, t103, t104, t105, t106}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t98})); }));
+        double l7 = ({ double t118 = 0.0; double t119 = 0.0; t118 / t119; }); (void)l7;
+        DPL_Value l8 = ({ DPL_Runtime_Array t120 = {0}; dplv_runtime_array_append(&t120, dpl_value_make_number(3.0)); dplv_runtime_array_append(&t120, dpl_value_make_number(l7)); dplv_runtime_array_append(&t120, dpl_value_make_number(1.0)); dplv_runtime_array_end(&vm, &t120); });
+        DPL_Value l9 = ({
+            double l9 = 1.0; (void)l9;
+            double l10 = 11.0; (void)l10;
+            DPL_Value t121 = ({
+                DPL_Value t122 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l9 > l10))
+                {
+                    t122 = dplv_runtime_concat_array(&vm, t122, dpl_value_make_number(({
+                        double l12 = l9; (void)l12;
+                        double l13 = (({ double t124 = l12; double t125 = 6.0; dpl_value_compare_numbers(t124, t125) == 0; })
+                            ? l7
+                            : l12); (void)l13;
+                        (void)((l9 = ({ double t126 = l9; double t127 = 1.0; t126 + t127; })));
+                        double t123 = l13;
+                        t123;
+                    })));
+                }
+                t122;
+            });
+            t121;
+        });
+        DPL_Value l10 = ({
+            double l10 = 1.0; (void)l10;
+            double l11 = 9.0; (void)l11;
+            DPL_Value t128 = ({
+                DPL_Value t129 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l10 > l11))
+                {
+                    t129 = dplv_runtime_concat_array(&vm, t129, dpl_value_make_number(({
+                        double l13 = l10; (void)l13;
+                        double l14 = (({ double t131 = l13; double t132 = 9.0; dpl_value_compare_numbers(t131, t132) == 0; })
+                            ? l7
+                            : l13); (void)l14;
+                        (void)((l10 = ({ double t133 = l10; double t134 = 1.0; t133 + t134; })));
+                        double t130 = l14;
+                        t130;
+                    })));
+                }
+                t129;
+            });
+            t128;
+        });
+        DPL_Value t2 = ({ DPL_Value t135 = ({ DPL_Value t136 = ({ bool t148 = ({ double t149 = ({ DPL_Value t150 = dplv_reference(&vm, l8); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 13 /* min([Number]): Number */, 1, (DPL_Value[]){t150})); }); dpl_function_0(t149); }); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t148)})); }); DPL_Value t137 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t138 = ({ bool t151 = ({ double t152 = ({ DPL_Value t153 = dplv_reference(&vm, l8); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 14 /* max([Number]): Number */, 1, (DPL_Value[]){t153})); }); dpl_function_0(t152); }); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t151)})); }); DPL_Value t139 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t140 = ({ bool t154 = ({ double t155 = ({ DPL_Value t156 = dplv_reference(&vm, l9); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 13 /* min([Number]): Number */, 1, (DPL_Value[]){t156})); }); dpl_function_0(t155); }); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t154)})); }); DPL_Value t141 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t142 = ({ bool t157 = ({ double t158 = ({ DPL_Value t159 = dplv_reference(&vm, l9); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 14 /* max([Number]): Number */, 1, (DPL_Value[]){t159})); }); dpl_function_0(t158); }); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t157)})); }); DPL_Value t143 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t144 = ({ bool t160 = ({ double t161 = ({ DPL_Value t162 = dplv_reference(&vm, l10); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 13 /* min([Number]): Number */, 1, (DPL_Value[]){t162})); }); dpl_function_0(t161); }); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t160)})); }); DPL_Value t145 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t146 = ({ bool t163 = ({ double t164 = ({ DPL_Value t165 = dplv_reference(&vm, l10); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 14 /* max([Number]): Number */, 1, (DPL_Value[]){t165})); }); dpl_function_0(t164); }); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t163)})); }); DPL_Value t147 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 12, (DPL_Value[]){t136, t137, t138, t139, t140, t141, t142, t143, t144, t145, t146, t147}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t135})); });
+        dplv_release(&vm, l0);
+        dplv_release(&vm, l1);
+        dplv_release(&vm, l2);
+        dplv_release(&vm, l3);
+        dplv_release(&vm, l4);
+        dplv_release(&vm, l5);
+        dplv_release(&vm, l6);
+        dplv_release(&vm, l8);
+        dplv_release(&vm, l9);
+        dplv_release(&vm, l10);
+        t2;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,200 @@
+// Generated by dplc from ./tests/28-persistent-arrays.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        DPL_Value l0 = ({
+            double l0 = 1.0; (void)l0;
+            double l1 = 300.0; (void)l1;
+            DPL_Value t1 = ({
+                DPL_Value t2 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l0 > l1))
+                {
+                    t2 = dplv_runtime_concat_array(&vm, t2, dpl_value_make_number(({
+                        double l3 = l0; (void)l3;
+                        double l4 = l3; (void)l4;
+                        (void)((l0 = ({ double t4 = l0; double t5 = 1.0; t4 + t5; })));
+                        double t3 = l4;
+                        t3;
+                    })));
+                }
+                t2;
+            });
+            t1;
+        });
+        DPL_Value l1 = ({ DPL_Runtime_Array t6 = {0}; dplv_runtime_array_spread(&vm, &t6, dplv_reference(&vm, l0)); dplv_runtime_array_append(&t6, dpl_value_make_number(301.0)); dplv_runtime_array_end(&vm, &t6); });
+        DPL_Value l2 = ({ DPL_Runtime_Array t7 = {0}; dplv_runtime_array_append(&t7, dpl_value_make_number(0.0)); dplv_runtime_array_spread(&vm, &t7, dplv_reference(&vm, l1)); dplv_runtime_array_append(&t7, dpl_value_make_number(302.0)); dplv_runtime_array_end(&vm, &t7); });
+        dplv_release(&vm, ({ DPL_Value t8 = ({ DPL_Value t9 = ({ double t15 = ({ DPL_Value t16 = dplv_reference(&vm, l0); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 8 /* <T>length([T]): Number */, 1, (DPL_Value[]){t16})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t15)})); }); DPL_Value t10 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t11 = ({ double t17 = ({ DPL_Value t18 = dplv_reference(&vm, l1); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 8 /* <T>length([T]): Number */, 1, (DPL_Value[]){t18})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t17)})); }); DPL_Value t12 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t13 = ({ double t19 = ({ DPL_Value t20 = dplv_reference(&vm, l2); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 8 /* <T>length([T]): Number */, 1, (DPL_Value[]){t20})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t19)})); }); DPL_Value t14 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 6, (DPL_Value[]){t9, t10, t11, t12, t13, t14}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t8})); }));
+        dplv_release(&vm, ({ DPL_Value t21 = ({ DPL_Value t22 = ({ double t32 = ({ DPL_Value t33 = dplv_reference(&vm, l2); double t34 = 0.0; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t33, dpl_value_make_number(t34)})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t32)})); }); DPL_Value t23 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t24 = ({ double t35 = ({ DPL_Value t36 = dplv_reference(&vm, l2); double t37 = 1.0; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t36, dpl_value_make_number(t37)})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t35)})); }); DPL_Value t25 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t26 = ({ double t38 = ({ DPL_Value t39 = dplv_reference(&vm, l2); double t40 = 300.0; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t39, dpl_value_make_number(t40)})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t38)})); }); DPL_Value t27 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t28 = ({ double t41 = ({ DPL_Value t42 = dplv_reference(&vm, l2); double t43 = 301.0; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t42, dpl_value_make_number(t43)})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t41)})); }); DPL_Value t29 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t30 = ({ double t44 = ({ DPL_Value t45 = dplv_reference(&vm, l2); double t46 = 302.0; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t45, dpl_value_make_number(t46)})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t44)})); }); DPL_Value t31 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 10, (DPL_Value[]){t22, t23, t24, t25, t26, t27, t28, t29, t30, t31}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t21})); }));
+        DPL_Value l3 = dplv_reference(&vm, l2);
+        dplv_release(&vm, ({
+            double l4 = 1.0; (void)l4;
+            double l5 = 2000.0; (void)l5;
+            DPL_Value t47 = ({
+                DPL_Value t48 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l4 > l5))
+                {
+                    dplv_release(&vm, ({
+                        double l7 = l4; (void)l7;
+                        DPL_Value l8 = ({ DPL_Value t50 = ({ DPL_Runtime_Array t51 = {0}; dplv_runtime_array_spread(&vm, &t51, dplv_runtime_move(&l3)); dplv_runtime_array_append(&t51, dpl_value_make_number(l7)); dplv_runtime_array_end(&vm, &t51); }); dplv_release(&vm, l3); l3 = dplv_reference(&vm, t50); t50; });
+                        (void)((l4 = ({ double t52 = l4; double t53 = 1.0; t52 + t53; })));
+                        DPL_Value t49 = dplv_reference(&vm, l8);
+                        dplv_release(&vm, l8);
+                        t49;
+                    }));
+                }
+                t48;
+            });
+            t47;
+        }));
+        dplv_release(&vm, ({
+            double l4 = 1.0; (void)l4;
+            double l5 = 2000.0; (void)l5;
+            DPL_Value t54 = ({
+                DPL_Value t55 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l4 > l5))
+                {
+                    dplv_release(&vm, ({
+                        double l7 = l4; (void)l7;
+                        DPL_Value l8 = ({ DPL_Value t57 = ({ DPL_Runtime_Array t58 = {0}; dplv_runtime_array_append(&t58, dpl_value_make_number(({ double t59 = l7; -t59; }))); dplv_runtime_array_spread(&vm, &t58, dplv_runtime_move(&l3)); dplv_runtime_array_end(&vm, &t58); }); dplv_release(&vm, l3); l3 = dplv_reference(&vm, t57); t57; });
+                        (void)((l4 = ({ double t60 = l4; double t61 = 1.0; t60 + t61; })));
+                        DPL_Value t56 = dplv_reference(&vm, l8);
+                        dplv_release(&vm, l8);
+                        t56;
+                    }));
+                }
+                t55;
+            });
+            t54;
+        }));
+        dplv_release(&vm, ({ DPL_Value t62 = ({ DPL_Value t63 = ({ double t73 = ({ DPL_Value t74 = dplv_reference(&vm, l2); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 8 /* <T>length([T]): Number */, 1, (DPL_Value[]){t74})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t73)})); }); DPL_Value t64 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t65 = ({ double t75 = ({ DPL_Value t76 = dplv_reference(&vm, l3); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 8 /* <T>length([T]): Number */, 1, (DPL_Value[]){t76})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t75)})); }); DPL_Value t66 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t67 = ({ double t77 = ({ DPL_Value t78 = dplv_reference(&vm, l3); double t79 = 0.0; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t78, dpl_value_make_number(t79)})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t77)})); }); DPL_Value t68 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t69 = ({ double t80 = ({ DPL_Value t81 = dplv_reference(&vm, l3); double t82 = 2000.0; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t81, dpl_value_make_number(t82)})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t80)})); }); DPL_Value t70 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t71 = ({ double t83 = ({ DPL_Value t84 = dplv_reference(&vm, l3); double t85 = 4302.0; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t84, dpl_value_make_number(t85)})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t83)})); }); DPL_Value t72 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 10, (DPL_Value[]){t63, t64, t65, t66, t67, t68, t69, t70, t71, t72}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t62})); }));
+        dplv_release(&vm, ({ DPL_Value t86 = ({ DPL_Value t87 = ({ double t93 = ({ DPL_Value t94 = dplv_reference(&vm, l3); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 12 /* sum([Number]): Number */, 1, (DPL_Value[]){t94})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t93)})); }); DPL_Value t88 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t89 = ({ double t95 = ({ DPL_Value t96 = dplv_reference(&vm, l3); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 13 /* min([Number]): Number */, 1, (DPL_Value[]){t96})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t95)})); }); DPL_Value t90 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t91 = ({ double t97 = ({ DPL_Value t98 = dplv_reference(&vm, l3); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 14 /* max([Number]): Number */, 1, (DPL_Value[]){t98})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t97)})); }); DPL_Value t92 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 6, (DPL_Value[]){t87, t88, t89, t90, t91, t92}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t86})); }));
+        DPL_Value l4 = ({ DPL_Runtime_Array t99 = {0}; dplv_runtime_array_spread(&vm, &t99, dplv_reference(&vm, l3)); dplv_runtime_array_end(&vm, &t99); });
+        double l5 = 0.0; (void)l5;
+        dplv_release(&vm, ({
+            DPL_Value l6 = dplv_reference(&vm, l4);
+            double l7 = 0.0; (void)l7;
+            DPL_Value t100 = ({
+                DPL_Value t101 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while ((l7 < dpl_value_array_element_count(dpl_value_as_array(l6))))
+                {
+                    (void)(({
+                        double l9 = ({ DPL_Value t103 = dplv_reference(&vm, l6); double t104 = l7; dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t103, dpl_value_make_number(t104)})); }); (void)l9;
+                        double l10 = (l5 = ({ double t105 = l5; double t106 = l9; t105 + t106; })); (void)l10;
+                        (void)((l7 = ({ double t107 = l7; double t108 = 1.0; t107 + t108; })));
+                        double t102 = l10;
+                        t102;
+                    }));
+                }
+                t101;
+            });
+            dplv_release(&vm, l6);
+            t100;
+        }));
+        dplv_release(&vm, ({ DPL_Value t109 = ({ DPL_Value t110 = ({ double t112 = l5; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t112)})); }); DPL_Value t111 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t110, t111}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t109})); }));
+        DPL_Value l6 = ({
+            double l6 = 1.0; (void)l6;
+            double l7 = 260.0; (void)l7;
+            DPL_Value t113 = ({
+                DPL_Value t114 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l6 > l7))
+                {
+                    t114 = dplv_runtime_concat_array(&vm, t114, ({
+                        double l9 = l6; (void)l9;
+                        DPL_Value l10 = ({ DPL_Value t116 = dpl_value_make_string(&vm.stack_pool, 1, "w"); DPL_Value t117 = ({ double t118 = l9; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t118)})); }); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t116, t117}); });
+                        (void)((l6 = ({ double t119 = l6; double t120 = 1.0; t119 + t120; })));
+                        DPL_Value t115 = dplv_reference(&vm, l10);
+                        dplv_release(&vm, l10);
+                        t115;
+                    }));
+                }
+                t114;
+            });
+            t113;
+        });
+        DPL_Value l7 = ({ DPL_Runtime_Array t121 = {0}; dplv_runtime_array_append(&t121, dpl_value_make_string(&vm.stack_pool, 1, "<")); dplv_runtime_array_spread(&vm, &t121, dplv_reference(&vm, l6)); dplv_runtime_array_append(&t121, dpl_value_make_string(&vm.stack_pool, 1, ">")); dplv_runtime_array_end(&vm, &t121); });
+        DPL_Value l8 = dpl_value_make_string(&vm.stack_pool, 0, "");
+        dplv_release(&vm, ({
+            double l9 = 255.0; (void)l9;
+            double l10 = 261.0; (void)l10;
+            DPL_Value t122 = ({
+                DPL_Value t123 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l9 > l10))
+                {
+                    dplv_release(&vm, ({
+                        double l12 = l9; (void)l12;
+                        DPL_Value l13 = ({ DPL_Value t125 = ({ DPL_Value t126 = dplv_runtime_move(&l8); DPL_Value t127 = ({ DPL_Value t128 = dplv_reference(&vm, l7); double t129 = l12; (dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t128, dpl_value_make_number(t129)})); }); dplv_runtime_concat_string(&vm, t126, t127); }); dplv_release(&vm, l8); l8 = dplv_reference(&vm, t125); t125; });
+                        (void)((l9 = ({ double t130 = l9; double t131 = 1.0; t130 + t131; })));
+                        DPL_Value t124 = dplv_reference(&vm, l13);
+                        dplv_release(&vm, l13);
+                        t124;
+                    }));
+                }
+                t123;
+            });
+            t122;
+        }));
+        dplv_release(&vm, ({ DPL_Value t132 = ({ DPL_Value t133 = ({ double t137 = ({ DPL_Value t138 = dplv_reference(&vm, l7); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 8 /* <T>length([T]): Number */, 1, (DPL_Value[]){t138})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t137)})); }); DPL_Value t134 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t135 = dplv_reference(&vm, l8); DPL_Value t136 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 4, (DPL_Value[]){t133, t134, t135, t136}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t132})); }));
+        DPL_Value l9 = ({
+            DPL_Value l9 = dplv_reference(&vm, l7);
+            double l10 = 0.0; (void)l10;
+            DPL_Value t139 = ({
+                DPL_Value t140 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while ((l10 < dpl_value_array_element_count(dpl_value_as_array(l9))))
+                {
+                    t140 = dplv_runtime_concat_array(&vm, t140, dpl_value_make_number(({
+                        DPL_Value l12 = ({ DPL_Value t142 = dplv_reference(&vm, l9); double t143 = l10; (dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t142, dpl_value_make_number(t143)})); });
+                        double l13 = ({ DPL_Value t144 = dplv_reference(&vm, l12); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 6 /* length(String): Number */, 1, (DPL_Value[]){t144})); }); (void)l13;
+                        (void)((l10 = ({ double t145 = l10; double t146 = 1.0; t145 + t146; })));
+                        double t141 = l13;
+                        dplv_release(&vm, l12);
+                        t141;
+                    })));
+                }
+                t140;
+            });
+            dplv_release(&vm, l9);
+            t139;
+        });
+        DPL_Value t0 = ({ DPL_Value t147 = ({ DPL_Value t148 = ({ double t152 = ({ DPL_Value t153 = dplv_reference(&vm, l9); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 8 /* <T>length([T]): Number */, 1, (DPL_Value[]){t153})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t152)})); }); DPL_Value t149 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t150 = ({ double t154 = ({ DPL_Value t155 = dplv_reference(&vm, l9); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 12 /* sum([Number]): Number */, 1, (DPL_Value[]){t155})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t154)})); }); DPL_Value t151 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 4, (DPL_Value[]){t148, t149, t150, t151}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t147})); });
+        dplv_release(&vm, l0);
+        dplv_release(&vm, l1);
+        dplv_release(&vm, l2);
+        dplv_release(&vm, l3);
+        dplv_release(&vm, l4);
+        dplv_release(&vm, l6);
+        dplv_release(&vm, l7);
+        dplv_release(&vm, l8);
+        dplv_release(&vm, l9);
+        t0;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
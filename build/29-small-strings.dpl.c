@@ -0,0 +1,104 @@
+// Generated by dplc from ./tests/29-small-strings.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        DPL_Value l0 = dpl_value_make_string(&vm.stack_pool, 5, "abcde");
+        DPL_Value l1 = dpl_value_make_string(&vm.stack_pool, 14, "abcdefghijklmn");
+        DPL_Value l2 = dpl_value_make_string(&vm.stack_pool, 15, "abcdefghijklmno");
+        dplv_release(&vm, ({ DPL_Value t1 = ({ DPL_Value t2 = ({ double t8 = ({ DPL_Value t9 = dplv_reference(&vm, l0); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 6 /* length(String): Number */, 1, (DPL_Value[]){t9})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t8)})); }); DPL_Value t3 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t4 = ({ double t10 = ({ DPL_Value t11 = dplv_reference(&vm, l1); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 6 /* length(String): Number */, 1, (DPL_Value[]){t11})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t10)})); }); DPL_Value t5 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t6 = ({ double t12 = ({ DPL_Value t13 = dplv_reference(&vm, l2); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 6 /* length(String): Number */, 1, (DPL_Value[]){t13})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t12)})); }); DPL_Value t7 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 6, (DPL_Value[]){t2, t3, t4, t5, t6, t7}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t1})); }));
+        DPL_Value l3 = dpl_value_make_string(&vm.stack_pool, 0, "");
+        dplv_release(&vm, ({
+            DPL_Value l4 = ({ DPL_Runtime_Array t15 = {0}; dplv_runtime_array_append(&t15, dpl_value_make_string(&vm.stack_pool, 1, "a")); dplv_runtime_array_append(&t15, dpl_value_make_string(&vm.stack_pool, 1, "b")); dplv_runtime_array_append(&t15, dpl_value_make_string(&vm.stack_pool, 1, "c")); dplv_runtime_array_append(&t15, dpl_value_make_string(&vm.stack_pool, 1, "d")); dplv_runtime_array_append(&t15, dpl_value_make_string(&vm.stack_pool, 1, "e")); dplv_runtime_array_append(&t15, dpl_value_make_string(&vm.stack_pool, 1, "f")); dplv_runtime_array_append(&t15, dpl_value_make_string(&vm.stack_pool, 1, "g")); dplv_runtime_array_append(&t15, dpl_value_make_string(&vm.stack_pool, 1, "h")); dplv_runtime_array_append(&t15, dpl_value_make_string(&vm.stack_pool, 1, "i")); dplv_runtime_array_append(&t15, dpl_value_make_string(&vm.stack_pool, 1, "j")); dplv_runtime_array_append(&t15, dpl_value_make_string(&vm.stack_pool, 1, "k")); dplv_runtime_array_append(&t15, dpl_value_make_string(&vm.stack_pool, 1, "l")); dplv_runtime_array_append(&t15, dpl_value_make_string(&vm.stack_pool, 1, "m")); dplv_runtime_array_append(&t15, dpl_value_make_string(&vm.stack_pool, 1, "n")); dplv_runtime_array_append(&t15, dpl_value_make_string(&vm.stack_pool, 1, "o")); dplv_runtime_array_end(&vm, &t15); });
+            double l5 = 0.0; (void)l5;
+            DPL_Value t14 = ({
+                DPL_Value t16 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while ((l5 < dpl_value_array_element_count(dpl_value_as_array(l4))))
+                {
+                    dplv_release(&vm, ({
+                        DPL_Value l7 = ({ DPL_Value t18 = dplv_reference(&vm, l4); double t19 = l5; (dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t18, dpl_value_make_number(t19)})); });
+                        DPL_Value l8 = ({
+                            dplv_release(&vm, ({ DPL_Value t21 = ({ DPL_Value t22 = dplv_runtime_move(&l3); DPL_Value t23 = dplv_reference(&vm, l7); dplv_runtime_concat_string(&vm, t22, t23); }); dplv_release(&vm, l3); l3 = dplv_reference(&vm, t21); t21; }));
+                            DPL_Value t20 = ({ DPL_Value t24 = (({ DPL_Value t25 = dplv_reference(&vm, l3); DPL_Value t26 = dplv_reference(&vm, l1); dplv_runtime_string_equals(&vm, t25, t26); })
+                                ? dpl_value_make_string(&vm.stack_pool, 1, "=")
+                                : (({ DPL_Value t27 = dplv_reference(&vm, l3); DPL_Value t28 = dplv_reference(&vm, l2); dplv_runtime_string_equals(&vm, t27, t28); })
+                                    ? dpl_value_make_string(&vm.stack_pool, 1, "!")
+                                    : dpl_value_make_string(&vm.stack_pool, 1, "."))); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t24})); });
+                            t20;
+                        });
+                        (void)((l5 = ({ double t29 = l5; double t30 = 1.0; t29 + t30; })));
+                        DPL_Value t17 = dplv_reference(&vm, l8);
+                        dplv_release(&vm, l7);
+                        dplv_release(&vm, l8);
+                        t17;
+                    }));
+                }
+                t16;
+            });
+            dplv_release(&vm, l4);
+            t14;
+        }));
+        dplv_release(&vm, ({ DPL_Value t31 = ({ DPL_Value t32 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); DPL_Value t33 = ({ bool t39 = ({ DPL_Value t40 = dplv_reference(&vm, l3); DPL_Value t41 = dplv_reference(&vm, l2); dplv_runtime_string_equals(&vm, t40, t41); }); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t39)})); }); DPL_Value t34 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t35 = ({ bool t42 = ({ DPL_Value t43 = dplv_reference(&vm, l3); DPL_Value t44 = dplv_reference(&vm, l1); !dplv_runtime_string_equals(&vm, t43, t44); }); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t42)})); }); DPL_Value t36 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t37 = ({ bool t45 = ({ DPL_Value t46 = ({ DPL_Value t48 = dplv_reference(&vm, l0); DPL_Value t49 = dpl_value_make_string(&vm.stack_pool, 9, "fghijklmn"); dplv_runtime_concat_string(&vm, t48, t49); }); DPL_Value t47 = dplv_reference(&vm, l1); dplv_runtime_string_equals(&vm, t46, t47); }); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t45)})); }); DPL_Value t38 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 7, (DPL_Value[]){t32, t33, t34, t35, t36, t37, t38}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t31})); }));
+        DPL_Value l4 = ({ DPL_Runtime_Array t50 = {0}; dplv_runtime_array_append(&t50, dpl_value_make_string(&vm.stack_pool, 0, "")); dplv_runtime_array_append(&t50, dpl_value_make_string(&vm.stack_pool, 1, "x")); dplv_runtime_array_append(&t50, ({ DPL_Value t51 = dplv_reference(&vm, l0); DPL_Value t52 = dplv_reference(&vm, l0); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t51, t52}); })); dplv_runtime_array_append(&t50, ({ DPL_Value t53 = dplv_reference(&vm, l1); DPL_Value t54 = dpl_value_make_string(&vm.stack_pool, 1, "!"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t53, t54}); })); dplv_runtime_array_append(&t50, ({ double t55 = ({ double t56 = 12345.0; double t57 = 3.0; t56 * t57; }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t55)})); })); dplv_runtime_array_end(&vm, &t50); });
+        dplv_release(&vm, ({
+            DPL_Value l5 = dplv_reference(&vm, l4);
+            double l6 = 0.0; (void)l6;
+            DPL_Value t58 = ({
+                DPL_Value t59 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while ((l6 < dpl_value_array_element_count(dpl_value_as_array(l5))))
+                {
+                    dplv_release(&vm, ({
+                        DPL_Value l8 = ({ DPL_Value t61 = dplv_reference(&vm, l5); double t62 = l6; (dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t61, dpl_value_make_number(t62)})); });
+                        DPL_Value l9 = ({ DPL_Value t63 = ({ DPL_Value t64 = dpl_value_make_string(&vm.stack_pool, 1, "["); DPL_Value t65 = dplv_reference(&vm, l8); DPL_Value t66 = dpl_value_make_string(&vm.stack_pool, 2, "] "); dplv_runtime_interpolation(&vm, 3, (DPL_Value[]){t64, t65, t66}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t63})); });
+                        (void)((l6 = ({ double t67 = l6; double t68 = 1.0; t67 + t68; })));
+                        DPL_Value t60 = dplv_reference(&vm, l9);
+                        dplv_release(&vm, l8);
+                        dplv_release(&vm, l9);
+                        t60;
+                    }));
+                }
+                t59;
+            });
+            dplv_release(&vm, l5);
+            t58;
+        }));
+        dplv_release(&vm, ({ DPL_Value t69 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t69})); }));
+        dplv_release(&vm, ({ DPL_Value t70 = ({ DPL_Value t71 = ({ DPL_Value t73 = dplv_reference(&vm, l1); DPL_Value t74 = dplv_reference(&vm, l2); dplv_runtime_concat_string(&vm, t73, t74); }); DPL_Value t72 = dplv_reference(&vm, l0); dplv_runtime_concat_string(&vm, t71, t72); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t70})); }));
+        DPL_Value t0 = ({ DPL_Value t75 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t75})); });
+        dplv_release(&vm, l0);
+        dplv_release(&vm, l1);
+        dplv_release(&vm, l2);
+        dplv_release(&vm, l3);
+        dplv_release(&vm, l4);
+        t0;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+// Generated by dplc from ./tests/30-packed-objects.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+static DPL_Value dpl_function_0(DPL_Value l0, double l1, bool l2);
+static DPL_Value dpl_function_1(DPL_Value l0, DPL_Value l1);
+
+// make
+static DPL_Value dpl_function_0(DPL_Value l0, double l1, bool l2)
+{
+    DPL_Value result;
+    result = ({ DPL_Value t0 = dpl_value_make_boolean(l2); DPL_Value t1 = dplv_reference(&vm, l0); DPL_Value t2 = dpl_value_make_number(l1); DPL_Value t3 = ({ DPL_Runtime_Array t4 = {0}; dplv_runtime_array_append(&t4, dplv_reference(&vm, l0)); dplv_runtime_array_append(&t4, dpl_value_make_string(&vm.stack_pool, 4, "item")); dplv_runtime_array_end(&vm, &t4); }); dpl_value_make_object(&vm.stack_pool, 4, (DPL_Value[]){t0, t1, t2, t3}); });
+    dplv_release(&vm, l0);
+    return result;
+}
+
+// cheaper
+static DPL_Value dpl_function_1(DPL_Value l0, DPL_Value l1)
+{
+    DPL_Value result;
+    result = (({ double t5 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 2); double t6 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l1), 2); dpl_value_compare_numbers(t5, t6) < 0; })
+        ? dplv_reference(&vm, l0)
+        : dplv_reference(&vm, l1));
+    dplv_release(&vm, l0);
+    dplv_release(&vm, l1);
+    return result;
+}
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        DPL_Value l0 = ({ DPL_Runtime_Array t8 = {0}; dplv_runtime_array_append(&t8, ({ DPL_Value t9 = dpl_value_make_string(&vm.stack_pool, 5, "apple"); double t10 = 3.0; bool t11 = true; dpl_function_0(t9, t10, t11); })); dplv_runtime_array_append(&t8, ({ DPL_Value t12 = dpl_value_make_string(&vm.stack_pool, 21, "a very long pear name"); double t13 = 2.5; bool t14 = false; dpl_function_0(t12, t13, t14); })); dplv_runtime_array_append(&t8, ({ DPL_Value t15 = dpl_value_make_string(&vm.stack_pool, 3, "fig"); double t16 = 7.0; bool t17 = true; dpl_function_0(t15, t16, t17); })); dplv_runtime_array_end(&vm, &t8); });
+        double l1 = 0.0; (void)l1;
+        double l2 = 0.0; (void)l2;
+        dplv_release(&vm, ({
+            DPL_Value l3 = dplv_reference(&vm, l0);
+            double l4 = 0.0; (void)l4;
+            DPL_Value t18 = ({
+                DPL_Value t19 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while ((l4 < dpl_value_array_element_count(dpl_value_as_array(l3))))
+                {
+                    dplv_release(&vm, ({
+                        DPL_Value l6 = ({ DPL_Value t21 = dplv_reference(&vm, l3); double t22 = l4; (dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t21, dpl_value_make_number(t22)})); });
+                        DPL_Value l7 = ({
+                            (void)((l1 = ({ double t24 = l1; double t25 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l6), 2); t24 + t25; })));
+                            (void)((l2 = ({ double t26 = l2; double t27 = (dplv_runtime_load_field_boolean(&vm, dplv_reference(&vm, l6), 0)
+                                ? 1.0
+                                : 0.0); t26 + t27; })));
+                            DPL_Value t23 = ({ DPL_Value t28 = ({ DPL_Value t29 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l6), 1); DPL_Value t30 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t31 = ({ double t39 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l6), 2); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t39)})); }); DPL_Value t32 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t33 = ({ bool t40 = dplv_runtime_load_field_boolean(&vm, dplv_reference(&vm, l6), 0); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t40)})); }); DPL_Value t34 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t35 = ({ double t41 = ({ DPL_Value t42 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l6), 3); dpl_value_as_number(dplv_runtime_call_intrinsic(&vm, 8 /* <T>length([T]): Number */, 1, (DPL_Value[]){t42})); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t41)})); }); DPL_Value t36 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t37 = ({ DPL_Value t43 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l6), 3); double t44 = 0.0; (dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t43, dpl_value_make_number(t44)})); }); DPL_Value t38 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 10, (DPL_Value[]){t29, t30, t31, t32, t33, t34, t35, t36, t37, t38}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t28})); });
+                            t23;
+                        });
+                        (void)((l4 = ({ double t45 = l4; double t46 = 1.0; t45 + t46; })));
+                        DPL_Value t20 = dplv_reference(&vm, l7);
+                        dplv_release(&vm, l6);
+                        dplv_release(&vm, l7);
+                        t20;
+                    }));
+                }
+                t19;
+            });
+            dplv_release(&vm, l3);
+            t18;
+        }));
+        dplv_release(&vm, ({ DPL_Value t47 = ({ DPL_Value t48 = ({ double t52 = l1; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t52)})); }); DPL_Value t49 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t50 = ({ double t53 = l2; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t53)})); }); DPL_Value t51 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 4, (DPL_Value[]){t48, t49, t50, t51}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t47})); }));
+        DPL_Value l3 = ({ DPL_Value t54 = ({ DPL_Value t56 = ({ DPL_Value t58 = dplv_reference(&vm, l0); double t59 = 0.0; (dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t58, dpl_value_make_number(t59)})); }); DPL_Value t57 = ({ DPL_Value t60 = dplv_reference(&vm, l0); double t61 = 1.0; (dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t60, dpl_value_make_number(t61)})); }); dpl_function_1(t56, t57); }); DPL_Value t55 = ({ DPL_Value t62 = dplv_reference(&vm, l0); double t63 = 2.0; (dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t62, dpl_value_make_number(t63)})); }); dpl_function_1(t54, t55); });
+        dplv_release(&vm, ({ DPL_Value t64 = ({ DPL_Value t65 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l3), 1); DPL_Value t66 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t67 = ({ double t71 = dplv_runtime_load_field_number(&vm, ({ DPL_Value t72 = dpl_value_make_string(&vm.stack_pool, 4, "kiwi"); double t73 = 1.0; bool t74 = true; dpl_function_0(t72, t73, t74); }), 2); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t71)})); }); DPL_Value t68 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t69 = ({ bool t75 = dplv_runtime_load_field_boolean(&vm, ({ DPL_Value t76 = dpl_value_make_string(&vm.stack_pool, 4, "kiwi"); double t77 = 1.0; bool t78 = false; dpl_function_0(t76, t77, t78); }), 0); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t75)})); }); DPL_Value t70 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 6, (DPL_Value[]){t65, t66, t67, t68, t69, t70}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t64})); }));
+        DPL_Value l4 = ({ DPL_Value t79 = dpl_value_make_boolean(true); DPL_Value t80 = dpl_value_make_number(1.0); DPL_Value t81 = dpl_value_make_boolean(false); DPL_Value t82 = dpl_value_make_string(&vm.stack_pool, 1, "x"); DPL_Value t83 = dpl_value_make_number(2.0); dpl_value_make_object(&vm.stack_pool, 5, (DPL_Value[]){t79, t80, t81, t82, t83}); });
+        DPL_Value l5 = ({
+            DPL_Value l5 = dplv_reference(&vm, l4);
+            DPL_Value t84 = ({ DPL_Value t85 = dpl_value_make_boolean(dplv_runtime_load_field_boolean(&vm, dplv_reference(&vm, l5), 0)); DPL_Value t86 = dpl_value_make_number(dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l5), 1)); DPL_Value t87 = dpl_value_make_boolean(true); DPL_Value t88 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l5), 3); DPL_Value t89 = dpl_value_make_number(({ double t90 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l5), 4); double t91 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l5), 1); t90 + t91; })); dpl_value_make_object(&vm.stack_pool, 5, (DPL_Value[]){t85, t86, t87, t88, t89}); });
+            dplv_release(&vm, l5);
+            t84;
+        });
+        DPL_Value t7 = ({ DPL_Value t92 = ({ DPL_Value t93 = ({ bool t103 = dplv_runtime_load_field_boolean(&vm, dplv_reference(&vm, l5), 0); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t103)})); }); DPL_Value t94 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t95 = ({ double t104 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l5), 1); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t104)})); }); DPL_Value t96 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t97 = ({ bool t105 = dplv_runtime_load_field_boolean(&vm, dplv_reference(&vm, l5), 2); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t105)})); }); DPL_Value t98 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t99 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l5), 3); DPL_Value t100 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t101 = ({ double t106 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l5), 4); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t106)})); }); DPL_Value t102 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 10, (DPL_Value[]){t93, t94, t95, t96, t97, t98, t99, t100, t101, t102}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t92})); });
+        dplv_release(&vm, l0);
+        dplv_release(&vm, l3);
+        dplv_release(&vm, l4);
+        dplv_release(&vm, l5);
+        t7;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,161 @@
+// Generated by dplc from ./tests/31-object-updates.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+static DPL_Value dpl_function_0(DPL_Value l0);
+static DPL_Value dpl_function_1(DPL_Value l0);
+
+// advance
+static DPL_Value dpl_function_0(DPL_Value l0)
+{
+    DPL_Value result;
+    result = (dplv_runtime_load_field_boolean(&vm, dplv_reference(&vm, l0), 2)
+        ? ({
+            DPL_Value l1 = dplv_reference(&vm, l0);
+            DPL_Value t0 = ({ DPL_Value t1 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l1), 0); DPL_Value t2 = ({ DPL_Value t5 = dpl_value_make_string(&vm.stack_pool, 5, "step "); DPL_Value t6 = ({ double t7 = ({ double t8 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l1), 3); double t9 = 1.0; t8 + t9; }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t7)})); }); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t5, t6}); }); DPL_Value t3 = dpl_value_make_boolean(false); DPL_Value t4 = dpl_value_make_number(({ double t10 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l1), 3); double t11 = 1.0; t10 + t11; })); dplv_runtime_create_object_reuse(&vm, l1, 4, (DPL_Value[]){t1, t2, t3, t4}); });
+            dplv_release(&vm, l1);
+            t0;
+        })
+        : ({ DPL_Value t12 = ({ DPL_Runtime_Array t16 = {0}; dplv_runtime_array_append(&t16, dplv_runtime_load_field(&vm, dplv_reference(&vm, l0), 1)); dplv_runtime_array_end(&vm, &t16); }); DPL_Value t13 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l0), 1); DPL_Value t14 = dpl_value_make_boolean(true); DPL_Value t15 = dpl_value_make_number(dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 3)); dplv_runtime_create_object_reuse(&vm, l0, 4, (DPL_Value[]){t12, t13, t14, t15}); }));
+    dplv_release(&vm, l0);
+    return result;
+}
+
+// next
+static DPL_Value dpl_function_1(DPL_Value l0)
+{
+    DPL_Value result;
+    result = ({ DPL_Value t17 = dpl_value_make_number(({ double t19 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 0); double t20 = 1.0; t19 - t20; })); DPL_Value t18 = dpl_value_make_boolean(({ double t21 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 0); double t22 = 1.0; dpl_value_compare_numbers(t21, t22) <= 0; })); dplv_runtime_create_object_reuse(&vm, l0, 2, (DPL_Value[]){t17, t18}); });
+    dplv_release(&vm, l0);
+    return result;
+}
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        DPL_Value l0 = ({ DPL_Value t24 = ({ DPL_Runtime_Array t28 = {0}; dplv_runtime_array_append(&t28, dpl_value_make_string(&vm.stack_pool, 5, "start")); dplv_runtime_array_end(&vm, &t28); }); DPL_Value t25 = dpl_value_make_string(&vm.stack_pool, 25, "a rather long start label"); DPL_Value t26 = dpl_value_make_boolean(true); DPL_Value t27 = dpl_value_make_number(0.0); dpl_value_make_object(&vm.stack_pool, 4, (DPL_Value[]){t24, t25, t26, t27}); });
+        DPL_Value l1 = dplv_reference(&vm, l0);
+        dplv_release(&vm, ({
+            double l2 = 1.0; (void)l2;
+            double l3 = 5.0; (void)l3;
+            DPL_Value t29 = ({
+                DPL_Value t30 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l2 > l3))
+                {
+                    dplv_release(&vm, ({
+                        double l5 = l2; (void)l5;
+                        DPL_Value l6 = ({ DPL_Value t32 = ({ DPL_Value t33 = dplv_runtime_move(&l0); dpl_function_0(t33); }); dplv_release(&vm, l0); l0 = dplv_reference(&vm, t32); t32; });
+                        (void)((l2 = ({ double t34 = l2; double t35 = 1.0; t34 + t35; })));
+                        DPL_Value t31 = dplv_reference(&vm, l6);
+                        dplv_release(&vm, l6);
+                        t31;
+                    }));
+                }
+                t30;
+            });
+            t29;
+        }));
+        dplv_release(&vm, ({ DPL_Value t36 = ({ DPL_Value t37 = ({ double t45 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 3); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t45)})); }); DPL_Value t38 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t39 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l0), 1); DPL_Value t40 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t41 = ({ bool t46 = dplv_runtime_load_field_boolean(&vm, dplv_reference(&vm, l0), 2); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t46)})); }); DPL_Value t42 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t43 = ({ DPL_Value t47 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l0), 0); double t48 = 0.0; (dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t47, dpl_value_make_number(t48)})); }); DPL_Value t44 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 8, (DPL_Value[]){t37, t38, t39, t40, t41, t42, t43, t44}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t36})); }));
+        dplv_release(&vm, ({ DPL_Value t49 = ({ DPL_Value t50 = ({ double t58 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l1), 3); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t58)})); }); DPL_Value t51 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t52 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l1), 1); DPL_Value t53 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t54 = ({ bool t59 = dplv_runtime_load_field_boolean(&vm, dplv_reference(&vm, l1), 2); (dplv_runtime_call_intrinsic(&vm, 1 /* toString(Boolean): String */, 1, (DPL_Value[]){dpl_value_make_boolean(t59)})); }); DPL_Value t55 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t56 = ({ DPL_Value t60 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l1), 0); double t61 = 0.0; (dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t60, dpl_value_make_number(t61)})); }); DPL_Value t57 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 8, (DPL_Value[]){t50, t51, t52, t53, t54, t55, t56, t57}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t49})); }));
+        dplv_release(&vm, ({
+            double l2 = 1.0; (void)l2;
+            double l3 = 3.0; (void)l3;
+            DPL_Value t62 = ({
+                DPL_Value t63 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l2 > l3))
+                {
+                    dplv_release(&vm, ({
+                        double l5 = l2; (void)l5;
+                        DPL_Value l6 = ({ DPL_Value t65 = ({
+                            DPL_Value l6 = dplv_runtime_move(&l0);
+                            DPL_Value t66 = ({ DPL_Value t67 = ({ DPL_Runtime_Array t71 = {0}; dplv_runtime_array_append(&t71, dplv_runtime_load_field(&vm, dplv_reference(&vm, l6), 1)); dplv_runtime_array_append(&t71, ({ DPL_Value t72 = ({ double t73 = l5; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t73)})); }); dplv_runtime_interpolation(&vm, 1, (DPL_Value[]){t72}); })); dplv_runtime_array_end(&vm, &t71); }); DPL_Value t68 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l6), 1); DPL_Value t69 = dpl_value_make_boolean(dplv_runtime_load_field_boolean(&vm, dplv_reference(&vm, l6), 2)); DPL_Value t70 = dpl_value_make_number(({ double t74 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l6), 3); double t75 = 10.0; t74 * t75; })); dplv_runtime_create_object_reuse(&vm, l6, 4, (DPL_Value[]){t67, t68, t69, t70}); });
+                            dplv_release(&vm, l6);
+                            t66;
+                        }); dplv_release(&vm, l0); l0 = dplv_reference(&vm, t65); t65; });
+                        (void)((l2 = ({ double t76 = l2; double t77 = 1.0; t76 + t77; })));
+                        DPL_Value t64 = dplv_reference(&vm, l6);
+                        dplv_release(&vm, l6);
+                        t64;
+                    }));
+                }
+                t63;
+            });
+            t62;
+        }));
+        dplv_release(&vm, ({ DPL_Value t78 = ({ DPL_Value t79 = ({ double t85 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 3); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t85)})); }); DPL_Value t80 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t81 = ({ DPL_Value t86 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l0), 0); double t87 = 1.0; (dplv_runtime_call_intrinsic(&vm, 9 /* element([T], Number): T */, 2, (DPL_Value[]){t86, dpl_value_make_number(t87)})); }); DPL_Value t82 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t83 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l0), 1); DPL_Value t84 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 6, (DPL_Value[]){t79, t80, t81, t82, t83, t84}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t78})); }));
+        DPL_Value l2 = dplv_reference(&vm, l0);
+        dplv_release(&vm, ({ DPL_Value t88 = ({
+            DPL_Value l3 = dplv_runtime_move(&l0);
+            DPL_Value t89 = ({ DPL_Value t90 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l3), 0); DPL_Value t91 = dpl_value_make_string(&vm.stack_pool, 7, "changed"); DPL_Value t92 = dpl_value_make_boolean(dplv_runtime_load_field_boolean(&vm, dplv_reference(&vm, l3), 2)); DPL_Value t93 = dpl_value_make_number(dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l3), 3)); dplv_runtime_create_object_reuse(&vm, l3, 4, (DPL_Value[]){t90, t91, t92, t93}); });
+            dplv_release(&vm, l3);
+            t89;
+        }); dplv_release(&vm, l0); l0 = dplv_reference(&vm, t88); t88; }));
+        dplv_release(&vm, ({ DPL_Value t94 = ({ DPL_Value t95 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l0), 1); DPL_Value t96 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t97 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l2), 1); DPL_Value t98 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 4, (DPL_Value[]){t95, t96, t97, t98}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t94})); }));
+        double l3 = 0.0; (void)l3;
+        DPL_Value l4 = ({
+            DPL_Value l4 = dplv_reference(&vm, l0);
+            DPL_Value t99 = ({ DPL_Value t100 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l4), 0); DPL_Value t101 = ({ DPL_Value t104 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l4), 1); DPL_Value t105 = dpl_value_make_string(&vm.stack_pool, 1, "!"); dplv_runtime_concat_string(&vm, t104, t105); }); DPL_Value t102 = dpl_value_make_boolean(dplv_runtime_load_field_boolean(&vm, dplv_reference(&vm, l4), 2)); DPL_Value t103 = dpl_value_make_number(({
+                (void)((l3 = ({ double t107 = l3; double t108 = 1.0; t107 + t108; })));
+                double t106 = l3;
+                t106;
+            })); dplv_runtime_create_object_reuse(&vm, l4, 4, (DPL_Value[]){t100, t101, t102, t103}); });
+            dplv_release(&vm, l4);
+            t99;
+        });
+        dplv_release(&vm, ({ DPL_Value t109 = ({ DPL_Value t110 = ({ double t116 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l4), 3); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t116)})); }); DPL_Value t111 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t112 = dplv_runtime_load_field(&vm, dplv_reference(&vm, l4), 1); DPL_Value t113 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t114 = ({ double t117 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 3); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t117)})); }); DPL_Value t115 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 6, (DPL_Value[]){t110, t111, t112, t113, t114, t115}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t109})); }));
+        DPL_Value l5 = ({ DPL_Value t118 = dpl_value_make_number(3.0); DPL_Value t119 = dpl_value_make_boolean(false); dpl_value_make_object(&vm.stack_pool, 2, (DPL_Value[]){t118, t119}); });
+        dplv_release(&vm, ({
+            DPL_Value l6 = dplv_reference(&vm, l5);
+            DPL_Value t120 = ({
+                DPL_Value t121 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (({ bool t122 = dplv_runtime_load_field_boolean(&vm, dplv_reference(&vm, l6), 1); !t122; }))
+                {
+                    dplv_release(&vm, ({
+                        double l8 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l6), 0); (void)l8;
+                        DPL_Value l9 = ({ DPL_Value t124 = ({ DPL_Value t125 = ({ double t127 = l8; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t127)})); }); DPL_Value t126 = dpl_value_make_string(&vm.stack_pool, 1, " "); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t125, t126}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t124})); });
+                        dplv_release(&vm, ({ DPL_Value t128 = ({ DPL_Value t129 = dplv_runtime_move(&l6); dpl_function_1(t129); }); dplv_release(&vm, l6); l6 = dplv_reference(&vm, t128); t128; }));
+                        DPL_Value t123 = dplv_reference(&vm, l9);
+                        dplv_release(&vm, l9);
+                        t123;
+                    }));
+                }
+                t121;
+            });
+            dplv_release(&vm, l6);
+            t120;
+        }));
+        DPL_Value t23 = ({ DPL_Value t130 = ({ DPL_Value t131 = ({ double t133 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l5), 0); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t133)})); }); DPL_Value t132 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t131, t132}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t130})); });
+        dplv_release(&vm, l0);
+        dplv_release(&vm, l1);
+        dplv_release(&vm, l2);
+        dplv_release(&vm, l4);
+        dplv_release(&vm, l5);
+        t23;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
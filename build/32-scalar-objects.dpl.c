@@ -0,0 +1,119 @@
+// Generated by dplc from ./tests/32-scalar-objects.dpl.
+
+#ifdef DPL_LEAKCHECK
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/runtime.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+static DPL_VirtualMachine vm = {0};
+
+static double dpl_function_0(DPL_Value l0);
+
+// length2
+static double dpl_function_0(DPL_Value l0)
+{
+    double result;
+    result = ({ double t0 = ({ double t2 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 0); double t3 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 0); t2 * t3; }); double t1 = ({ double t4 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 1); double t5 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l0), 1); t4 * t5; }); t0 + t1; });
+    dplv_release(&vm, l0);
+    return result;
+}
+
+int main(void)
+{
+    dplv_runtime_init(&vm);
+
+    dplv_release(&vm, ({
+        DPL_Value l0 = dpl_value_make_string(&vm.stack_pool, 7, "a point");
+        double l1 = 3.0; (void)l1;
+        double l2 = 4.0; (void)l2;
+        DPL_Value l3 = ({ DPL_Value t7 = dpl_value_make_number(({ double t9 = l1; double t10 = 1.0; t9 + t10; })); DPL_Value t8 = dpl_value_make_number(({ double t11 = l2; double t12 = 2.0; t11 * t12; })); dpl_value_make_object(&vm.stack_pool, 2, (DPL_Value[]){t7, t8}); });
+        dplv_release(&vm, ({ DPL_Value t13 = ({ DPL_Value t14 = dplv_reference(&vm, l0); DPL_Value t15 = dpl_value_make_string(&vm.stack_pool, 2, ": "); DPL_Value t16 = ({ double t22 = l1; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t22)})); }); DPL_Value t17 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t18 = ({ double t23 = l2; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t23)})); }); DPL_Value t19 = dpl_value_make_string(&vm.stack_pool, 4, " -> "); DPL_Value t20 = ({ double t24 = ({ DPL_Value t25 = dplv_reference(&vm, l3); dpl_function_0(t25); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t24)})); }); DPL_Value t21 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 8, (DPL_Value[]){t14, t15, t16, t17, t18, t19, t20, t21}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t13})); }));
+        double l4 = 2.0; (void)l4;
+        double l5 = 5.0; (void)l5;
+        double l6 = 0.0; (void)l6;
+        dplv_release(&vm, ({
+            double l7 = l4; (void)l7;
+            double l8 = l5; (void)l8;
+            DPL_Value t26 = ({
+                DPL_Value t27 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l7 > l8))
+                {
+                    (void)(({
+                        double l10 = l7; (void)l10;
+                        double l11 = (l6 = ({ double t29 = l6; double t30 = l10; t29 + t30; })); (void)l11;
+                        (void)((l7 = ({ double t31 = l7; double t32 = 1.0; t31 + t32; })));
+                        double t28 = l11;
+                        t28;
+                    }));
+                }
+                t27;
+            });
+            t26;
+        }));
+        dplv_release(&vm, ({ DPL_Value t33 = ({ DPL_Value t34 = ({ double t40 = l6; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t40)})); }); DPL_Value t35 = dpl_value_make_string(&vm.stack_pool, 1, " "); DPL_Value t36 = ({ double t41 = l4; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t41)})); }); DPL_Value t37 = dpl_value_make_string(&vm.stack_pool, 2, ".."); DPL_Value t38 = ({ double t42 = l5; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t42)})); }); DPL_Value t39 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 6, (DPL_Value[]){t34, t35, t36, t37, t38, t39}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t33})); }));
+        double l7 = 0.0; (void)l7;
+        dplv_release(&vm, ({
+            double l8 = 1.0; (void)l8;
+            double l9 = 4.0; (void)l9;
+            DPL_Value t43 = ({
+                DPL_Value t44 = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+                while (!(l8 > l9))
+                {
+                    dplv_release(&vm, ({
+                        double l11 = l8; (void)l11;
+                        DPL_Value l12 = ({
+                            DPL_Value l12 = ({ DPL_Value t47 = dpl_value_make_string(&vm.stack_pool, 5, "step "); DPL_Value t48 = ({ double t49 = l11; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t49)})); }); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t47, t48}); });
+                            double l13 = ({ double t50 = l11; double t51 = 10.0; t50 * t51; }); (void)l13;
+                            (void)((l7 = ({ double t52 = l7; double t53 = l13; t52 + t53; })));
+                            DPL_Value t46 = ({ DPL_Value t54 = ({ DPL_Value t55 = dplv_reference(&vm, l12); DPL_Value t56 = dpl_value_make_string(&vm.stack_pool, 1, " "); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t55, t56}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t54})); });
+                            dplv_release(&vm, l12);
+                            t46;
+                        });
+                        (void)((l8 = ({ double t57 = l8; double t58 = 1.0; t57 + t58; })));
+                        DPL_Value t45 = dplv_reference(&vm, l12);
+                        dplv_release(&vm, l12);
+                        t45;
+                    }));
+                }
+                t44;
+            });
+            t43;
+        }));
+        dplv_release(&vm, ({ DPL_Value t59 = ({ DPL_Value t60 = ({ double t62 = l7; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t62)})); }); DPL_Value t61 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t60, t61}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t59})); }));
+        DPL_Value l8 = ({ DPL_Value t63 = dpl_value_make_number(1.0); DPL_Value t64 = dpl_value_make_number(2.0); dpl_value_make_object(&vm.stack_pool, 2, (DPL_Value[]){t63, t64}); });
+        DPL_Value l9 = dplv_reference(&vm, l8);
+        dplv_release(&vm, ({ DPL_Value t65 = ({ DPL_Value t66 = ({ double t68 = ({ DPL_Value t69 = dplv_reference(&vm, l9); dpl_function_0(t69); }); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t68)})); }); DPL_Value t67 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t66, t67}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t65})); }));
+        DPL_Value l10 = ({ DPL_Value t70 = dpl_value_make_number(5.0); DPL_Value t71 = dpl_value_make_number(6.0); dpl_value_make_object(&vm.stack_pool, 2, (DPL_Value[]){t70, t71}); });
+        dplv_release(&vm, ({
+            double l11 = 7.0; (void)l11;
+            DPL_Value t72 = ({ DPL_Value t73 = ({ DPL_Value t74 = ({ double t76 = l11; (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t76)})); }); DPL_Value t75 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t74, t75}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t73})); });
+            t72;
+        }));
+        DPL_Value t6 = ({ DPL_Value t77 = ({ DPL_Value t78 = ({ double t80 = dplv_runtime_load_field_number(&vm, dplv_reference(&vm, l10), 0); (dplv_runtime_call_intrinsic(&vm, 3 /* toString(Number): String */, 1, (DPL_Value[]){dpl_value_make_number(t80)})); }); DPL_Value t79 = dpl_value_make_string(&vm.stack_pool, 1, "\n"); dplv_runtime_interpolation(&vm, 2, (DPL_Value[]){t78, t79}); }); (dplv_runtime_call_intrinsic(&vm, 7 /* print(String): String */, 1, (DPL_Value[]){t77})); });
+        dplv_release(&vm, l0);
+        dplv_release(&vm, l3);
+        dplv_release(&vm, l8);
+        dplv_release(&vm, l9);
+        dplv_release(&vm, l10);
+        t6;
+    }));
+    dplv_runtime_free(&vm);
+
+#ifdef DPL_LEAKCHECK
+    stb_leakcheck_dumpmem();
+#endif
+
+    return 0;
+}
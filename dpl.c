@@ -5,6 +5,7 @@
 
 #include <dw_error.h>
 #include <dpl/value.h>
+#include <dpl/vm/jit.h>
 #include <dpl/vm/vm.h>
 
 #define ARENA_IMPLEMENTATION
@@ -19,7 +20,37 @@
 
 void usage(const char *program)
 {
-    DW_ERROR("Usage: %s [-d] [-t] program.dplp", program);
+    DW_ERROR_MSGLN("Usage: %s [-d] [-t] [-p] [-s size] [-S size] [-c size] [-C size] [--jit] [--jit-threshold count] [--release-budget count] program.dplp", program);
+    DW_ERROR_MSGLN("  -d       Print debug information after execution.");
+    DW_ERROR_MSGLN("  -t       Trace the execution step by step.");
+    DW_ERROR_MSGLN("  -p       Print the frequencies of executed instruction pairs.");
+    DW_ERROR_MSGLN("  -s size  Initial size of the value stack (default: %zu).", (size_t)DPLV_STACK_CAPACITY);
+    DW_ERROR_MSGLN("  -S size  Maximum size of the value stack (default: %zu).", (size_t)DPLV_STACK_MAX_CAPACITY);
+    DW_ERROR_MSGLN("  -c size  Initial size of the callstack (default: %zu).", (size_t)DPLV_CALLSTACK_CAPACITY);
+    DW_ERROR_MSGLN("  -C size  Maximum size of the callstack (default: %zu).", (size_t)DPLV_CALLSTACK_MAX_CAPACITY);
+    DW_ERROR_MSGLN("  --jit    Compile hot numeric functions to machine code (x86-64 Linux only).");
+    DW_ERROR_MSGLN("  --jit-threshold count  Calls before a function is compiled (default: %d).", DPLV_JIT_THRESHOLD);
+    DW_ERROR("  --release-budget count  Objects and arrays freed per release (default: all).");
+}
+
+size_t parse_size(const char *program, const char *flag, int *argc, char ***argv)
+{
+    if (*argc == 0)
+    {
+        DW_ERROR_MSGLN("ERROR: No size given for flag `%s`.", flag);
+        usage(program);
+    }
+
+    const char *arg = nob_shift_args(argc, argv);
+    char *end = NULL;
+    unsigned long long size = strtoull(arg, &end, 10);
+    if (*arg == '\0' || *end != '\0' || size == 0)
+    {
+        DW_ERROR_MSGLN("ERROR: Invalid size `%s` for flag `%s`.", arg, flag);
+        usage(program);
+    }
+
+    return size;
 }
 
 int main(int argc, char **argv)
@@ -40,6 +71,38 @@ int main(int argc, char **argv)
         {
             vm.trace = true;
         }
+        else if (strcmp(arg, "-p") == 0)
+        {
+            vm.profile = true;
+        }
+        else if (strcmp(arg, "-s") == 0)
+        {
+            vm.stack_capacity = parse_size(exe, arg, &argc, &argv);
+        }
+        else if (strcmp(arg, "-S") == 0)
+        {
+            vm.stack_max_capacity = parse_size(exe, arg, &argc, &argv);
+        }
+        else if (strcmp(arg, "-c") == 0)
+        {
+            vm.callstack_capacity = parse_size(exe, arg, &argc, &argv);
+        }
+        else if (strcmp(arg, "-C") == 0)
+        {
+            vm.callstack_max_capacity = parse_size(exe, arg, &argc, &argv);
+        }
+        else if (strcmp(arg, "--jit") == 0)
+        {
+            vm.jit = true;
+        }
+        else if (strcmp(arg, "--jit-threshold") == 0)
+        {
+            vm.jit_threshold = parse_size(exe, arg, &argc, &argv);
+        }
+        else if (strcmp(arg, "--release-budget") == 0)
+        {
+            vm.release_budget = parse_size(exe, arg, &argc, &argv);
+        }
         else
         {
             program_filename = arg;
@@ -52,12 +115,25 @@ int main(int argc, char **argv)
         usage(exe);
     }
 
+    if (vm.jit && !dplv_jit_supported())
+    {
+        DW_ERROR_MSGLN("WARNING: The JIT is not supported on this platform, running interpreted.");
+    }
+
     DPL_Program program = {0};
-    dplp_load(&program, program_filename);
+    if (!dplp_load(&program, program_filename))
+    {
+        DW_ERROR("ERROR: Cannot load program file `%s`.", program_filename);
+    }
 
     dplv_init(&vm, &program);
     dplv_run(&vm);
 
+    if (vm.profile)
+    {
+        dplv_print_profile(&vm);
+    }
+
     if (vm.debug)
     {
         printf("\n================================================================\n");
@@ -18,7 +18,7 @@
 
 void usage(const char *program)
 {
-    DW_ERROR("Usage: %s [-d] [-o output_file] source.dpl", program);
+    DW_ERROR("Usage: %s [-d] [--emit-c] [-o output_file] source.dpl", program);
 }
 
 int main(int argc, char **argv)
@@ -32,6 +32,7 @@ int main(int argc, char **argv)
 
     const char *source_filename = NULL;
     const char *output_filename = NULL;
+    bool emit_c = false;
     while (argc > 0)
     {
         char *arg = nob_shift_args(&argc, &argv);
@@ -39,6 +40,10 @@ int main(int argc, char **argv)
         {
             dpl.debug = true;
         }
+        else if (strcmp(arg, "--emit-c") == 0)
+        {
+            emit_c = true;
+        }
         else if (strcmp(arg, "-o") == 0)
         {
             if (argc == 0)
@@ -73,7 +78,7 @@ int main(int argc, char **argv)
             nob_sb_append_cstr(&output_filename_sb, source_filename);
             nob_sb_append_cstr(&output_filename_sb, ".");
         }
-        nob_sb_append_cstr(&output_filename_sb, "dplp");
+        nob_sb_append_cstr(&output_filename_sb, emit_c ? "c" : "dplp");
         nob_sb_append_null(&output_filename_sb);
     }
     else
@@ -90,13 +95,26 @@ int main(int argc, char **argv)
 
     dpl_init(&dpl);
 
-    DPL_Program compiled_program = {0};
-    dplp_init(&compiled_program);
-    dpl_compile(&dpl, &compiled_program);
-    dplp_save(&compiled_program, output_filename_sb.items);
+    if (emit_c)
+    {
+        Nob_String_Builder c_source = {0};
+        dpl_compile_to_c(&dpl, &c_source);
+        if (!nob_write_entire_file(output_filename_sb.items, c_source.items, c_source.count))
+        {
+            DW_ERROR("Could not write C source file `%s`.", output_filename_sb.items);
+        }
+        nob_sb_free(c_source);
+    }
+    else
+    {
+        DPL_Program compiled_program = {0};
+        dplp_init(&compiled_program);
+        dpl_compile(&dpl, &compiled_program);
+        dplp_save(&compiled_program, output_filename_sb.items);
+        dplp_free(&compiled_program);
+    }
     nob_sb_free(output_filename_sb);
 
-    dplp_free(&compiled_program);
     dpl_free(&dpl);
     nob_da_free(source);
 
@@ -43,7 +43,11 @@ int main(int argc, char** argv)
 
     nob_log(NOB_INFO, "Loading program file %s.\n", program_to_run);
     DPL_Program program = {0};
-    dplp_load(&program, program_to_run);
+    if (!dplp_load(&program, program_to_run))
+    {
+        nob_log(NOB_ERROR, "Cannot load program file %s.\n", program_to_run);
+        return 1;
+    }
 
     DPL_VirtualMachine vm = {0};
     dplv_init(&vm, &program);
@@ -29,5 +29,7 @@ void dpl_init(DPL *dpl);
 void dpl_free(DPL *dpl);
 
 void dpl_compile(DPL *dpl, DPL_Program *program);
+// Translates the program into C source code instead of bytecode.
+void dpl_compile_to_c(DPL *dpl, Nob_String_Builder *output);
 
 #endif // __DPL_H
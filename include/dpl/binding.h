@@ -27,6 +27,7 @@ typedef enum
     BOUND_NODE_LOAD_FIELD,
     BOUND_NODE_INTERPOLATION,
     BOUND_NODE_SPREAD,
+    BOUND_NODE_ITERATE,
 
     COUNT_BOUND_NODE_KINDS,
 } DPL_BoundNodeKind;
@@ -43,6 +44,12 @@ typedef struct
 {
     size_t field_count;
     DPL_Bound_ObjectField *fields;
+    // Reference to a local holding an object of the same type that is not used
+    // once this object is created, or NULL. Its memory may be reused.
+    DPL_Bound_Node *reuse;
+    // Set on the initializer of a variable whose object does not escape. Its
+    // fields are kept in consecutive locals and no object is created.
+    bool scalar;
 } DPL_Bound_Object;
 
 typedef struct
@@ -103,11 +110,29 @@ typedef struct
     size_t expressions_count;
 } DPL_Bound_Interpolation;
 
+typedef enum
+{
+    ITERATE_RANGE,
+    ITERATE_ARRAY,
+} DPL_Bound_IterateKind;
+
+// Condition of a counted for loop. For ranges, the slot at `scope_index` holds
+// the current number and the next one the upper bound. For arrays, it holds
+// the array and the next one the current index.
+typedef struct
+{
+    DPL_Bound_IterateKind kind;
+    size_t scope_index;
+} DPL_Bound_Iterate;
+
 struct DPL_Bound_Node
 {
     DPL_BoundNodeKind kind;
     DPL_Symbol *type;
     bool persistent;
+    // Set on a VARREF or ARGREF that is the last read of its local before the
+    // local is assigned again or goes away. The reference is moved out of it.
+    bool move;
     union
     {
         DPL_Symbol_Constant value;
@@ -124,6 +149,7 @@ struct DPL_Bound_Node
         DPL_Bound_LoadField load_field;
         DPL_Bound_Interpolation interpolation;
         DPL_Bound_Node *spread;
+        DPL_Bound_Iterate iterate;
     } as;
 };
 
@@ -147,6 +173,10 @@ typedef struct
 typedef  struct
 {
     size_t assignment_count;
+    // The expression of the scope that is currently bound, and the ones after it.
+    DPL_Ast_Node *current;
+    DPL_Ast_Node **following;
+    size_t following_count;
 } DPL_Binding_ScopeInfo;
 
 typedef struct
@@ -0,0 +1,13 @@
+#ifndef __DPL_EMITTER_H
+#define __DPL_EMITTER_H
+
+#include <dpl/binding.h>
+
+// Translates a bound program into a standalone C translation unit that links
+// against the value and VM sources (see dpl/vm/runtime.h). Numbers and
+// booleans are kept in C doubles and bools, user functions become C
+// functions. The emitted code uses GCC statement expressions.
+void dpl_emit_c(DPL_Binding_UserFunctions user_functions, DPL_Bound_Node *root, Nob_String_View file_name,
+                Nob_String_Builder *output);
+
+#endif // __DPL_EMITTER_H
@@ -0,0 +1,11 @@
+#ifndef __DPL_FUSION_H
+#define __DPL_FUSION_H
+
+#include <dpl/program.h>
+
+// Rewrites common instruction sequences in the program code into single
+// superinstructions. Jumps, user function calls and the program entry are
+// relocated accordingly. Sequences are never fused across jump targets.
+void dpl_fuse(DPL_Program *program);
+
+#endif // __DPL_FUSION_H
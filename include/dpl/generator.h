@@ -10,5 +10,6 @@ typedef struct
 } DPL_Generator;
 
 void dpl_generate(DPL_Generator *generator, DPL_Bound_Node *node, DPL_Program *program);
+void dpl_generate_function(DPL_Generator *generator, DPL_Binding_UserFunction *function, DPL_Program *program);
 
 #endif // __DPL_GENERATOR_H
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef __DPL_INTRINSICS_H
 #define __DPL_INTRINSICS_H
 
+#include <stddef.h>
+
 typedef enum
 {
     INTRINSIC_BOOLEAN_PRINT,
@@ -20,9 +22,18 @@ typedef enum
 
     INTRINSIC_ARRAYITERATOR_NEXT,
 
+    INTRINSIC_NUMBERARRAY_SUM,
+    INTRINSIC_NUMBERARRAY_MIN,
+    INTRINSIC_NUMBERARRAY_MAX,
+    INTRINSIC_NUMBERARRAY_DOT,
+    INTRINSIC_NUMBERARRAY_SCALE,
+    INTRINSIC_NUMBERARRAY_ADD,
+    INTRINSIC_NUMBERARRAY_MULTIPLY,
+
     COUNT_INTRINSICS,
 } DPL_Intrinsic_Kind;
 
 const char *dpl_intrinsic_kind_name(DPL_Intrinsic_Kind kind);
+size_t dpl_intrinsic_kind_arity(DPL_Intrinsic_Kind kind);
 
 #endif // __DPL_INTRINSICS_H
\ No newline at end of file
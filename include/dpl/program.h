@@ -9,6 +9,9 @@
 #include <dpl/value.h>
 #include <dpl/intrinsics.h>
 
+// Version of the bytecode format written to and expected in program files.
+#define DPL_PROGRAM_VERSION 6
+
 typedef enum
 {
     INST_NOOP,
@@ -18,7 +21,7 @@ typedef enum
     INST_POP,
     INST_NEGATE,
     INST_NOT,
-    INST_ADD,
+    INST_ADD_NUMBER,
     INST_SUBTRACT,
     INST_MULTIPLY,
     INST_DIVIDE,
@@ -26,10 +29,16 @@ typedef enum
     INST_LESS_EQUAL,
     INST_GREATER,
     INST_GREATER_EQUAL,
-    INST_EQUAL,
-    INST_NOT_EQUAL,
+    INST_EQUAL_NUMBER,
+    INST_NOT_EQUAL_NUMBER,
+    INST_EQUAL_STRING,
+    INST_NOT_EQUAL_STRING,
+    INST_EQUAL_BOOLEAN,
+    INST_NOT_EQUAL_BOOLEAN,
+    INST_CONCAT_STRING,
     INST_CALL_INTRINSIC,
     INST_CALL_USER,
+    INST_TAIL_CALL_USER,
     INST_PUSH_LOCAL,
     INST_STORE_LOCAL,
     INST_POP_SCOPE,
@@ -45,6 +54,23 @@ typedef enum
     INST_END_ARRAY,
     INST_CONCAT_ARRAY,
     INST_SPREAD,
+    INST_ITERATE_RANGE,
+    INST_ITERATE_ARRAY,
+    INST_APPEND_LOCAL,
+    INST_EXTEND_ARRAY,
+    INST_LOAD_FIELD_NUMBER,
+    INST_LOAD_FIELD_BOOLEAN,
+    INST_PUSH_LOCAL_MOVE,
+    INST_CREATE_OBJECT_REUSE,
+
+    // Superinstructions, only created by dpl_fuse
+    INST_ADD_LOCAL_NUMBER,
+    INST_LOAD_LOCAL_FIELD,
+    INST_LOAD_LOCAL_FIELD_NUMBER,
+    INST_LOAD_LOCAL_FIELD_BOOLEAN,
+    INST_LESS_JUMP_IF_FALSE,
+
+    COUNT_INSTRUCTIONS,
 } DPL_Instruction_Kind;
 
 typedef struct
@@ -60,6 +86,20 @@ typedef struct
     size_t capacity;
 } DPL_Constants_Dictionary;
 
+typedef struct
+{
+    uint64_t begin_ip;
+    size_t arity;
+    size_t max_stack_depth;
+} DPL_Program_Function;
+
+typedef struct
+{
+    DPL_Program_Function *items;
+    size_t count;
+    size_t capacity;
+} DPL_Program_Functions;
+
 typedef struct
 {
     uint8_t version;
@@ -69,6 +109,10 @@ typedef struct
     DW_ByteBuffer constants;
 
     DPL_Constants_Dictionary constants_dictionary;
+
+    // Filled in by dplp_verify. The first function is the program entry.
+    bool verified;
+    DPL_Program_Functions functions;
 } DPL_Program;
 
 void dplp_init(DPL_Program *program);
@@ -82,21 +126,31 @@ void dplp_write_push_number(DPL_Program *program, double value);
 void dplp_write_push_string(DPL_Program *program, const char *value);
 void dplp_write_push_boolean(DPL_Program *program, bool value);
 void dplp_write_push_local(DPL_Program *program, size_t scope_index);
+// Pushes the value of a local that is not read again before it is assigned,
+// taking over its reference instead of adding one.
+void dplp_write_push_local_move(DPL_Program *program, size_t scope_index);
 void dplp_write_pop(DPL_Program *program);
 void dplp_write_pop_scope(DPL_Program *program, size_t n);
 
 void dplp_write_create_object(DPL_Program *program, size_t field_count);
+// Creates an object like dplp_write_create_object. The object in the local at
+// `scope_index` is not used afterwards, so its memory may be reused.
+void dplp_write_create_object_reuse(DPL_Program *program, size_t field_count, size_t scope_index);
 void dplp_write_load_field(DPL_Program *program, size_t field_index);
+// Loads a field whose static type is Number or Boolean without boxing it.
+void dplp_write_load_field_number(DPL_Program *program, size_t field_index);
+void dplp_write_load_field_boolean(DPL_Program *program, size_t field_index);
 
 void dplp_write_negate(DPL_Program *program);
 
-void dplp_write_add(DPL_Program *program);
+void dplp_write_add_number(DPL_Program *program);
 void dplp_write_subtract(DPL_Program *program);
 void dplp_write_multiply(DPL_Program *program);
 void dplp_write_divide(DPL_Program *program);
 
 void dplp_write_call_intrinsic(DPL_Program *program, DPL_Intrinsic_Kind intrinsic);
 void dplp_write_call_user(DPL_Program *program, size_t arity, size_t ip_begin);
+void dplp_write_tail_call_user(DPL_Program *program, size_t arity, size_t ip_begin);
 void dplp_write_return(DPL_Program *program);
 
 void dplp_write_store_local(DPL_Program *program, size_t scope_index);
@@ -112,7 +166,14 @@ void dplp_write_end_array(DPL_Program *program);
 void dplp_write_concat_array(DPL_Program *program);
 void dplp_write_spread(DPL_Program *program);
 
+void dplp_write_iterate_range(DPL_Program *program, size_t scope_index);
+void dplp_write_iterate_array(DPL_Program *program, size_t scope_index);
+
+void dplp_write_append_local(DPL_Program *program, size_t scope_index);
+void dplp_write_extend_array(DPL_Program *program, size_t before_count, size_t after_count);
+
 const char *dplp_inst_kind_name(DPL_Instruction_Kind kind);
+size_t dplp_inst_operand_size(DPL_Instruction_Kind kind);
 
 void dplp_print_escaped_string(const char *value, size_t length);
 void dplp_print_stream_instruction(DW_ByteStream *code, DW_ByteStream *constants);
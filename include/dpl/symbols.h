@@ -152,6 +152,9 @@ typedef struct
 {
     DPL_Symbol *type;
     size_t scope_index;
+    // The object of a scalar variable is never created. Its fields are kept in
+    // the locals starting at `scope_index`.
+    bool scalar;
 } DPL_Symbol_Var;
 
 // Functions
@@ -21,8 +21,77 @@ typedef enum
     VALUE_ARRAY,
 } DPL_ValueKind;
 
+// Element layout of arrays. Arrays of numbers and booleans store the raw
+// doubles and bools instead of full values. Large arrays store their elements
+// in a persistent trie (see DPL_ArrayTrie).
+typedef enum
+{
+    ARRAY_STORAGE_VALUES,
+    ARRAY_STORAGE_NUMBERS,
+    ARRAY_STORAGE_BOOLEANS,
+    ARRAY_STORAGE_TRIE,
+} DPL_ArrayStorage;
+
+// Arrays created with more elements than this are stored as tries.
+#define DPL_ARRAY_TRIE_THRESHOLD 256
+#define DPL_ARRAY_TRIE_BITS 5
+#define DPL_ARRAY_TRIE_BRANCHING (1 << DPL_ARRAY_TRIE_BITS)
+
+// Data of an array with ARRAY_STORAGE_TRIE. The nodes are arrays of
+// DPL_ARRAY_TRIE_BRANCHING slots: Inner nodes hold their children, leaves hold
+// the elements in the layout given by `element_storage`. Unused slots contain
+// the number 0. The elements start at position `origin`, so elements can be
+// added at both ends. Tries share their nodes, so adding an element only
+// copies the nodes on the path to its leaf.
+typedef struct
+{
+    uint32_t count;
+    // Bit shift of the position for selecting a child of the root (0 if the
+    // root is a leaf).
+    uint8_t shift;
+    uint8_t element_storage;
+    uint64_t origin;
+    struct __DPL_MemoryValue *root;
+} DPL_ArrayTrie;
+
+// Objects store their fields packed according to a shape: Numbers are stored
+// as raw doubles, booleans as single bytes and all other values as DPL_Value
+// (see DPL_ArrayStorage). The data of an object starts with a pointer to its
+// shape, followed by the fields at the offsets given there. Shapes are created
+// once per pool for each sequence of field storages and never freed.
+typedef struct
+{
+    uint8_t storage;
+    uint32_t offset;
+} DPL_ObjectShapeField;
+
+typedef struct __DPL_ObjectShape
+{
+    uint32_t field_count;
+    // Number of fields stored as DPL_Value, which may hold references.
+    uint32_t value_field_count;
+    uint32_t size;
+    // Storages of the first 32 fields, two bits each.
+    uint64_t signature;
+    struct __DPL_ObjectShape *next;
+    DPL_ObjectShapeField fields[];
+} DPL_ObjectShape;
+
+#define DPL_MEMORYVALUE_POOL_SHAPE_BUCKETS 64
+
 #define DPL_MEMORYVALUE_POOL_MAX_CAPACITY ((size_t)2 << 32)
 
+// Freed items are kept in one bin per power-of-two capacity.
+#define DPL_MEMORYVALUE_POOL_MIN_SIZE_CLASS 3
+#define DPL_MEMORYVALUE_POOL_SIZE_CLASSES 34
+
+// With DPL_MEMORYVALUE_POOL_TRACKING, the pool keeps a list of all allocated
+// items for printing and inspection in the debugger. IDs and leak checking
+// imply tracking.
+#if !defined(DPL_MEMORYVALUE_POOL_TRACKING) && (defined(DPL_MEMORYVALUE_POOL_IDS) || defined(DPL_LEAKCHECK))
+#define DPL_MEMORYVALUE_POOL_TRACKING
+#endif
+
 typedef struct __DPL_MemoryValue
 {
 #ifdef DPL_MEMORYVALUE_POOL_IDS
@@ -30,10 +99,20 @@ typedef struct __DPL_MemoryValue
 #endif
     uint32_t capacity;
     uint32_t size;
-    uint8_t ref_count;
+    uint32_t ref_count;
+    uint8_t size_class;
+    // Immortal items live outside of the pool and ignore reference counting.
+    bool immortal;
+    // Only used by arrays (see DPL_ArrayStorage).
+    uint8_t storage;
     DPL_ValueKind kind;
+    // Cached result of dpl_value_hash, or 0 if not computed yet. Operations
+    // that change an item in place reset it.
+    uint32_t hash;
     struct __DPL_MemoryValue* next;
+#ifdef DPL_MEMORYVALUE_POOL_TRACKING
     struct __DPL_MemoryValue* prev;
+#endif
     uint8_t data[];
 } DPL_MemoryValue;
 
@@ -43,10 +122,14 @@ typedef struct
 #ifdef DPL_MEMORYVALUE_POOL_IDS
     uint64_t next_id;
 #endif
+#ifdef DPL_MEMORYVALUE_POOL_TRACKING
     DPL_MemoryValue* allocated;
-    DPL_MemoryValue* freed;
+#endif
+    DPL_MemoryValue* freed[DPL_MEMORYVALUE_POOL_SIZE_CLASSES];
+    DPL_ObjectShape* shapes[DPL_MEMORYVALUE_POOL_SHAPE_BUCKETS];
 } DPL_MemoryValue_Pool;
 
+// The data of the returned item is not initialized.
 DPL_MemoryValue* dpl_value_pool_allocate_item(DPL_MemoryValue_Pool* pool, const size_t size);
 void dpl_value_pool_acquire_item(const DPL_MemoryValue_Pool* pool, DPL_MemoryValue* item);
 void dpl_value_pool_release_item(DPL_MemoryValue_Pool* pool, DPL_MemoryValue* item);
@@ -56,49 +139,331 @@ void dpl_value_pool_free_item(DPL_MemoryValue_Pool* pool, DPL_MemoryValue* item)
 void dpl_value_pool_print(const DPL_MemoryValue_Pool* pool);
 void dpl_value_pool_free(DPL_MemoryValue_Pool* pool);
 
+// Strings of up to DPL_VALUE_SMALL_STRING_CAPACITY bytes are stored inline in
+// the value under this internal kind. dpl_value_kind reports them as
+// VALUE_STRING, but they have no DPL_MemoryValue and are not reference counted.
+#define DPL_VALUE_SMALL_STRING (VALUE_ARRAY + 1)
+
+#ifdef DPL_VALUE_NANBOX
+
+// NaN-boxed value layout (enabled by defining DPL_VALUE_NANBOX): Every value
+// is stored in 8 bytes. Numbers are plain IEEE-754 doubles. All other kinds
+// live in the payload of negative quiet NaNs whose upper 16 bits encode the
+// kind (0xFFF8 + kind, never colliding with the canonical NaN 0xFFF8). The
+// lower 48 bits hold either a boolean or a pointer to a DPL_MemoryValue.
+// Small strings use their own tag and keep their length in bits 40-47 and
+// their characters in the lower bytes of the payload (little endian).
 typedef struct
 {
-    DPL_ValueKind kind;
-    union
+    uint64_t bits;
+} DPL_Value;
+
+#define DPL_VALUE_SMALL_STRING_CAPACITY 5
+#define DPL_VALUE_SMALL_STRING_LENGTH_SHIFT 40
+
+#define DPL_VALUE_NANBOX_TAG_SHIFT 48
+#define DPL_VALUE_NANBOX_TAG_BASE ((uint64_t)0xFFF8)
+#define DPL_VALUE_NANBOX_PAYLOAD_MASK (((uint64_t)1 << DPL_VALUE_NANBOX_TAG_SHIFT) - 1)
+#define DPL_VALUE_NANBOX_CANONICAL_NAN ((uint64_t)0x7FF8000000000000)
+
+static inline DPL_Value dpl_value__box(DPL_ValueKind kind, uint64_t payload)
+{
+    return (DPL_Value) {
+        .bits = ((DPL_VALUE_NANBOX_TAG_BASE + kind) << DPL_VALUE_NANBOX_TAG_SHIFT) | payload,
+    };
+}
+
+static inline DPL_ValueKind dpl_value_kind(DPL_Value value)
+{
+    const uint64_t tag = value.bits >> DPL_VALUE_NANBOX_TAG_SHIFT;
+    if (tag > DPL_VALUE_NANBOX_TAG_BASE && tag <= DPL_VALUE_NANBOX_TAG_BASE + VALUE_ARRAY)
     {
-        double number;
-        DPL_MemoryValue *string;
-        bool boolean;
-        DPL_MemoryValue *object;
-        DPL_MemoryValue *array;
-    } as;
+        return tag - DPL_VALUE_NANBOX_TAG_BASE;
+    }
+    if (tag == DPL_VALUE_NANBOX_TAG_BASE + DPL_VALUE_SMALL_STRING)
+    {
+        return VALUE_STRING;
+    }
+    return VALUE_NUMBER;
+}
+
+static inline bool dpl_value_is_small_string(DPL_Value value)
+{
+    return (value.bits >> DPL_VALUE_NANBOX_TAG_SHIFT) == DPL_VALUE_NANBOX_TAG_BASE + DPL_VALUE_SMALL_STRING;
+}
+
+static inline DPL_Value dpl_value_make_number(double value)
+{
+    DPL_Value result;
+    if (value != value)
+    {
+        result.bits = DPL_VALUE_NANBOX_CANONICAL_NAN;
+    }
+    else
+    {
+        memcpy(&result.bits, &value, sizeof(value));
+    }
+    return result;
+}
+
+static inline DPL_Value dpl_value_make_boolean(bool value)
+{
+    return dpl_value__box(VALUE_BOOLEAN, value ? 1 : 0);
+}
+
+static inline DPL_Value dpl_value_make_item(DPL_ValueKind kind, DPL_MemoryValue *item)
+{
+    return dpl_value__box(kind, (uintptr_t)item);
+}
+
+static inline double dpl_value_as_number(DPL_Value value)
+{
+    double result;
+    memcpy(&result, &value.bits, sizeof(result));
+    return result;
+}
+
+static inline bool dpl_value_as_boolean(DPL_Value value)
+{
+    return (value.bits & DPL_VALUE_NANBOX_PAYLOAD_MASK) != 0;
+}
+
+static inline DPL_MemoryValue *dpl_value_as_item(DPL_Value value)
+{
+    return (DPL_MemoryValue *)(uintptr_t)(value.bits & DPL_VALUE_NANBOX_PAYLOAD_MASK);
+}
+
+static inline DPL_Value dpl_value__make_small_string(const size_t length, const char *data)
+{
+    uint64_t payload = (uint64_t)length << DPL_VALUE_SMALL_STRING_LENGTH_SHIFT;
+    for (size_t i = 0; i < length; ++i)
+    {
+        payload |= (uint64_t)(uint8_t)data[i] << (8 * i);
+    }
+    return dpl_value__box(DPL_VALUE_SMALL_STRING, payload);
+}
+
+static inline size_t dpl_value__small_string_length(const DPL_Value *value)
+{
+    return (value->bits >> DPL_VALUE_SMALL_STRING_LENGTH_SHIFT) & 0xFF;
+}
+
+static inline const char *dpl_value__small_string_data(const DPL_Value *value)
+{
+    return (const char *)&value->bits;
+}
+
+#else
+
+#define DPL_VALUE_SMALL_STRING_CAPACITY 14
+
+// Small strings overlay the whole value after its kind byte.
+typedef union
+{
+    struct
+    {
+        uint8_t kind;
+        union
+        {
+            double number;
+            DPL_MemoryValue *string;
+            bool boolean;
+            DPL_MemoryValue *object;
+            DPL_MemoryValue *array;
+        } as;
+    };
+    struct
+    {
+        uint8_t kind;
+        uint8_t length;
+        char data[DPL_VALUE_SMALL_STRING_CAPACITY];
+    } small;
 } DPL_Value;
 
+static inline DPL_ValueKind dpl_value_kind(DPL_Value value)
+{
+    return (value.kind == DPL_VALUE_SMALL_STRING) ? VALUE_STRING : value.kind;
+}
+
+static inline bool dpl_value_is_small_string(DPL_Value value)
+{
+    return value.kind == DPL_VALUE_SMALL_STRING;
+}
+
+static inline DPL_Value dpl_value_make_number(double value)
+{
+    return (DPL_Value) {
+        .kind = VALUE_NUMBER,
+        .as.number = value,
+    };
+}
+
+static inline DPL_Value dpl_value_make_boolean(bool value)
+{
+    return (DPL_Value) {
+        .kind = VALUE_BOOLEAN,
+        .as.boolean = value,
+    };
+}
+
+static inline DPL_Value dpl_value_make_item(DPL_ValueKind kind, DPL_MemoryValue *item)
+{
+    return (DPL_Value) {
+        .kind = kind,
+        .as.object = item,
+    };
+}
+
+static inline double dpl_value_as_number(DPL_Value value)
+{
+    return value.as.number;
+}
+
+static inline bool dpl_value_as_boolean(DPL_Value value)
+{
+    return value.as.boolean;
+}
+
+static inline DPL_MemoryValue *dpl_value_as_item(DPL_Value value)
+{
+    return value.as.object;
+}
+
+static inline DPL_Value dpl_value__make_small_string(const size_t length, const char *data)
+{
+    DPL_Value result = {.small = {.kind = DPL_VALUE_SMALL_STRING, .length = length}};
+    memcpy(result.small.data, data, length);
+    return result;
+}
+
+static inline size_t dpl_value__small_string_length(const DPL_Value *value)
+{
+    return value->small.length;
+}
+
+static inline const char *dpl_value__small_string_data(const DPL_Value *value)
+{
+    return value->small.data;
+}
+
+#endif // DPL_VALUE_NANBOX
+
+// Only valid for strings that are not small.
+static inline DPL_MemoryValue *dpl_value_as_string(DPL_Value value)
+{
+    return dpl_value_as_item(value);
+}
+
+static inline DPL_MemoryValue *dpl_value_as_object(DPL_Value value)
+{
+    return dpl_value_as_item(value);
+}
+
+static inline DPL_MemoryValue *dpl_value_as_array(DPL_Value value)
+{
+    return dpl_value_as_item(value);
+}
+
+// Whether the value references a DPL_MemoryValue that is reference counted.
+static inline bool dpl_value_is_item(DPL_Value value)
+{
+    const DPL_ValueKind kind = dpl_value_kind(value);
+    return (kind == VALUE_STRING && !dpl_value_is_small_string(value)) || kind == VALUE_OBJECT || kind == VALUE_ARRAY;
+}
+
+// Characters of a string value. For small strings they are stored in `*value`
+// itself, so the view is only valid as long as `*value` is.
+static inline Nob_String_View dpl_value_string_sv(const DPL_Value *value)
+{
+    if (dpl_value_is_small_string(*value))
+    {
+        return nob_sv_from_parts(dpl_value__small_string_data(value), dpl_value__small_string_length(value));
+    }
+    const DPL_MemoryValue *string = dpl_value_as_string(*value);
+    return nob_sv_from_parts((const char *)string->data, string->size);
+}
+
 const char *dpl_value_kind_name(DPL_ValueKind kind);
 DPL_Value dpl_value_pool_item_to_value(DPL_MemoryValue *item);
 
-DPL_Value dpl_value_make_number(double value);
 int dpl_value_compare_numbers(double a, double b);
 const char *dpl_value_format_number(double value);
 
+// Strings of up to DPL_VALUE_SMALL_STRING_CAPACITY bytes are created small.
 DPL_Value dpl_value_make_string(DPL_MemoryValue_Pool* pool, const size_t length, const char* data);
+DPL_Value dpl_value_make_string_concat(DPL_MemoryValue_Pool* pool, DPL_Value string1, DPL_Value string2);
+DPL_Value dpl_value_make_string_join(DPL_MemoryValue_Pool* pool, const size_t count, const DPL_Value* strings);
+// Appends to a uniquely referenced string, in place as long as its capacity
+// suffices (see dpl_value_array_append).
+DPL_Value dpl_value_string_append(DPL_MemoryValue_Pool* pool, DPL_MemoryValue* string, const size_t length, const char* data);
+// Creates an immortal string in `memory` that stays valid until the arena is
+// freed. Short strings are created small instead.
+DPL_Value dpl_value_make_constant_string(Arena* memory, const size_t length, const char* data);
 
-DPL_Value dpl_value_make_boolean(bool value);
 const char *dpl_value_format_boolean(bool value);
 
 DPL_Value dpl_value_make_object(DPL_MemoryValue_Pool* pool, const size_t field_count, const DPL_Value *fields);
-uint8_t dpl_value_object_field_count(DPL_MemoryValue *object);
-DPL_Value dpl_value_object_get_field(DPL_MemoryValue *object, uint8_t field_index);
+// Overwrites the fields of `object` with `fields` if they have its shape and
+// returns whether it did. The previous values are swapped into `fields`, so
+// the caller can release them.
+bool dpl_value_object_overwrite(DPL_MemoryValue *object, const size_t field_count, DPL_Value *fields);
+uint32_t dpl_value_object_field_count(DPL_MemoryValue *object);
+DPL_Value dpl_value_object_get_field(DPL_MemoryValue *object, uint32_t field_index);
+
+static inline DPL_ObjectShape *dpl_value_object_shape(const DPL_MemoryValue *object)
+{
+    return *(DPL_ObjectShape **)object->data;
+}
+
+// Reads a field known to be stored as a number, without boxing it.
+static inline double dpl_value_object_get_number(DPL_MemoryValue *object, uint32_t field_index)
+{
+    return *(double *)(object->data + dpl_value_object_shape(object)->fields[field_index].offset);
+}
+
+// Reads a field known to be stored as a boolean, without boxing it.
+static inline bool dpl_value_object_get_boolean(DPL_MemoryValue *object, uint32_t field_index)
+{
+    return *(bool *)(object->data + dpl_value_object_shape(object)->fields[field_index].offset);
+}
 
 DPL_Value dpl_value_make_array(DPL_MemoryValue_Pool* pool, const size_t element_count, const DPL_Value* elements);
+// Creates a new array from the elements of `array` followed by `new_item`.
+// The new array references the elements of `array` as well.
 DPL_Value dpl_value_make_array_concat(DPL_MemoryValue_Pool* pool, DPL_MemoryValue* array, const DPL_Value new_item);
+// Appends to a uniquely referenced array, in place as long as its capacity
+// suffices. Otherwise the elements move to a new item with doubled capacity,
+// or to a trie beyond DPL_ARRAY_TRIE_THRESHOLD elements, and `array` is freed.
+DPL_Value dpl_value_array_append(DPL_MemoryValue_Pool* pool, DPL_MemoryValue* array, const DPL_Value new_item);
+// Creates an array of `element_count` unboxed numbers. The elements are not
+// initialized, fill them through dpl_value_array_numbers.
+DPL_Value dpl_value_make_number_array(DPL_MemoryValue_Pool* pool, const size_t element_count);
+// Creates the array `[..before, ..array, ..after]`. References to `before`
+// and `after` are taken over, the elements of `array` are shared.
+DPL_Value dpl_value_make_array_extend(DPL_MemoryValue_Pool* pool, DPL_MemoryValue* array,
+                                      const uint32_t before_count, const DPL_Value* before,
+                                      const uint32_t after_count, const DPL_Value* after);
+// Creates a copy of `array` that stores its elements contiguously.
+DPL_Value dpl_value_make_array_flat(DPL_MemoryValue_Pool* pool, DPL_MemoryValue* array);
 DPL_Value dpl_value_make_array_slot();
-uint8_t dpl_value_array_element_count(DPL_MemoryValue *array);
-DPL_Value dpl_value_array_get_element(DPL_MemoryValue *array, uint8_t element_index);
+uint32_t dpl_value_array_element_count(DPL_MemoryValue *array);
+DPL_Value dpl_value_array_get_element(DPL_MemoryValue *array, uint32_t element_index);
+// Unboxed elements of a flat array of numbers. Empty arrays are accepted
+// regardless of their storage.
+double *dpl_value_array_numbers(DPL_MemoryValue *array);
 
 void dpl_value_print_number(double value);
 void dpl_value_print_sv(const Nob_String_View sv);
-void dpl_value_print_string(DPL_MemoryValue *value);
+void dpl_value_print_string(DPL_Value value);
 void dpl_value_print_boolean(bool value);
 void dpl_value_print(DPL_Value value);
 
 bool dpl_value_number_equals(double number1, double number2);
-bool dpl_value_string_equals(DPL_MemoryValue *string1, DPL_MemoryValue *string2);
+bool dpl_value_string_equals(DPL_Value string1, DPL_Value string2);
 bool dpl_value_equals(DPL_Value value1, DPL_Value value2);
+// Structural hash that is the same for values that are equal according to
+// dpl_value_equals. Numbers are compared with a tolerance, so they contribute
+// only their kind. Hashes of strings, objects and arrays in the pool are cached.
+uint32_t dpl_value_hash(DPL_Value value);
 
 #endif // __DPL_VALUE_H
\ No newline at end of file
@@ -0,0 +1,13 @@
+#ifndef __DPL_VERIFIER_H
+#define __DPL_VERIFIER_H
+
+#include <dpl/program.h>
+
+// Checks the program code once before execution: instruction encoding, jump
+// and call targets, local slot indices, constant offsets, intrinsic ids and
+// stack balance. On success, the maximum stack depth of each function is
+// stored in `program->functions`, which allows the VM to run without checking
+// the stack on every instruction.
+bool dplp_verify(DPL_Program *program);
+
+#endif // __DPL_VERIFIER_H
@@ -0,0 +1,33 @@
+#ifndef __DPL_VM_JIT_H
+#define __DPL_VM_JIT_H
+
+#include <dpl/vm/vm.h>
+
+#if defined(__x86_64__) && defined(__linux__)
+#define DPLV_JIT_SUPPORTED
+#endif
+
+// Number of interpreted calls of a user function before it gets compiled.
+#define DPLV_JIT_THRESHOLD 100
+// Maximum number of stack slots a compiled function may use.
+#define DPLV_JIT_MAX_SLOTS 64
+// Maximum nesting of compiled functions on the native stack. Deeper calls are
+// run by the interpreter.
+#define DPLV_JIT_MAX_DEPTH 4096
+
+// Baseline template JIT: user functions that only compute with numbers and
+// booleans are translated into machine code once they have been called
+// `jit_threshold` times. The compiled code is specialized for the argument
+// kinds observed at that point. Functions using other values, and calls with
+// other argument kinds, stay in the interpreter. Without platform support,
+// all functions are interpreted.
+bool dplv_jit_supported(void);
+void dplv_jit_init(DPL_VirtualMachine *vm);
+void dplv_jit_free(DPL_VirtualMachine *vm);
+
+// Tries to run the user function starting at instruction `target` with the
+// `arity` arguments on top of the stack as compiled code. On success, the
+// arguments are replaced by the result and true is returned.
+bool dplv_jit_call(DPL_VirtualMachine *vm, size_t target, size_t arity);
+
+#endif // __DPL_VM_JIT_H
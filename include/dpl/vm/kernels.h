@@ -0,0 +1,30 @@
+#ifndef __DPL_VM_KERNELS_H
+#define __DPL_VM_KERNELS_H
+
+#include <stddef.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(DPLV_KERNELS_SCALAR)
+#define DPLV_KERNELS_X86
+#endif
+
+// Loops over unboxed number arrays used by the number array intrinsics. On
+// x86-64, SSE2 versions are used and AVX2 versions are selected at runtime
+// when the cpu supports them. Everywhere else, or when DPLV_KERNELS_SCALAR is
+// defined, plain scalar loops are used.
+// Reductions combine partial sums per lane, so their rounding may differ from
+// a strict left-to-right evaluation.
+typedef struct
+{
+    double (*sum)(const double *a, size_t n);
+    double (*min)(const double *a, size_t n);
+    double (*max)(const double *a, size_t n);
+    double (*dot)(const double *a, const double *b, size_t n);
+    void (*scale)(double *out, const double *a, double factor, size_t n);
+    void (*add)(double *out, const double *a, const double *b, size_t n);
+    void (*multiply)(double *out, const double *a, const double *b, size_t n);
+} DPLV_Kernels;
+
+// Returns the best kernels for the running cpu. `min` and `max` expect n > 0.
+const DPLV_Kernels *dplv_kernels(void);
+
+#endif // __DPL_VM_KERNELS_H
@@ -0,0 +1,42 @@
+#ifndef __DPL_VM_RUNTIME_H
+#define __DPL_VM_RUNTIME_H
+
+#include <dpl/intrinsics.h>
+#include <dpl/vm/vm.h>
+
+// Support functions for the C code emitted by `dplc --emit-c` (see
+// dpl/emitter.h). The emitted code keeps numbers and booleans in plain C
+// variables and only uses a virtual machine without a program for its value
+// pool and for calling intrinsics. Values passed to these functions are
+// consumed, just like the corresponding instructions consume their operands.
+
+typedef struct
+{
+    DPL_Value *items;
+    size_t count;
+    size_t capacity;
+} DPL_Runtime_Array;
+
+void dplv_runtime_init(DPL_VirtualMachine *vm);
+void dplv_runtime_free(DPL_VirtualMachine *vm);
+
+DPL_Value dplv_runtime_call_intrinsic(DPL_VirtualMachine *vm, DPL_Intrinsic_Kind kind, size_t count, const DPL_Value *arguments);
+
+DPL_Value dplv_runtime_concat_string(DPL_VirtualMachine *vm, DPL_Value string1, DPL_Value string2);
+bool dplv_runtime_string_equals(DPL_VirtualMachine *vm, DPL_Value string1, DPL_Value string2);
+DPL_Value dplv_runtime_interpolation(DPL_VirtualMachine *vm, size_t count, const DPL_Value *strings);
+
+// Takes the value out of a local that is not read again (PUSH_LOCAL_MOVE).
+DPL_Value dplv_runtime_move(DPL_Value *local);
+// Like CREATE_OBJECT_REUSE. `source` is the value of a local and not consumed.
+DPL_Value dplv_runtime_create_object_reuse(DPL_VirtualMachine *vm, DPL_Value source, size_t field_count, DPL_Value *fields);
+DPL_Value dplv_runtime_load_field(DPL_VirtualMachine *vm, DPL_Value object, size_t field_index);
+double dplv_runtime_load_field_number(DPL_VirtualMachine *vm, DPL_Value object, size_t field_index);
+bool dplv_runtime_load_field_boolean(DPL_VirtualMachine *vm, DPL_Value object, size_t field_index);
+
+void dplv_runtime_array_append(DPL_Runtime_Array *array, DPL_Value element);
+void dplv_runtime_array_spread(DPL_VirtualMachine *vm, DPL_Runtime_Array *array, DPL_Value source);
+DPL_Value dplv_runtime_array_end(DPL_VirtualMachine *vm, DPL_Runtime_Array *array);
+DPL_Value dplv_runtime_concat_array(DPL_VirtualMachine *vm, DPL_Value array, DPL_Value element);
+
+#endif // __DPL_VM_RUNTIME_H
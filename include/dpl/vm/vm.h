@@ -6,6 +6,11 @@
 #include <dpl/program.h>
 #include <dpl/value.h>
 
+#define DPLV_STACK_CAPACITY 256
+#define DPLV_STACK_MAX_CAPACITY ((size_t)1 << 24)
+#define DPLV_CALLSTACK_CAPACITY 64
+#define DPLV_CALLSTACK_MAX_CAPACITY ((size_t)1 << 20)
+
 typedef struct
 {
     size_t stack_top;
@@ -14,7 +19,38 @@ typedef struct
     size_t return_ip;
 } DPL_CallFrame;
 
+// Instructions are decoded once from the program bytecode into fixed-width
+// records before execution. Jump and call targets are resolved to indices into
+// the decoded instruction array, `ip` keeps the byte offset of the original
+// instruction for tracing and debugging.
+typedef struct
+{
+    DPL_Instruction_Kind kind;
+    uint32_t count;
+    size_t ip;
+    union
+    {
+        double number;
+        bool boolean;
+        size_t index;
+        // String constants are created once when decoding.
+        DPL_Value string;
+        struct
+        {
+            size_t target;
+            size_t max_stack_depth;
+        } call;
+        struct
+        {
+            uint32_t source;
+            uint32_t target;
+            double number;
+        } update;
+    } as;
+} DPL_Instruction;
+
 typedef int (*DPL_VirtualMachine_PrintCallback) (void* context, char const *str, ...);
+int dplv_print(void* context, char const *str, ...);
 
 
 typedef struct DPL_VirtualMachine
@@ -27,16 +63,48 @@ typedef struct DPL_VirtualMachine
     bool debug;
     bool trace;
 
+    // When set, counts how often each pair of instructions is executed in
+    // direct succession (see dplv_print_profile).
+    bool profile;
+    size_t *profile_counts;
+    size_t profile_previous;
+
+    // When set, hot user functions are compiled to machine code where
+    // supported (see dpl/vm/jit.h). A zero threshold selects the default.
+    bool jit;
+    size_t jit_threshold;
+    struct DPL_Jit *jit_state;
+
+    // Initial and maximum sizes of the stacks. Zero selects the defaults.
     size_t stack_capacity;
+    size_t stack_max_capacity;
     size_t stack_top;
     DPL_Value *stack;
     DPL_MemoryValue_Pool stack_pool;
 
+    // Objects and arrays whose last reference is gone. Their elements are
+    // released from this worklist instead of recursively. With a nonzero
+    // budget, each dplv_release frees at most that many of them and leaves
+    // the rest for later calls.
+    size_t release_budget;
+    struct
+    {
+        DPL_MemoryValue **items;
+        size_t count;
+        size_t capacity;
+    } release_queue;
+
     size_t callstack_capacity;
+    size_t callstack_max_capacity;
     size_t callstack_top;
     DPL_CallFrame *callstack;
 
-    DW_ByteStream program_stream;
+    DPL_Instruction *code;
+    size_t code_count;
+    size_t max_stack_depth;
+    size_t entry;
+    size_t ip;
+
     DW_ByteStream constants_stream;
 
     Arena memory;
@@ -48,14 +116,20 @@ void dplv_free(DPL_VirtualMachine *vm);
 void dplv_run_begin(DPL_VirtualMachine *vm);
 void dplv_run_end(DPL_VirtualMachine *vm);
 void dplv_run_step(DPL_VirtualMachine *vm);
-#define dplv_run_at_end(vm) (bs_at_end(&(vm)->program_stream))
+#define dplv_run_at_end(vm) ((vm)->ip >= (vm)->code_count)
+size_t dplv_instruction_ip(const DPL_VirtualMachine *vm, size_t index);
 void dplv_run(DPL_VirtualMachine *vm);
+void dplv_run_function(DPL_VirtualMachine *vm, size_t target, size_t arity);
+void dplv_print_profile(DPL_VirtualMachine *vm);
+
+void dplv_ensure_stack(DPL_VirtualMachine *vm, size_t required);
 
 DPL_Value dplv_peek(DPL_VirtualMachine *vm);
 DPL_Value dplv_peekn(DPL_VirtualMachine *vm, size_t n);
 
 DPL_Value dplv_reference(DPL_VirtualMachine *vm, DPL_Value value);
 void dplv_release(DPL_VirtualMachine *vm, DPL_Value value);
+void dplv_release_pending(DPL_VirtualMachine *vm, size_t budget);
 
 void dplv_return(DPL_VirtualMachine *vm, size_t arity, DPL_Value value);
 void dplv_return_number(DPL_VirtualMachine *vm, size_t arity, double value);
@@ -3,6 +3,8 @@
 #include "./thirdparty/nob.h"
 #include "./thirdparty/nobx.h"
 
+#include <time.h>
+
 #define BUILD_DIR "build/"
 #define BUILD_OUTPUT(output) "./" BUILD_DIR output
 
@@ -22,6 +24,7 @@
 #define COMMAND_RUN nob_sv_from_cstr("run")
 #define COMMAND_TEST nob_sv_from_cstr("test")
 #define COMMAND_DEBUG nob_sv_from_cstr("debug")
+#define COMMAND_BENCH nob_sv_from_cstr("bench")
 
 #define TARGET_DPLC nob_sv_from_cstr("dplc")
 #define TARGET_DPL nob_sv_from_cstr("dpl")
@@ -54,7 +57,31 @@ void check_command_end(Nob_String_View program, int *argc, char ***argv, const c
     }
 }
 
-void build_dplc(bool debug_build)
+typedef struct
+{
+    bool debug;
+    bool nanbox;
+    bool optimize;
+    const char *output;
+} Build_Options;
+
+void append_build_options(Nob_Cmd *cmd, Build_Options options)
+{
+    if (options.debug)
+    {
+        nob_cmd_append(cmd, "-DDPL_LEAKCHECK");
+    }
+    if (options.nanbox)
+    {
+        nob_cmd_append(cmd, "-DDPL_VALUE_NANBOX");
+    }
+    if (options.optimize)
+    {
+        nob_cmd_append(cmd, "-O2");
+    }
+}
+
+void build_dplc(Build_Options options)
 {
     Nob_Cmd cmd = {0};
     cmd.count = 0;
@@ -62,13 +89,12 @@ void build_dplc(bool debug_build)
     nob_cmd_append(&cmd, "-Wall", "-Wextra", "-ggdb");
     nob_cmd_append(&cmd, "-I./include/");
     nob_cmd_append(&cmd, "-I./thirdparty/");
-    if (debug_build)
-    {
-        nob_cmd_append(&cmd, "-DDPL_LEAKCHECK");
-    }
+    append_build_options(&cmd, options);
     nob_cmd_append(&cmd,
                    "./src/dpl.c",
                    "./src/binding.c",
+                   "./src/emitter.c",
+                   "./src/fusion.c",
                    "./src/generator.c",
                    "./src/intrinsics.c",
                    "./src/lexer.c",
@@ -76,9 +102,10 @@ void build_dplc(bool debug_build)
                    "./src/program.c",
                    "./src/symbols.c",
                    "./src/value.c",
+                   "./src/verifier.c",
                    "./dplc.c", );
     nob_cmd_append(&cmd, "-lm");
-    nob_cmd_append(&cmd, "-o", DPLC_OUTPUT);
+    nob_cmd_append(&cmd, "-o", options.output ? options.output : DPLC_OUTPUT);
 
     bool success = nob_cmd_run_sync(cmd);
     nob_cmd_free(cmd);
@@ -88,7 +115,7 @@ void build_dplc(bool debug_build)
     }
 }
 
-void build_dpl(bool debug_build)
+void build_dpl(Build_Options options)
 {
     Nob_Cmd cmd = {0};
     cmd.count = 0;
@@ -96,19 +123,19 @@ void build_dpl(bool debug_build)
     nob_cmd_append(&cmd, "-Wall", "-Wextra", "-ggdb");
     nob_cmd_append(&cmd, "-I./include/");
     nob_cmd_append(&cmd, "-I./thirdparty/");
-    if (debug_build)
-    {
-        nob_cmd_append(&cmd, "-DDPL_LEAKCHECK");
-    }
+    append_build_options(&cmd, options);
     nob_cmd_append(&cmd,
                    "./src/program.c",
+                   "./src/verifier.c",
                    "./src/intrinsics.c",
                    "./src/vm/intrinsics.c",
                    "./src/value.c",
                    "./src/vm.c",
+                   "./src/vm/jit.c",
+                   "./src/vm/kernels.c",
                    "./dpl.c", );
     nob_cmd_append(&cmd, "-lm");
-    nob_cmd_append(&cmd, "-o", DPL_OUTPUT);
+    nob_cmd_append(&cmd, "-o", options.output ? options.output : DPL_OUTPUT);
 
     bool success = nob_cmd_run_sync(cmd);
     if (!success)
@@ -205,7 +232,7 @@ defer:
     return result;
 }
 
-void build_dplg(bool debug_build)
+void build_dplg(Build_Options options)
 {
     if (!build_raylib()) return;
 
@@ -218,16 +245,17 @@ void build_dplg(bool debug_build)
     nob_cmd_append(&cmd, "-I./" RAYLIB_SRC_DIR);
     nob_cmd_append(&cmd, "-I./thirdparty/raygui/src/");
     nob_cmd_append(&cmd, "-L./" RAYLIB_BUILD_DIR);
-    if (debug_build)
-    {
-        nob_cmd_append(&cmd, "-DDPL_LEAKCHECK");
-    }
+    nob_cmd_append(&cmd, "-DDPL_MEMORYVALUE_POOL_TRACKING");
+    append_build_options(&cmd, options);
     nob_cmd_append(&cmd,
                     "./src/program.c",
+                    "./src/verifier.c",
                     "./src/intrinsics.c",
                     "./src/vm/intrinsics.c",
                     "./src/value.c",
                     "./src/vm.c",
+                    "./src/vm/jit.c",
+                    "./src/vm/kernels.c",
                     "./src/debugger/instructions.c",
                     "./src/debugger/ui.c",
                     "./dplg.c", );
@@ -235,7 +263,7 @@ void build_dplg(bool debug_build)
     nob_cmd_append(&cmd, "-lgdi32");
     nob_cmd_append(&cmd, "-lwinmm");
     nob_cmd_append(&cmd, "-lm");
-    nob_cmd_append(&cmd, "-o", DPLG_OUTPUT);
+    nob_cmd_append(&cmd, "-o", options.output ? options.output : DPLG_OUTPUT);
 
     bool success = nob_cmd_run_sync(cmd);
     if (!success)
@@ -251,7 +279,7 @@ void build(Nob_String_View program, int *argc, char ***argv)
     nob_mkdir_if_not_exists(BUILD_DIR);
 
     bool have_built = false;
-    bool debug_build = false;
+    Build_Options options = {0};
     while (*argc > 0)
     {
         Nob_String_View target = nob_sv_shift_args(argc, argv);
@@ -260,31 +288,38 @@ void build(Nob_String_View program, int *argc, char ***argv)
             break;
         }
 
-        if (nob_sv_eq(target, nob_sv_from_cstr("--debug")))
+        if (nob_sv_eq(target, nob_sv_from_cstr("--debug")) || nob_sv_eq(target, nob_sv_from_cstr("--nanbox")))
         {
             if (have_built)
             {
-                nob_log(NOB_ERROR, "Flag --debug cannot be set after a target has already been built.\n");
+                nob_log(NOB_ERROR, "Flag " SV_Fmt " cannot be set after a target has already been built.\n", SV_Arg(target));
                 usage(program, true);
                 exit(1);
             }
-            debug_build = true;
+            if (nob_sv_eq(target, nob_sv_from_cstr("--debug")))
+            {
+                options.debug = true;
+            }
+            else
+            {
+                options.nanbox = true;
+            }
             continue;
         }
 
         if (nob_sv_eq(target, TARGET_DPLC))
         {
-            build_dplc(debug_build);
+            build_dplc(options);
             have_built = true;
         }
         else if (nob_sv_eq(target, TARGET_DPL))
         {
-            build_dpl(debug_build);
+            build_dpl(options);
             have_built = true;
         }
         else if (nob_sv_eq(target, TARGET_DPLG))
         {
-            build_dplg(debug_build);
+            build_dplg(options);
             have_built = true;
         }
         else
@@ -297,9 +332,9 @@ void build(Nob_String_View program, int *argc, char ***argv)
 
     if (!have_built)
     {
-        build_dplc(debug_build);
-        build_dpl(debug_build);
-        build_dplg(debug_build);
+        build_dplc(options);
+        build_dpl(options);
+        build_dplg(options);
     }
 }
 
@@ -356,7 +391,11 @@ void help(Nob_String_View program, int *argc, char ***argv)
         "\n"
         "Commands:\n"
         "* build: Build the listed targets. If no targets are given, build all\n"
-        "         of them.\n"
+        "         of them. Flags given before the targets: --debug enables leak\n"
+        "         checking, --nanbox selects the NaN-boxed value layout.\n"
+        "* bench: Build optimized virtual machines for both value layouts and\n"
+        "         compare their run times on the programs in benchmarks/.\n"
+        "         Optionally takes the number of runs per program (default 5).\n"
         "* cmd  : Execute the given target. Pass the following arguments (up\n"
         "         until a possible \"--\" delimiter) to the spawned process.\n"
         "* help : Print this help message.\n"
@@ -364,6 +403,9 @@ void help(Nob_String_View program, int *argc, char ***argv)
         "         compiling and running.\n"
         "* debug: Run the given dpl file in the debugger. Uses the targets dplc\n"
         "         and dplg for compiling and running.\n"
+        "* test : Run the tests in tests/. -r records the expected outputs,\n"
+        "         --jit runs the virtual machine with the JIT enabled,\n"
+        "         --emit-c compiles the tests to C executables instead.\n"
         "\n"
         "Targets:\n"
         "* dpl  : The DPL Virtual Machine. Can be used to run program files\n"
@@ -563,7 +605,14 @@ void run_test_cmd(Nob_Cmd cmd, Nob_String_View test_filename, const char *test_o
     }
 }
 
-void run_test(Nob_String_View test_filename, bool record, TestResults *test_results)
+typedef enum
+{
+    TEST_BACKEND_VM,
+    TEST_BACKEND_JIT,
+    TEST_BACKEND_C,
+} Test_Backend;
+
+void run_test(Nob_String_View test_filename, bool record, Test_Backend backend, TestResults *test_results)
 {
     if (!record && !test_results)
     {
@@ -578,7 +627,45 @@ void run_test(Nob_String_View test_filename, bool record, TestResults *test_resu
     const char *test_filepath = nob_temp_sprintf("./tests/" SV_Fmt, SV_Arg(test_filename));
     const char *test_outpath = nob_temp_sprintf("./tests/" SV_Fmt ".out", SV_Arg(test_filename));
 
-    if (nob_sv_end_with(test_filename, ".dpl"))
+    if (nob_sv_end_with(test_filename, ".dpl") && backend == TEST_BACKEND_C)
+    {
+        const char *test_cpath = nob_temp_sprintf("./" BUILD_DIR SV_Fmt ".c", SV_Arg(test_filename));
+        const char *test_exepath = nob_temp_sprintf("./" BUILD_DIR SV_Fmt ".exe", SV_Arg(test_filename));
+
+        cmd.count = 0;
+        nob_cmd_append(&cmd, DPLC_OUTPUT);
+        nob_cmd_append(&cmd, "--emit-c", "-o", test_cpath);
+        nob_cmd_append(&cmd, test_filepath);
+        if (!nob_cmd_run_sync(cmd))
+            exit(1);
+
+        cmd.count = 0;
+        nob_cmd_append(&cmd, "gcc");
+        nob_cmd_append(&cmd, "-Wall", "-Wextra", "-ggdb");
+        nob_cmd_append(&cmd, "-I./include/");
+        nob_cmd_append(&cmd, "-I./thirdparty/");
+        nob_cmd_append(&cmd, test_cpath);
+        nob_cmd_append(&cmd,
+                       "./src/program.c",
+                       "./src/verifier.c",
+                       "./src/intrinsics.c",
+                       "./src/vm/intrinsics.c",
+                       "./src/value.c",
+                       "./src/vm.c",
+                       "./src/vm/jit.c",
+                       "./src/vm/kernels.c",
+                       "./src/vm/runtime.c", );
+        nob_cmd_append(&cmd, "-lm");
+        nob_cmd_append(&cmd, "-o", test_exepath);
+        if (!nob_cmd_run_sync(cmd))
+            exit(1);
+
+        cmd.count = 0;
+        nob_cmd_append(&cmd, test_exepath);
+
+        run_test_cmd(cmd, test_filename, test_outpath, record, test_results);
+    }
+    else if (nob_sv_end_with(test_filename, ".dpl"))
     {
         Nob_String_Builder test_dplppath = {0};
         build_dplc_output(&test_dplppath, test_filepath);
@@ -592,6 +679,11 @@ void run_test(Nob_String_View test_filename, bool record, TestResults *test_resu
 
         cmd.count = 0;
         nob_cmd_append(&cmd, DPL_OUTPUT);
+        if (backend == TEST_BACKEND_JIT)
+        {
+            // Compile every eligible function on its first call.
+            nob_cmd_append(&cmd, "--jit", "--jit-threshold", "1");
+        }
         nob_cmd_append(&cmd, test_dplppath.items);
 
         run_test_cmd(cmd, test_filename, test_outpath, record, test_results);
@@ -657,14 +749,29 @@ void test(Nob_String_View program, int *argc, char ***argv)
     }
 
     bool record = false;
+    Test_Backend backend = TEST_BACKEND_VM;
 
-    if (*argc > 0)
+    while (*argc > 0 && !nob_sv_eq(nob_sv_from_cstr((*argv)[0]), COMMAND_DELIM))
     {
         const char *arg = nob_shift_args(argc, argv);
         if (strcmp(arg, "-r") == 0)
         {
             record = true;
         }
+        else if (strcmp(arg, "--jit") == 0)
+        {
+            backend = TEST_BACKEND_JIT;
+        }
+        else if (strcmp(arg, "--emit-c") == 0)
+        {
+            backend = TEST_BACKEND_C;
+        }
+        else
+        {
+            nob_log(NOB_ERROR, "Unknown flag \"%s\" for command `test`.", arg);
+            usage(program, true);
+            exit(1);
+        }
     }
     check_command_end(program, argc, argv, "test");
 
@@ -678,7 +785,7 @@ void test(Nob_String_View program, int *argc, char ***argv)
         {
             continue;
         }
-        run_test(test_filename, record, &test_results);
+        run_test(test_filename, record, backend, &test_results);
     }
     closedir(dfd);
 
@@ -690,6 +797,107 @@ void test(Nob_String_View program, int *argc, char ***argv)
         exit(1);
 }
 
+#define BENCH_DPL_TAGGED_OUTPUT BUILD_OUTPUT("dpl-tagged.exe")
+#define BENCH_DPL_NANBOX_OUTPUT BUILD_OUTPUT("dpl-nanbox.exe")
+
+double bench_run(const char *vm_path, const char *program_path, int runs)
+{
+    Nob_Cmd cmd = {0};
+    nob_cmd_append(&cmd, vm_path, program_path);
+
+    Nob_String_Builder output = {0};
+    double best = -1;
+    for (int i = 0; i < runs; ++i)
+    {
+        struct timespec begin, end;
+        timespec_get(&begin, TIME_UTC);
+
+        output.count = 0;
+        if (!nob_cmd_capture_sync(cmd, &output))
+            exit(1);
+
+        timespec_get(&end, TIME_UTC);
+        double seconds = (end.tv_sec - begin.tv_sec) + (end.tv_nsec - begin.tv_nsec) / 1e9;
+        if (best < 0 || seconds < best)
+        {
+            best = seconds;
+        }
+    }
+
+    nob_sb_free(output);
+    nob_cmd_free(cmd);
+    return best;
+}
+
+void bench(Nob_String_View program, int *argc, char ***argv)
+{
+    int runs = 5;
+    if (*argc > 0 && !nob_sv_eq(nob_sv_from_cstr((*argv)[0]), COMMAND_DELIM))
+    {
+        const char *arg = nob_shift_args(argc, argv);
+        runs = atoi(arg);
+        if (runs <= 0)
+        {
+            nob_log(NOB_ERROR, "Invalid number of benchmark runs \"%s\".", arg);
+            usage(program, true);
+            exit(1);
+        }
+    }
+    check_command_end(program, argc, argv, "bench");
+
+    nob_mkdir_if_not_exists(BUILD_DIR);
+    build_dplc((Build_Options) {0});
+    build_dpl((Build_Options) {.optimize = true, .output = BENCH_DPL_TAGGED_OUTPUT});
+    build_dpl((Build_Options) {.optimize = true, .nanbox = true, .output = BENCH_DPL_NANBOX_OUTPUT});
+
+    DIR *dfd;
+    if ((dfd = opendir("./benchmarks")) == NULL)
+    {
+        nob_log(NOB_ERROR, "Cannot iterate benchmark files.");
+        exit(1);
+    }
+
+    Nob_Log_Level log_level = nob_minimal_log_level;
+
+    printf("\n%-24s %12s %12s %8s\n", "Benchmark", "tagged [s]", "nanbox [s]", "ratio");
+    struct dirent *dp;
+    while ((dp = readdir(dfd)) != NULL)
+    {
+        Nob_String_View bench_filename = nob_sv_from_cstr(dp->d_name);
+        if (!nob_sv_end_with(bench_filename, ".dpl"))
+        {
+            continue;
+        }
+
+        size_t temp_save = nob_temp_save();
+        const char *bench_filepath = nob_temp_sprintf("./benchmarks/" SV_Fmt, SV_Arg(bench_filename));
+
+        Nob_String_Builder bench_dplppath = {0};
+        build_dplc_output(&bench_dplppath, bench_filepath);
+
+        nob_minimal_log_level = NOB_WARNING;
+
+        Nob_Cmd cmd = {0};
+        nob_cmd_append(&cmd, DPLC_OUTPUT);
+        nob_cmd_append(&cmd, "-o", bench_dplppath.items);
+        nob_cmd_append(&cmd, bench_filepath);
+        if (!nob_cmd_run_sync(cmd))
+            exit(1);
+        nob_cmd_free(cmd);
+
+        double tagged = bench_run(BENCH_DPL_TAGGED_OUTPUT, bench_dplppath.items, runs);
+        double nanbox = bench_run(BENCH_DPL_NANBOX_OUTPUT, bench_dplppath.items, runs);
+
+        nob_minimal_log_level = log_level;
+
+        printf("%-24s %12.3f %12.3f %8.2f\n", dp->d_name, tagged, nanbox, nanbox / tagged);
+
+        nob_sb_free(bench_dplppath);
+        nob_temp_rewind(temp_save);
+    }
+    closedir(dfd);
+}
+
 int main(int argc, char **argv)
 {
     NOB_GO_REBUILD_URSELF(argc, argv);
@@ -731,6 +939,10 @@ int main(int argc, char **argv)
         {
             test(program, &argc, &argv);
         }
+        else if (nob_sv_eq(command, COMMAND_BENCH))
+        {
+            bench(program, &argc, &argv);
+        }
         else
         {
             nob_log(NOB_ERROR, "Unknown command \"" SV_Fmt "\".", SV_Arg(command));
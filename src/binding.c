@@ -1,3 +1,7 @@
+#ifdef DPL_LEAKCHECK
+#include <stb_leakcheck.h>
+#endif
+
 #include <assert.h>
 
 #include <arena.h>
@@ -37,9 +41,10 @@ const char *BOUND_NODE_KIND_NAMES[COUNT_BOUND_NODE_KINDS] = {
     [BOUND_NODE_LOAD_FIELD] = "BOUND_NODE_LOAD_FIELD",
     [BOUND_NODE_INTERPOLATION] = "BOUND_NODE_INTERPOLATION",
     [BOUND_NODE_SPREAD] = "BOUND_NODE_SPREAD",
+    [BOUND_NODE_ITERATE] = "BOUND_NODE_ITERATE",
 };
 
-static_assert(COUNT_BOUND_NODE_KINDS == 14,
+static_assert(COUNT_BOUND_NODE_KINDS == 15,
               "Count of bound node kinds has changed, please update bound node kind names map.");
 
 const char *dpl_bind_nodekind_name(DPL_BoundNodeKind kind)
@@ -150,6 +155,7 @@ static const char *dpl_bind_type_name(DPL_Ast_Type *ast_type)
     nob_sb_append_null(&sb);
 
     strncpy(result, sb.items, NOB_ARRAY_LEN(result));
+    nob_sb_free(sb);
     return result;
 }
 
@@ -237,11 +243,166 @@ static void dpl_bind_check_assignment(DPL_Binding *binding, const char *what, DP
 static DPL_Bound_Node *dpl_bind_allocate_node(DPL_Binding *binding, DPL_BoundNodeKind kind, DPL_Symbol *type)
 {
     DPL_Bound_Node *bound_node = arena_alloc(binding->memory, sizeof(DPL_Bound_Node));
+    memset(bound_node, 0, sizeof(*bound_node));
     bound_node->kind = kind;
     bound_node->type = type;
     return bound_node;
 }
 
+// Values of these types are reference counted, so moving them out of a local
+// can keep them uniquely owned.
+static bool dpl_bind_is_counted_type(DPL_Symbol *type)
+{
+    DPL_Symbol *resolved_type = dpl_symbols_resolve_type_alias(type);
+    return !dpl_symbols_is_type_base(resolved_type, TYPE_BASE_NUMBER)
+        && !dpl_symbols_is_type_base(resolved_type, TYPE_BASE_BOOLEAN);
+}
+
+// Collects the nodes in `node` that read or assign the local at `scope_index`.
+// Uses inside loops are collected twice, as they may be repeated.
+static void dpl_bind_collect_uses(DPL_Bound_Node *node, size_t scope_index, DPL_Bound_Nodes *uses)
+{
+    if (!node)
+    {
+        return;
+    }
+
+    switch (node->kind)
+    {
+    case BOUND_NODE_VALUE:
+        break;
+    case BOUND_NODE_VARREF:
+    case BOUND_NODE_ARGREF:
+        if (node->as.varref == scope_index)
+        {
+            nob_da_append(uses, node);
+        }
+        break;
+    case BOUND_NODE_ITERATE:
+        if (node->as.iterate.scope_index == scope_index || node->as.iterate.scope_index + 1 == scope_index)
+        {
+            nob_da_append(uses, node);
+            nob_da_append(uses, node);
+        }
+        break;
+    case BOUND_NODE_OBJECT:
+        for (size_t i = 0; i < node->as.object.field_count; ++i)
+        {
+            dpl_bind_collect_uses(node->as.object.fields[i].expression, scope_index, uses);
+        }
+        dpl_bind_collect_uses(node->as.object.reuse, scope_index, uses);
+        break;
+    case BOUND_NODE_ARRAY:
+        for (size_t i = 0; i < node->as.array.element_count; ++i)
+        {
+            dpl_bind_collect_uses(node->as.array.elements[i], scope_index, uses);
+        }
+        break;
+    case BOUND_NODE_FUNCTIONCALL:
+        for (size_t i = 0; i < node->as.function_call.arguments_count; ++i)
+        {
+            dpl_bind_collect_uses(node->as.function_call.arguments[i], scope_index, uses);
+        }
+        break;
+    case BOUND_NODE_SCOPE:
+        for (size_t i = 0; i < node->as.scope.expressions_count; ++i)
+        {
+            dpl_bind_collect_uses(node->as.scope.expressions[i], scope_index, uses);
+        }
+        break;
+    case BOUND_NODE_ASSIGNMENT:
+        if (node->as.assignment.scope_index == scope_index)
+        {
+            nob_da_append(uses, node);
+        }
+        dpl_bind_collect_uses(node->as.assignment.expression, scope_index, uses);
+        break;
+    case BOUND_NODE_CONDITIONAL:
+        dpl_bind_collect_uses(node->as.conditional.condition, scope_index, uses);
+        dpl_bind_collect_uses(node->as.conditional.then_clause, scope_index, uses);
+        dpl_bind_collect_uses(node->as.conditional.else_clause, scope_index, uses);
+        break;
+    case BOUND_NODE_LOGICAL_OPERATOR:
+        dpl_bind_collect_uses(node->as.logical_operator.lhs, scope_index, uses);
+        dpl_bind_collect_uses(node->as.logical_operator.rhs, scope_index, uses);
+        break;
+    case BOUND_NODE_WHILE_LOOP:
+    {
+        size_t first = uses->count;
+        dpl_bind_collect_uses(node->as.while_loop.condition, scope_index, uses);
+        dpl_bind_collect_uses(node->as.while_loop.body, scope_index, uses);
+        for (size_t i = first, count = uses->count; i < count; ++i)
+        {
+            nob_da_append(uses, uses->items[i]);
+        }
+    }
+    break;
+    case BOUND_NODE_LOAD_FIELD:
+        dpl_bind_collect_uses(node->as.load_field.expression, scope_index, uses);
+        break;
+    case BOUND_NODE_INTERPOLATION:
+        for (size_t i = 0; i < node->as.interpolation.expressions_count; ++i)
+        {
+            dpl_bind_collect_uses(node->as.interpolation.expressions[i], scope_index, uses);
+        }
+        break;
+    case BOUND_NODE_SPREAD:
+        dpl_bind_collect_uses(node->as.spread, scope_index, uses);
+        break;
+    default:
+        DW_UNIMPLEMENTED_MSG("`%s`", dpl_bind_nodekind_name(node->kind));
+    }
+}
+
+// Marks the use of the local at `scope_index` in `node` as a move if it is the
+// only one and a read.
+static void dpl_bind_move_single_read(DPL_Bound_Node *node, size_t scope_index)
+{
+    DPL_Bound_Nodes uses = {0};
+    dpl_bind_collect_uses(node, scope_index, &uses);
+    if (uses.count == 1
+        && (uses.items[0]->kind == BOUND_NODE_VARREF || uses.items[0]->kind == BOUND_NODE_ARGREF)
+        && dpl_bind_is_counted_type(uses.items[0]->type))
+    {
+        uses.items[0]->move = true;
+    }
+    nob_da_free(uses);
+}
+
+// Lets an object of type `type` that is created last when evaluating `node`
+// reuse the local at `scope_index`, which is not used afterwards.
+static void dpl_bind_reuse_local(DPL_Binding *binding, DPL_Bound_Node *node, DPL_BoundNodeKind kind,
+                                 DPL_Symbol *type, size_t scope_index)
+{
+    if (!node || node->persistent)
+    {
+        return;
+    }
+
+    switch (node->kind)
+    {
+    case BOUND_NODE_SCOPE:
+        dpl_bind_reuse_local(binding, node->as.scope.expressions[node->as.scope.expressions_count - 1],
+                             kind, type, scope_index);
+        break;
+    case BOUND_NODE_CONDITIONAL:
+        dpl_bind_reuse_local(binding, node->as.conditional.then_clause, kind, type, scope_index);
+        dpl_bind_reuse_local(binding, node->as.conditional.else_clause, kind, type, scope_index);
+        break;
+    case BOUND_NODE_OBJECT:
+        if (!node->as.object.reuse
+            && dpl_symbols_resolve_type_alias(node->type) == dpl_symbols_resolve_type_alias(type))
+        {
+            DPL_Bound_Node *reference = dpl_bind_allocate_node(binding, kind, type);
+            reference->as.varref = scope_index;
+            node->as.object.reuse = reference;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
 DPL_Bound_Node *dpl_bind_create_scope(DPL_Binding *binding, size_t expression_count, DPL_Bound_Node **expressions)
 {
     if (expression_count == 0)
@@ -269,6 +430,11 @@ DPL_Bound_Node *dpl_bind_create_assignment(DPL_Binding *binding, DPL_Symbol *var
     DPL_Bound_Node *assignment = dpl_bind_allocate_node(binding, BOUND_NODE_ASSIGNMENT, expression->type);
     assignment->as.assignment.scope_index = var->as.var.scope_index;
     assignment->as.assignment.expression = expression;
+
+    // The local is overwritten afterwards: `x := $[ ..x, y := 1 ]` may reuse its
+    // object and `x := f(x)` hands its reference to f.
+    dpl_bind_reuse_local(binding, expression, BOUND_NODE_VARREF, var->as.var.type, var->as.var.scope_index);
+    dpl_bind_move_single_read(expression, var->as.var.scope_index);
     return assignment;
 }
 
@@ -279,6 +445,32 @@ DPL_Bound_Node *dpl_bind_create_varref(DPL_Binding *binding, DPL_Symbol *var)
     return varref;
 }
 
+// The scalar variable referenced by `node`, or NULL.
+static DPL_Symbol *dpl_bind_find_scalar_var(DPL_Binding *binding, DPL_Ast_Node *node)
+{
+    if (node->kind != AST_NODE_SYMBOL)
+    {
+        return NULL;
+    }
+
+    DPL_Symbol *symbol = dpl_symbols_find(binding->symbols, node->as.symbol.text);
+    if (!symbol || symbol->kind != SYMBOL_VAR || !symbol->as.var.scalar)
+    {
+        return NULL;
+    }
+    return symbol;
+}
+
+// Reads the field of a scalar variable from its local.
+DPL_Bound_Node *dpl_bind_create_scalar_field(DPL_Binding *binding, DPL_Symbol *var, size_t field_index)
+{
+    DPL_Symbol *resolved_type = dpl_symbols_resolve_type_alias(var->as.var.type);
+
+    DPL_Bound_Node *varref = dpl_bind_allocate_node(binding, BOUND_NODE_VARREF, resolved_type->as.type.as.object.fields[field_index].type);
+    varref->as.varref = var->as.var.scope_index + field_index;
+    return varref;
+}
+
 DPL_Bound_Node *dpl_bind_create_load_field(DPL_Binding *binding, DPL_Bound_Node *expression, size_t field_index)
 {
     DPL_Symbol *resolved_type = dpl_symbols_resolve_type_alias(expression->type);
@@ -301,6 +493,22 @@ DPL_Bound_Node *dpl_bind_create_while_loop(DPL_Binding *binding, DPL_Bound_Node
     return while_loop;
 }
 
+DPL_Bound_Node *dpl_bind_create_number(DPL_Binding *binding, double value)
+{
+    DPL_Bound_Node *number = dpl_bind_allocate_node(binding, BOUND_NODE_VALUE, dpl_symbols_find_type_number(binding->symbols));
+    number->as.value.type = number->type;
+    number->as.value.as.number = value;
+    return number;
+}
+
+DPL_Bound_Node *dpl_bind_create_iterate(DPL_Binding *binding, DPL_Bound_IterateKind kind, DPL_Symbol *var)
+{
+    DPL_Bound_Node *iterate = dpl_bind_allocate_node(binding, BOUND_NODE_ITERATE, dpl_symbols_find_type_boolean(binding->symbols));
+    iterate->as.iterate.kind = kind;
+    iterate->as.iterate.scope_index = var->as.var.scope_index;
+    return iterate;
+}
+
 DPL_Bound_Node *dpl_bind_create_object_literal_move(DPL_Binding *binding, DPL_Bound_ObjectFields fields)
 {
     DPL_Symbol_Type_ObjectQuery type_query = {0};
@@ -340,7 +548,10 @@ static void dpl_bind_move_nodelist(DPL_Binding *binding, DPL_Bound_Nodes list, s
 static void dpl_bind_check_function_used(DPL_Binding *binding, DPL_Symbol *symbol)
 {
     DPL_Symbol_Function *f = &symbol->as.function;
-    if (f->kind == FUNCTION_USER && !f->as.user_function.used)
+
+    // Recursive calls are bound before the function body is complete. The
+    // function is registered once it is used from outside its own body.
+    if (f->kind == FUNCTION_USER && !f->as.user_function.used && f->as.user_function.body)
     {
         f->as.user_function.used = true;
         f->as.user_function.user_handle = binding->user_functions.count;
@@ -597,6 +808,28 @@ static DPL_Bound_Node *dpl_bind_unary_function_call(DPL_Binding *binding, DPL_Bo
     return NULL;
 }
 
+static DPL_Bound_Node *dpl_bind_binary_function_call(DPL_Binding *binding, DPL_Bound_Node *lhs, DPL_Bound_Node *rhs, const char *function_name)
+{
+    DPL_Symbol *function_symbol = dpl_symbols_find_function2_cstr(binding->symbols, function_name, lhs->type, rhs->type);
+
+    if (function_symbol)
+    {
+        dpl_bind_check_function_used(binding, function_symbol);
+
+        DPL_Bound_Node *bound_node = dpl_bind_allocate_node(binding, BOUND_NODE_FUNCTIONCALL,
+                                                            function_symbol->as.function.signature.returns);
+        bound_node->as.function_call.function = function_symbol;
+
+        DPL_Bound_Nodes temp_arguments = {0};
+        nob_da_append(&temp_arguments, lhs);
+        nob_da_append(&temp_arguments, rhs);
+        dpl_bind_move_nodelist(binding, temp_arguments, &bound_node->as.function_call.arguments_count, &bound_node->as.function_call.arguments);
+        return bound_node;
+    }
+
+    return NULL;
+}
+
 static DPL_Bound_Node *dpl_bind_unary(DPL_Binding *binding, DPL_Ast_Node *node, const char *function_name)
 {
     DPL_Bound_Node *operand = dpl_bind_node(binding, node->as.unary.operand);
@@ -629,20 +862,10 @@ static DPL_Bound_Node *dpl_bind_binary(DPL_Binding *binding, DPL_Ast_Node *node,
         DPL_AST_ERROR(binding->source, node, "Cannot bind right-hand side of binary expression.");
     }
 
-    DPL_Symbol *function_symbol = dpl_symbols_find_function2_cstr(binding->symbols, function_name, lhs->type, rhs->type);
-    if (function_symbol)
+    DPL_Bound_Node *bound_binary = dpl_bind_binary_function_call(binding, lhs, rhs, function_name);
+    if (bound_binary)
     {
-        dpl_bind_check_function_used(binding, function_symbol);
-
-        DPL_Bound_Node *bound_node = dpl_bind_allocate_node(binding, BOUND_NODE_FUNCTIONCALL,
-                                                            function_symbol->as.function.signature.returns);
-        bound_node->as.function_call.function = function_symbol;
-
-        DPL_Bound_Nodes temp_arguments = {0};
-        nob_da_append(&temp_arguments, lhs);
-        nob_da_append(&temp_arguments, rhs);
-        dpl_bind_move_nodelist(binding, temp_arguments, &bound_node->as.function_call.arguments_count, &bound_node->as.function_call.arguments);
-        return bound_node;
+        return bound_binary;
     }
 
     DPL_Token operator_token = node->as.binary.operator;
@@ -676,6 +899,13 @@ static DPL_Bound_Node *dpl_bind_function_call(DPL_Binding *binding, DPL_Ast_Node
 
     if (function_symbol)
     {
+        if (!function_symbol->as.function.signature.returns)
+        {
+            DPL_AST_ERROR(binding->source, node,
+                          "Function `" SV_Fmt "` is called recursively and therefore needs a declared return type.",
+                          SV_Arg(fc.name.text));
+        }
+
         dpl_bind_check_function_used(binding, function_symbol);
         bound_node->as.function_call.function = function_symbol;
         bound_node->type = function_symbol->as.function.signature.returns;
@@ -711,6 +941,11 @@ static DPL_Bound_Node *dpl_bind_scope(DPL_Binding *binding, DPL_Ast_Node *node)
     dpl_bind_begin_scope(binding);
     for (size_t i = 0; i < scope.expression_count; ++i)
     {
+        DPL_Binding_ScopeInfo *scope_info = &binding->scope_stack[binding->scope_stack_count - 1];
+        scope_info->current = scope.expressions[i];
+        scope_info->following = scope.expressions + i + 1;
+        scope_info->following_count = scope.expression_count - i - 1;
+
         DPL_Bound_Node *bound_expression = dpl_bind_node(binding, scope.expressions[i]);
         if (!bound_expression)
         {
@@ -758,6 +993,7 @@ DPL_Bound_Node *dpl_bind_object_literal(DPL_Binding *binding, DPL_Ast_Node *node
     DPL_Ast_ObjectLiteral object_literal = node->as.object_literal;
     DPL_Bound_ObjectFields tmp_bound_fields = {0};
     DPL_Bound_Nodes temporaries = {0};
+    DPL_Symbol *spread_var = NULL;
     for (size_t i = 0; i < object_literal.field_count; ++i)
     {
         DPL_Ast_Node *field = object_literal.fields[i];
@@ -780,6 +1016,7 @@ DPL_Bound_Node *dpl_bind_object_literal(DPL_Binding *binding, DPL_Ast_Node *node
             nob_da_append(&temporaries, bound_temporary);
 
             DPL_Symbol *var = dpl_symbols_push_var(binding->symbols, SV_NULL, bound_temporary->type);
+            spread_var = var;
 
             DPL_Symbol_Type_Object bound_object_type = bound_temporary->type->as.type.as.object;
             for (size_t i = 0; i < bound_object_type.field_count; ++i)
@@ -811,6 +1048,40 @@ DPL_Bound_Node *dpl_bind_object_literal(DPL_Binding *binding, DPL_Ast_Node *node
 
     DPL_Bound_Node *bound_node = dpl_bind_create_object_literal_move(binding, tmp_bound_fields);
 
+    if (temporaries.count == 1)
+    {
+        // `$[ ..p, x := p.x + 1 ]`: other reads of a spread local use the
+        // temporary as well, unless the local is assigned in between. This
+        // way, the temporary can hold the only reference to the object.
+        DPL_Bound_Node *spread = temporaries.items[0];
+        if (spread->kind == BOUND_NODE_VARREF || spread->kind == BOUND_NODE_ARGREF)
+        {
+            DPL_Bound_Nodes uses = {0};
+            for (size_t i = 0; i < bound_node->as.object.field_count; ++i)
+            {
+                dpl_bind_collect_uses(bound_node->as.object.fields[i].expression, spread->as.varref, &uses);
+            }
+
+            bool assigned = false;
+            for (size_t i = 0; i < uses.count; ++i)
+            {
+                assigned = assigned || uses.items[i]->kind == BOUND_NODE_ASSIGNMENT;
+            }
+            for (size_t i = 0; i < uses.count && !assigned; ++i)
+            {
+                uses.items[i]->kind = BOUND_NODE_VARREF;
+                uses.items[i]->as.varref = spread_var->as.var.scope_index;
+            }
+            nob_da_free(uses);
+        }
+
+        // The spread temporary goes away with the literal.
+        if (dpl_symbols_resolve_type_alias(spread_var->as.var.type) == dpl_symbols_resolve_type_alias(bound_node->type))
+        {
+            bound_node->as.object.reuse = dpl_bind_create_varref(binding, spread_var);
+        }
+    }
+
     dpl_bind_end_scope(binding);
 
     if (temporaries.count > 0)
@@ -872,7 +1143,7 @@ DPL_Bound_Node *dpl_bind_array_literal(DPL_Binding *binding, DPL_Ast_Node *node)
     DPL_Symbol *array_type = dpl_symbols_find_type_empty_array(binding->symbols);
     if (array_literal->element_count > 0)
     {
-        array_type = dpl_symbols_check_type_array_query(binding->symbols, tmp_elements.items[0]->type);
+        array_type = dpl_symbols_check_type_array_query(binding->symbols, tmp_element_type);
     }
 
     DPL_Bound_Node *bound_node = dpl_bind_allocate_node(
@@ -908,9 +1179,21 @@ static DPL_Bound_Node *dpl_bind_literal(DPL_Binding *binding, DPL_Ast_Node *node
 
 static DPL_Bound_Node *dpl_bind_field_access(DPL_Binding *binding, DPL_Ast_Node *node)
 {
-    DPL_Bound_Node *bound_expression = dpl_bind_node(binding, node->as.field_access.expression);
+    DPL_Bound_Node *bound_expression = NULL;
+    DPL_Symbol *bound_type = NULL;
+
+    DPL_Symbol *scalar_var = dpl_bind_find_scalar_var(binding, node->as.field_access.expression);
+    if (scalar_var)
+    {
+        bound_type = scalar_var->as.var.type;
+    }
+    else
+    {
+        bound_expression = dpl_bind_node(binding, node->as.field_access.expression);
+        bound_type = bound_expression->type;
+    }
 
-    DPL_Symbol *expression_type = bound_expression->type;
+    DPL_Symbol *expression_type = bound_type;
     if (expression_type->as.type.kind == TYPE_ALIAS)
     {
         expression_type = expression_type->as.type.as.alias;
@@ -920,7 +1203,7 @@ static DPL_Bound_Node *dpl_bind_field_access(DPL_Binding *binding, DPL_Ast_Node
     {
         DPL_AST_ERROR(binding->source, node->as.field_access.expression,
                       "Can access fields only for object types." SV_Fmt,
-                      SV_Arg(bound_expression->type->name));
+                      SV_Arg(bound_type->name));
     }
 
     DPL_Token field_name = node->as.field_access.field->as.symbol;
@@ -941,9 +1224,13 @@ static DPL_Bound_Node *dpl_bind_field_access(DPL_Binding *binding, DPL_Ast_Node
     if (!field_found)
     {
         DPL_AST_ERROR(binding->source, node, "Objects of type `" SV_Fmt "`, have no field `" SV_Fmt "`.",
-                      SV_Arg(bound_expression->type->name), SV_Arg(field_name.text));
+                      SV_Arg(bound_type->name), SV_Arg(field_name.text));
     }
 
+    if (scalar_var)
+    {
+        return dpl_bind_create_scalar_field(binding, scalar_var, field_index);
+    }
     return dpl_bind_create_load_field(binding, bound_expression, field_index);
 }
 
@@ -1038,6 +1325,122 @@ DPL_Bound_Node *dpl_bind_binary_operator(DPL_Binding *binding, DPL_Ast_Node *nod
                   dpl_lexer_token_kind_name(operator.kind));
 }
 
+static bool dpl_bind_uses_fields_only_list(DPL_Ast_Node **nodes, size_t count, Nob_String_View name, bool range);
+
+// Whether `node` uses the variable `name` only to access its fields. Ranges may
+// also be iterated in for loops. Anything declaring the same name is treated as
+// another use.
+static bool dpl_bind_uses_fields_only(DPL_Ast_Node *node, Nob_String_View name, bool range)
+{
+    if (!node)
+    {
+        return true;
+    }
+
+    switch (node->kind)
+    {
+    case AST_NODE_LITERAL:
+        return true;
+    case AST_NODE_SYMBOL:
+        return !nob_sv_eq(node->as.symbol.text, name);
+    case AST_NODE_FIELD_ACCESS:
+    {
+        DPL_Ast_Node *expression = node->as.field_access.expression;
+        return (expression->kind == AST_NODE_SYMBOL && nob_sv_eq(expression->as.symbol.text, name))
+            || dpl_bind_uses_fields_only(expression, name, range);
+    }
+    case AST_NODE_OBJECT_LITERAL:
+        return dpl_bind_uses_fields_only_list(node->as.object_literal.fields, node->as.object_literal.field_count, name, range);
+    case AST_NODE_ARRAY_LITERAL:
+        return dpl_bind_uses_fields_only_list(node->as.array_literal.elements, node->as.array_literal.element_count, name, range);
+    case AST_NODE_UNARY:
+        return dpl_bind_uses_fields_only(node->as.unary.operand, name, range);
+    case AST_NODE_BINARY:
+        return dpl_bind_uses_fields_only(node->as.binary.left, name, range)
+            && dpl_bind_uses_fields_only(node->as.binary.right, name, range);
+    case AST_NODE_FUNCTIONCALL:
+        return dpl_bind_uses_fields_only_list(node->as.function_call.arguments, node->as.function_call.argument_count, name, range);
+    case AST_NODE_SCOPE:
+        return dpl_bind_uses_fields_only_list(node->as.scope.expressions, node->as.scope.expression_count, name, range);
+    case AST_NODE_INTERPOLATION:
+        return dpl_bind_uses_fields_only_list(node->as.interpolation.expressions, node->as.interpolation.expression_count, name, range);
+    case AST_NODE_DECLARATION:
+        return !nob_sv_eq(node->as.declaration.name.text, name)
+            && dpl_bind_uses_fields_only(node->as.declaration.initialization, name, range);
+    case AST_NODE_ASSIGNMENT:
+        return dpl_bind_uses_fields_only(node->as.assignment.target, name, range)
+            && dpl_bind_uses_fields_only(node->as.assignment.expression, name, range);
+    case AST_NODE_FUNCTION:
+    {
+        DPL_Ast_Function *function = &node->as.function;
+        for (size_t i = 0; i < function->signature.argument_count; ++i)
+        {
+            if (nob_sv_eq(function->signature.arguments[i].name.text, name))
+            {
+                return false;
+            }
+        }
+        return !nob_sv_eq(function->name.text, name)
+            && dpl_bind_uses_fields_only(function->body, name, range);
+    }
+    case AST_NODE_CONDITIONAL:
+        return dpl_bind_uses_fields_only(node->as.conditional.condition, name, range)
+            && dpl_bind_uses_fields_only(node->as.conditional.then_clause, name, range)
+            && dpl_bind_uses_fields_only(node->as.conditional.else_clause, name, range);
+    case AST_NODE_WHILE_LOOP:
+        return dpl_bind_uses_fields_only(node->as.while_loop.condition, name, range)
+            && dpl_bind_uses_fields_only(node->as.while_loop.body, name, range);
+    case AST_NODE_FOR_LOOP:
+    {
+        DPL_Ast_ForLoop *for_loop = &node->as.for_loop;
+        DPL_Ast_Node *initializer = for_loop->iterator_initializer;
+        bool iterates_range = range && initializer->kind == AST_NODE_SYMBOL && nob_sv_eq(initializer->as.symbol.text, name);
+        return !nob_sv_eq(for_loop->variable_name.text, name)
+            && (iterates_range || dpl_bind_uses_fields_only(initializer, name, range))
+            && dpl_bind_uses_fields_only(for_loop->body, name, range);
+    }
+    default:
+        return false;
+    }
+}
+
+static bool dpl_bind_uses_fields_only_list(DPL_Ast_Node **nodes, size_t count, Nob_String_View name, bool range)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!dpl_bind_uses_fields_only(nodes[i], name, range))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Escape analysis for `var name := $[ ... ]`: when the rest of the enclosing
+// scope only reads fields of the variable, the object cannot escape and its
+// fields can be kept in locals instead.
+static bool dpl_bind_is_scalar_declaration(DPL_Binding *binding, DPL_Ast_Node *node, DPL_Bound_Node *expression)
+{
+    if (expression->kind != BOUND_NODE_OBJECT || expression->as.object.field_count == 0 || binding->scope_stack_count == 0)
+    {
+        return false;
+    }
+
+    // The last expression of a scope is its result.
+    DPL_Binding_ScopeInfo *scope_info = &binding->scope_stack[binding->scope_stack_count - 1];
+    if (scope_info->current != node || scope_info->following_count == 0)
+    {
+        return false;
+    }
+
+    DPL_Symbol *iterator_function = dpl_symbols_find_function1_cstr(binding->symbols, "iterator", expression->type);
+    bool range = iterator_function
+        && iterator_function->as.function.kind == FUNCTION_INTRINSIC
+        && iterator_function->as.function.as.intrinsic_function == INTRINSIC_NUMBERRANGE_ITERATOR;
+
+    return dpl_bind_uses_fields_only_list(scope_info->following, scope_info->following_count, node->as.declaration.name.text, range);
+}
+
 DPL_Bound_Node *dpl_bind_declaration(DPL_Binding *binding, DPL_Ast_Node *node)
 {
     DPL_Ast_Declaration *decl = &node->as.declaration;
@@ -1060,7 +1463,17 @@ DPL_Bound_Node *dpl_bind_declaration(DPL_Binding *binding, DPL_Ast_Node *node)
         expression->persistent = true;
         dpl_bind_check_assignment(binding, "variable", node, expression->type);
 
-        dpl_symbols_push_var(binding->symbols, decl->name.text, expression->type);
+        DPL_Symbol *var = dpl_symbols_push_var(binding->symbols, decl->name.text, expression->type);
+        if (dpl_bind_is_scalar_declaration(binding, node, expression))
+        {
+            // The variable holds the first field, the others follow it.
+            expression->as.object.scalar = true;
+            var->as.var.scalar = true;
+            for (size_t i = 1; i < expression->as.object.field_count; ++i)
+            {
+                dpl_symbols_push_var(binding->symbols, SV_NULL, expression->as.object.fields[i].expression->type);
+            }
+        }
 
         dpl_bind_end_assignment(binding);
 
@@ -1167,17 +1580,20 @@ DPL_Bound_Node *dpl_bind_function(DPL_Binding *binding, DPL_Ast_Node *node)
 
     dpl_symbols_push_boundary_cstr(binding->symbols, NULL, BOUNDARY_FUNCTION);
 
+    size_t *argument_indices = arena_alloc(binding->memory, sizeof(size_t) * (function->signature.argument_count + 1));
     for (size_t i = 0; i < function->signature.argument_count; ++i)
     {
-        dpl_symbols_push_argument(binding->symbols, function->signature.arguments[i].name.text,
-                                  function_symbol->as.function.signature.arguments[i]);
+        DPL_Symbol *argument = dpl_symbols_push_argument(binding->symbols, function->signature.arguments[i].name.text,
+                                                         function_symbol->as.function.signature.arguments[i]);
+        argument_indices[i] = argument->as.argument.scope_index;
     }
 
-    DPL_Bound_Node *bound_body = dpl_bind_node(binding, function->body);
-
+    // The declared return type is resolved before binding the body, so that
+    // the function can call itself recursively.
+    DPL_Symbol *return_type = NULL;
     if (function->signature.type)
     {
-        DPL_Symbol *return_type = dpl_symbols_resolve_type_alias(dpl_bind_type(binding, function->signature.type));
+        return_type = dpl_symbols_resolve_type_alias(dpl_bind_type(binding, function->signature.type));
         if (!return_type)
         {
             DPL_AST_ERROR(binding->source, function->signature.type,
@@ -1185,6 +1601,13 @@ DPL_Bound_Node *dpl_bind_function(DPL_Binding *binding, DPL_Ast_Node *node)
                           dpl_bind_type_name(function->signature.type));
         }
 
+        function_symbol->as.function.signature.returns = return_type;
+    }
+
+    DPL_Bound_Node *bound_body = dpl_bind_node(binding, function->body);
+
+    if (return_type)
+    {
         if (return_type != bound_body->type)
         {
             DPL_AST_ERROR(binding->source, node,
@@ -1193,14 +1616,24 @@ DPL_Bound_Node *dpl_bind_function(DPL_Binding *binding, DPL_Ast_Node *node)
                           SV_Arg(function->name.text),
                           SV_Arg(bound_body->type->name));
         }
-
-        function_symbol->as.function.signature.returns = return_type;
     }
     else
     {
         function_symbol->as.function.signature.returns = bound_body->type;
     }
 
+    // Arguments are released when the function returns. Objects created as its
+    // result may reuse one of them, and their last reads can be moves.
+    for (size_t i = 0; i < function->signature.argument_count; ++i)
+    {
+        dpl_bind_reuse_local(binding, bound_body, BOUND_NODE_ARGREF,
+                             function_symbol->as.function.signature.arguments[i], argument_indices[i]);
+    }
+    for (size_t i = 0; i < function->signature.argument_count; ++i)
+    {
+        dpl_bind_move_single_read(bound_body, argument_indices[i]);
+    }
+
     function_symbol->as.function.as.user_function.body = bound_body;
 
     dpl_symbols_pop_boundary(binding->symbols);
@@ -1316,25 +1749,151 @@ bool dpl_bind_resolve_iterator(DPL_Binding *binding, DPL_Symbol *type, DPL_Bindi
     return true;
 }
 
+// Binds the scope executed for each element of a for loop: `current` yields
+// the value of the loop variable, `advance` moves on after the body.
+static DPL_Bound_Node *dpl_bind_for_loop_body(DPL_Binding *binding, DPL_Ast_ForLoop *for_loop, DPL_Symbol *value_type,
+                                              DPL_Bound_Node *current, DPL_Bound_Node *advance)
+{
+    dpl_bind_begin_scope(binding);
+
+    dpl_symbols_push_var(binding->symbols, for_loop->variable_name.text, value_type);
+    current->persistent = true;
+
+    DPL_Bound_Node *inner_body = dpl_bind_node(binding, for_loop->body);
+    inner_body->persistent = true;
+    DPL_Symbol *inner_body_result_var = dpl_symbols_push_var(binding->symbols, SV_NULL, inner_body->type);
+    DPL_Bound_Node *inner_body_varref = dpl_bind_create_varref(binding, inner_body_result_var);
+
+    dpl_bind_end_scope(binding);
+
+    return dpl_bind_create_scope(binding, DPL_BOUND_NODES(current, inner_body, advance, inner_body_varref));
+}
+
+// Loops over number ranges and arrays do not create iterator objects. They
+// keep their position in two stack slots, which are checked by a
+// BOUND_NODE_ITERATE condition and advanced by adding 1 to the counter.
+static void dpl_bind_counted_for_loop(DPL_Binding *binding, DPL_Ast_ForLoop *for_loop,
+                                      DPL_Intrinsic_Kind iterator_kind, DPL_Symbol *value_type,
+                                      DPL_Bound_Node *bound_iterator_initializer, DPL_Bound_Node *range_from, DPL_Bound_Node *range_to,
+                                      DPL_Bound_Nodes *expressions, DPL_Bound_Node **condition, DPL_Bound_Node **body)
+{
+    DPL_Symbol *number_t = dpl_symbols_find_type_number(binding->symbols);
+    DPL_Symbol *counter_var = NULL;
+    DPL_Bound_Node *current = NULL;
+
+    if (iterator_kind == INTRINSIC_NUMBERRANGE_ITERATOR)
+    {
+        if (!range_from)
+        {
+            bound_iterator_initializer->persistent = true;
+            nob_da_append(expressions, bound_iterator_initializer);
+            DPL_Symbol *range_var = dpl_symbols_push_var(binding->symbols, SV_NULL, bound_iterator_initializer->type);
+
+            // Range<Number> has the fields `from` and `to`, in this order.
+            range_from = dpl_bind_create_load_field(binding, dpl_bind_create_varref(binding, range_var), 0);
+            range_to = dpl_bind_create_load_field(binding, dpl_bind_create_varref(binding, range_var), 1);
+        }
+
+        range_from->persistent = true;
+        nob_da_append(expressions, range_from);
+        counter_var = dpl_symbols_push_var(binding->symbols, SV_NULL, number_t);
+
+        range_to->persistent = true;
+        nob_da_append(expressions, range_to);
+        dpl_symbols_push_var(binding->symbols, SV_NULL, number_t);
+
+        dpl_symbols_push_var_cstr(binding->symbols, "", TYPENAME_NONE);
+
+        *condition = dpl_bind_create_iterate(binding, ITERATE_RANGE, counter_var);
+        current = dpl_bind_create_varref(binding, counter_var);
+    }
+    else
+    {
+        bound_iterator_initializer->persistent = true;
+        nob_da_append(expressions, bound_iterator_initializer);
+        DPL_Symbol *array_var = dpl_symbols_push_var(binding->symbols, SV_NULL, bound_iterator_initializer->type);
+
+        DPL_Bound_Node *index_initializer = dpl_bind_create_number(binding, 0);
+        index_initializer->persistent = true;
+        nob_da_append(expressions, index_initializer);
+        counter_var = dpl_symbols_push_var(binding->symbols, SV_NULL, number_t);
+
+        dpl_symbols_push_var_cstr(binding->symbols, "", TYPENAME_NONE);
+
+        *condition = dpl_bind_create_iterate(binding, ITERATE_ARRAY, array_var);
+        current = dpl_bind_binary_function_call(
+            binding,
+            dpl_bind_create_varref(binding, array_var),
+            dpl_bind_create_varref(binding, counter_var),
+            "element");
+    }
+
+    DPL_Bound_Node *advance = dpl_bind_create_assignment(
+        binding,
+        counter_var,
+        dpl_bind_binary_function_call(
+            binding,
+            dpl_bind_create_varref(binding, counter_var),
+            dpl_bind_create_number(binding, 1),
+            "add"));
+
+    *body = dpl_bind_for_loop_body(binding, for_loop, value_type, current, advance);
+}
+
 DPL_Bound_Node *dpl_bind_for_loop(DPL_Binding *binding, DPL_Ast_Node *node)
 {
     DPL_Ast_ForLoop *for_loop = &node->as.for_loop;
 
     dpl_bind_begin_scope(binding);
 
-    DPL_Bound_Node *bound_iterator_initializer = dpl_bind_node(binding, for_loop->iterator_initializer);
+    DPL_Bound_Node *bound_iterator_initializer = NULL;
+    DPL_Bound_Node *range_from = NULL;
+    DPL_Bound_Node *range_to = NULL;
+
+    DPL_Ast_Node *iterator_initializer = for_loop->iterator_initializer;
+    DPL_Symbol *scalar_var = dpl_bind_find_scalar_var(binding, iterator_initializer);
+    if (scalar_var)
+    {
+        // Ranges in scalar variables are only iterated, so the bounds are read
+        // from their locals. Range<Number> has the fields `from` and `to`, in
+        // this order.
+        range_from = dpl_bind_create_scalar_field(binding, scalar_var, 0);
+        range_to = dpl_bind_create_scalar_field(binding, scalar_var, 1);
+    }
+    else if (iterator_initializer->kind == AST_NODE_BINARY && iterator_initializer->as.binary.operator.kind == TOKEN_DOT_DOT)
+    {
+        // Range literals are bound here, so that a counted loop can store the
+        // bounds directly. The upper bound is evaluated above the lower one.
+        range_from = dpl_bind_node(binding, iterator_initializer->as.binary.left);
+        dpl_bind_begin_scope(binding);
+        dpl_symbols_push_var(binding->symbols, SV_NULL, range_from->type);
+        range_to = dpl_bind_node(binding, iterator_initializer->as.binary.right);
+        dpl_bind_end_scope(binding);
+    }
+    else
+    {
+        bound_iterator_initializer = dpl_bind_node(binding, iterator_initializer);
+    }
+
+    if (range_from)
+    {
+        DPL_Bound_ObjectFields bound_fields = {0};
+        dpl_bind_object_literal_add_field(binding, &bound_fields, nob_sv_from_cstr("from"), range_from);
+        dpl_bind_object_literal_add_field(binding, &bound_fields, nob_sv_from_cstr("to"), range_to);
+        bound_iterator_initializer = dpl_bind_create_object_literal_move(binding, bound_fields);
+    }
     DPL_Symbol *iterator_type = bound_iterator_initializer->type;
 
+    DPL_Bound_Nodes expressions = {0};
+    DPL_Bound_Node *while_condition = NULL;
+    DPL_Bound_Node *while_body = NULL;
+
     DPL_Binding_ResolvedIterator iterator;
+    DPL_Symbol *iterator_function = NULL;
     if (!dpl_bind_resolve_iterator(binding, iterator_type, &iterator))
     {
-        DPL_Symbol *iterator_function = dpl_symbols_find_function1_cstr(binding->symbols, "iterator", iterator_type);
-        if (iterator_function && dpl_bind_resolve_iterator(binding, iterator_function->as.function.signature.returns, &iterator))
-        {
-            bound_iterator_initializer = dpl_bind_unary_function_call(binding, bound_iterator_initializer, "iterator");
-            iterator_type = bound_iterator_initializer->type;
-        }
-        else
+        iterator_function = dpl_symbols_find_function1_cstr(binding->symbols, "iterator", iterator_type);
+        if (!iterator_function || !dpl_bind_resolve_iterator(binding, iterator_function->as.function.signature.returns, &iterator))
         {
             DPL_AST_ERROR(binding->source, for_loop->iterator_initializer,
                           "Expression in for loop cannot be resolved  to an iterator.\n"
@@ -1349,56 +1908,56 @@ DPL_Bound_Node *dpl_bind_for_loop(DPL_Binding *binding, DPL_Ast_Node *node)
         }
     }
 
-    DPL_Symbol *iterator_var = dpl_symbols_push_var(binding->symbols, SV_NULL, iterator_type);
-    DPL_Bound_Node *init_assignment = bound_iterator_initializer;
-    init_assignment->persistent = true;
-
-    dpl_symbols_push_var_cstr(binding->symbols, "", TYPENAME_NONE);
-
-    DPL_Bound_Node *while_condition = dpl_bind_unary_function_call(
-        binding,
-        dpl_bind_create_load_field(
-            binding,
-            dpl_bind_create_varref(binding, iterator_var),
-            iterator.finished_index),
-        "not");
+    if (iterator_function && iterator_function->as.function.kind == FUNCTION_INTRINSIC &&
+        (iterator_function->as.function.as.intrinsic_function == INTRINSIC_NUMBERRANGE_ITERATOR ||
+         iterator_function->as.function.as.intrinsic_function == INTRINSIC_ARRAY_ITERATOR))
+    {
+        dpl_bind_counted_for_loop(binding, for_loop, iterator_function->as.function.as.intrinsic_function,
+                                  iterator.value_type, bound_iterator_initializer, range_from, range_to,
+                                  &expressions, &while_condition, &while_body);
+    }
+    else
+    {
+        if (iterator_function)
+        {
+            bound_iterator_initializer = dpl_bind_unary_function_call(binding, bound_iterator_initializer, "iterator");
+            iterator_type = bound_iterator_initializer->type;
+        }
 
-    dpl_bind_begin_scope(binding);
+        DPL_Symbol *iterator_var = dpl_symbols_push_var(binding->symbols, SV_NULL, iterator_type);
+        bound_iterator_initializer->persistent = true;
+        nob_da_append(&expressions, bound_iterator_initializer);
 
-    dpl_symbols_push_var(binding->symbols, for_loop->variable_name.text, iterator.value_type);
-    DPL_Bound_Node *current_assignment = dpl_bind_create_load_field(
-        binding,
-        dpl_bind_create_varref(binding, iterator_var),
-        iterator.current_index);
-    current_assignment->persistent = true;
+        dpl_symbols_push_var_cstr(binding->symbols, "", TYPENAME_NONE);
 
-    DPL_Bound_Node *inner_body = dpl_bind_node(binding, for_loop->body);
-    inner_body->persistent = true;
-    DPL_Symbol *inner_body_result_var = dpl_symbols_push_var(binding->symbols, SV_NULL, inner_body->type);
+        while_condition = dpl_bind_unary_function_call(
+            binding,
+            dpl_bind_create_load_field(
+                binding,
+                dpl_bind_create_varref(binding, iterator_var),
+                iterator.finished_index),
+            "not");
 
-    DPL_Bound_Node *next_assignment = dpl_bind_create_assignment(
-        binding,
-        iterator_var,
-        dpl_bind_unary_function_call(
+        DPL_Bound_Node *current_assignment = dpl_bind_create_load_field(
             binding,
             dpl_bind_create_varref(binding, iterator_var),
-            "next"));
+            iterator.current_index);
 
-    DPL_Bound_Node *inner_body_varref = dpl_bind_create_varref(binding, inner_body_result_var);
-
-    dpl_bind_end_scope(binding);
-    dpl_bind_end_scope(binding);
-
-    DPL_Bound_Node *while_loop = dpl_bind_create_while_loop(
-        binding,
-        while_condition,
-        dpl_bind_create_scope(binding,
-            DPL_BOUND_NODES(current_assignment, inner_body, next_assignment, inner_body_varref)));
+        DPL_Bound_Node *next_assignment = dpl_bind_create_assignment(
+            binding,
+            iterator_var,
+            dpl_bind_unary_function_call(
+                binding,
+                dpl_bind_create_varref(binding, iterator_var),
+                "next"));
 
-    DPL_Bound_Node *scope = dpl_bind_create_scope(binding, DPL_BOUND_NODES(init_assignment, while_loop));
+        while_body = dpl_bind_for_loop_body(binding, for_loop, iterator.value_type, current_assignment, next_assignment);
+    }
 
+    dpl_bind_end_scope(binding);
 
-    return scope;
+    nob_da_append(&expressions, dpl_bind_create_while_loop(binding, while_condition, while_body));
+    return dpl_bind_create_scope_move(binding, expressions);
 }
 
 DPL_Bound_Node *dpl_bind_interpolation(DPL_Binding *binding, DPL_Ast_Node *node)
@@ -1544,7 +2103,7 @@ void dpl_bind_print(DPL_Binding *binding, DPL_Bound_Node *node, size_t level)
     break;
     case BOUND_NODE_OBJECT:
     {
-        printf("$object(\n");
+        printf(node->as.object.scalar ? "$scalar_object(\n" : "$object(\n");
 
         DPL_Bound_Object object = node->as.object;
         for (size_t field_index = 0; field_index < object.field_count; ++field_index)
@@ -1655,6 +2214,12 @@ void dpl_bind_print(DPL_Binding *binding, DPL_Bound_Node *node, size_t level)
         printf(")\n");
     }
     break;
+    case BOUND_NODE_ITERATE:
+    {
+        printf("$iterate_%s(scope_index = %zu)\n", (node->as.iterate.kind == ITERATE_RANGE) ? "range" : "array",
+               node->as.iterate.scope_index);
+    }
+    break;
     case BOUND_NODE_LOAD_FIELD:
     {
         printf("$load_field( #%zu\n", node->as.load_field.field_index);
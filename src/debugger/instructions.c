@@ -43,22 +43,25 @@ void dplg_load_instructions(DPLG_Instructions* instructions, DPL_Program* progra
             instruction.parameter_count = 1;
             break;
         case INST_PUSH_LOCAL:
+        case INST_PUSH_LOCAL_MOVE:
             instruction.parameter0 = dpl_value_make_number(bs_read_u64(&code));
             instruction.parameter_count = 1;
             break;
         case INST_CREATE_OBJECT:
-            instruction.parameter0 = dpl_value_make_number(bs_read_u8(&code));
+            instruction.parameter0 = dpl_value_make_number(bs_read_u32(&code));
             instruction.parameter_count = 1;
             break;
         case INST_LOAD_FIELD:
-            instruction.parameter0 = dpl_value_make_number(bs_read_u8(&code));
+        case INST_LOAD_FIELD_NUMBER:
+        case INST_LOAD_FIELD_BOOLEAN:
+            instruction.parameter0 = dpl_value_make_number(bs_read_u32(&code));
             instruction.parameter_count = 1;
             break;
         case INST_NOOP:
         case INST_POP:
         case INST_NEGATE:
         case INST_NOT:
-        case INST_ADD:
+        case INST_ADD_NUMBER:
         case INST_SUBTRACT:
         case INST_MULTIPLY:
         case INST_DIVIDE:
@@ -66,8 +69,13 @@ void dplg_load_instructions(DPLG_Instructions* instructions, DPL_Program* progra
         case INST_LESS_EQUAL:
         case INST_GREATER:
         case INST_GREATER_EQUAL:
-        case INST_EQUAL:
-        case INST_NOT_EQUAL:
+        case INST_EQUAL_NUMBER:
+        case INST_NOT_EQUAL_NUMBER:
+        case INST_EQUAL_STRING:
+        case INST_NOT_EQUAL_STRING:
+        case INST_EQUAL_BOOLEAN:
+        case INST_NOT_EQUAL_BOOLEAN:
+        case INST_CONCAT_STRING:
         case INST_RETURN:
         case INST_BEGIN_ARRAY:
         case INST_END_ARRAY:
@@ -81,11 +89,15 @@ void dplg_load_instructions(DPLG_Instructions* instructions, DPL_Program* progra
             instruction.parameter_count = 1;
             break;
         case INST_CALL_USER:
+        case INST_TAIL_CALL_USER:
             instruction.parameter0 = dpl_value_make_number(bs_read_u8(&code));
             instruction.parameter1 = dpl_value_make_number(bs_read_u64(&code));
             instruction.parameter_count = 2;
             break;
         case INST_STORE_LOCAL:
+        case INST_ITERATE_RANGE:
+        case INST_ITERATE_ARRAY:
+        case INST_APPEND_LOCAL:
             instruction.parameter0 = dpl_value_make_number(bs_read_u64(&code));
             instruction.parameter_count = 1;
             break;
@@ -101,7 +113,34 @@ void dplg_load_instructions(DPLG_Instructions* instructions, DPL_Program* progra
             instruction.parameter_count = 1;
             break;
         case INST_INTERPOLATION:
-            instruction.parameter0 = dpl_value_make_number(bs_read_u8(&code));
+            instruction.parameter0 = dpl_value_make_number(bs_read_u32(&code));
+            instruction.parameter_count = 1;
+            break;
+        case INST_ADD_LOCAL_NUMBER:
+            instruction.parameter0 = dpl_value_make_number(bs_read_u64(&code));
+            instruction.parameter1 = dpl_value_make_number(bs_read_f64(&code));
+            bs_read_u64(&code);
+            instruction.parameter_count = 2;
+            break;
+        case INST_LOAD_LOCAL_FIELD:
+        case INST_LOAD_LOCAL_FIELD_NUMBER:
+        case INST_LOAD_LOCAL_FIELD_BOOLEAN:
+            instruction.parameter0 = dpl_value_make_number(bs_read_u64(&code));
+            instruction.parameter1 = dpl_value_make_number(bs_read_u32(&code));
+            instruction.parameter_count = 2;
+            break;
+        case INST_CREATE_OBJECT_REUSE:
+            instruction.parameter0 = dpl_value_make_number(bs_read_u32(&code));
+            instruction.parameter1 = dpl_value_make_number(bs_read_u64(&code));
+            instruction.parameter_count = 2;
+            break;
+        case INST_EXTEND_ARRAY:
+            instruction.parameter0 = dpl_value_make_number(bs_read_u32(&code));
+            instruction.parameter1 = dpl_value_make_number(bs_read_u32(&code));
+            instruction.parameter_count = 2;
+            break;
+        case INST_LESS_JUMP_IF_FALSE:
+            instruction.parameter0 = dpl_value_make_number(bs_read_u16(&code));
             instruction.parameter_count = 1;
             break;
         default:
@@ -51,11 +51,10 @@ static void dplg_ui__append_value_number(Nob_String_Builder* sb, double value)
     nob_sb_append_cstr(sb, "]");
 }
 
-static void dplg_ui__append_value_string(Nob_String_Builder* sb, const DPL_MemoryValue *value)
+static void dplg_ui__append_value_string(Nob_String_Builder* sb, const DPL_Value value)
 {
     nob_sb_appendf(sb, "[%s: ", dpl_value_kind_name(VALUE_STRING));
-    const Nob_String_View sv = nob_sv_from_parts((char*)value->data, value->size);
-    dplg_ui__sb_append_sv_escaped(sb, sv);
+    dplg_ui__sb_append_sv_escaped(sb, dpl_value_string_sv(&value));
     nob_sb_append_cstr(sb, "]");
 }
 
@@ -94,26 +93,26 @@ static void dplg_ui__append_value_array(Nob_String_Builder* sb, DPL_MemoryValue*
 
 static void dplg_ui__append_value(Nob_String_Builder* sb, const DPL_Value value)
 {
-    switch (value.kind)
+    switch (dpl_value_kind(value))
     {
     case VALUE_NUMBER:
-        dplg_ui__append_value_number(sb, value.as.number);
+        dplg_ui__append_value_number(sb, dpl_value_as_number(value));
         break;
     case VALUE_STRING:
-        dplg_ui__append_value_string(sb, value.as.string);
+        dplg_ui__append_value_string(sb, value);
         break;
     case VALUE_BOOLEAN:
-        dplg_ui__append_value_boolean(sb, value.as.boolean);
+        dplg_ui__append_value_boolean(sb, dpl_value_as_boolean(value));
         break;
     case VALUE_OBJECT:
-        dplg_ui__append_value_object(sb, value.as.object);
+        dplg_ui__append_value_object(sb, dpl_value_as_object(value));
         break;
     case VALUE_ARRAY:
-        dplg_ui__append_value_array(sb, value.as.array);
+        dplg_ui__append_value_array(sb, dpl_value_as_array(value));
         break;
     default:
         DW_UNIMPLEMENTED_MSG("Cannot debug print value of kind `%s`.",
-                             dpl_value_kind_name(value.kind));
+                             dpl_value_kind_name(dpl_value_kind(value)));
     }
 }
 
@@ -134,7 +133,7 @@ int dplg_ui_find_active_instruction(const DPLG_Instructions* instructions,
 {
     for (size_t i = 0; i < instructions->count; i++)
     {
-        if (instructions->items[i].ip == state->vm->program_stream.position)
+        if (instructions->items[i].ip == dplv_instruction_ip(state->vm, state->vm->ip))
         {
             return i;
         }
@@ -164,7 +163,7 @@ static void dplg_ui__instruction_item(DPLG_Instruction* instruction, DPLG_UI_Ins
         .width = state->view.width,
         .height = instruction->bounds.height,
     };
-    if (instruction->ip == state->vm->program_stream.position)
+    if (instruction->ip == dplv_instruction_ip(state->vm, state->vm->ip))
     {
         DrawRectangleRec(bounds, DARKBLUE);
     }
@@ -452,17 +451,8 @@ void dplg_ui_stack(const Rectangle bounds, DPLG_UI_StackState* stack)
     dplg_ui__end_titled_group();
 }
 
-void dplg_ui_memory_calculate(const DPL_VirtualMachine* vm, DPLG_UI_MemoryState* memory)
+static void dplg_ui__memory_append_items(DPLG_UI_MemoryState* memory, DPL_MemoryValue* memory_value)
 {
-    memory->count = 0;
-
-    DPL_MemoryValue* memory_value = (memory->kind == MEMORY_ALLOCATED) ? vm->stack_pool.allocated : vm->stack_pool.freed;
-    if (memory_value == NULL)
-    {
-        const DPLG_UI_MemoryState_Item item = {0};
-        nob_da_append(memory, item);
-    }
-
     while (memory_value)
     {
         const DPLG_UI_MemoryState_Item item = {
@@ -475,6 +465,29 @@ void dplg_ui_memory_calculate(const DPL_VirtualMachine* vm, DPLG_UI_MemoryState*
         nob_da_append(memory, item);
         memory_value = memory_value->next;
     }
+}
+
+void dplg_ui_memory_calculate(const DPL_VirtualMachine* vm, DPLG_UI_MemoryState* memory)
+{
+    memory->count = 0;
+
+    if (memory->kind == MEMORY_ALLOCATED)
+    {
+        dplg_ui__memory_append_items(memory, vm->stack_pool.allocated);
+    }
+    else
+    {
+        for (size_t size_class = 0; size_class < DPL_MEMORYVALUE_POOL_SIZE_CLASSES; ++size_class)
+        {
+            dplg_ui__memory_append_items(memory, vm->stack_pool.freed[size_class]);
+        }
+    }
+
+    if (memory->count == 0)
+    {
+        const DPLG_UI_MemoryState_Item item = {0};
+        nob_da_append(memory, item);
+    }
 
     memory->bounds = (Rectangle) {
         .x = 0,
@@ -540,7 +553,7 @@ void dplg_ui_memory(const Rectangle bounds, DPLG_UI_MemoryState* memory)
                         GuiLabel(item_sizes_bounds, item_sizes);
 
                         const Rectangle item_ref_count_bounds = LayoutRectangle(RLD_REMAINING);
-                        const char* item_ref_count = TextFormat("%llu", item.ref_count);
+                        const char* item_ref_count = TextFormat("%zu", item.ref_count);
                         GuiLabel(item_ref_count_bounds, item_ref_count);
                     }
                     else
@@ -6,6 +6,8 @@
 
 #include <dpl.h>
 #include <dpl/utils.h>
+#include <dpl/emitter.h>
+#include <dpl/fusion.h>
 #include <dpl/generator.h>
 
 #define DPL_ERROR DW_ERROR
@@ -29,22 +31,23 @@ void dpl_init(DPL *dpl)
     dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "not", TYPENAME_BOOLEAN, DPL_ARGS(TYPENAME_BOOLEAN), INST_NOT);
 
     // binary operators
-    dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "add", TYPENAME_NUMBER, DPL_ARGS(TYPENAME_NUMBER, TYPENAME_NUMBER), INST_ADD);
+    dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "add", TYPENAME_NUMBER, DPL_ARGS(TYPENAME_NUMBER, TYPENAME_NUMBER), INST_ADD_NUMBER);
     dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "subtract", TYPENAME_NUMBER, DPL_ARGS(TYPENAME_NUMBER, TYPENAME_NUMBER), INST_SUBTRACT);
     dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "multiply", TYPENAME_NUMBER, DPL_ARGS(TYPENAME_NUMBER, TYPENAME_NUMBER), INST_MULTIPLY);
     dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "divide", TYPENAME_NUMBER, DPL_ARGS(TYPENAME_NUMBER, TYPENAME_NUMBER), INST_DIVIDE);
+    dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "add", TYPENAME_STRING, DPL_ARGS(TYPENAME_STRING, TYPENAME_STRING), INST_CONCAT_STRING);
 
     // comparison operators
     dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "less", TYPENAME_BOOLEAN, DPL_ARGS(TYPENAME_NUMBER, TYPENAME_NUMBER), INST_LESS);
     dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "lessEqual", TYPENAME_BOOLEAN, DPL_ARGS(TYPENAME_NUMBER, TYPENAME_NUMBER), INST_LESS_EQUAL);
     dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "greater", TYPENAME_BOOLEAN, DPL_ARGS(TYPENAME_NUMBER, TYPENAME_NUMBER), INST_GREATER);
     dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "greaterEqual", TYPENAME_BOOLEAN, DPL_ARGS(TYPENAME_NUMBER, TYPENAME_NUMBER), INST_GREATER_EQUAL);
-    dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "equal", TYPENAME_BOOLEAN, DPL_ARGS(TYPENAME_NUMBER, TYPENAME_NUMBER), INST_EQUAL);
-    dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "notEqual", TYPENAME_BOOLEAN, DPL_ARGS(TYPENAME_NUMBER, TYPENAME_NUMBER), INST_NOT_EQUAL);
-    dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "equal", TYPENAME_BOOLEAN, DPL_ARGS(TYPENAME_STRING, TYPENAME_STRING), INST_EQUAL);
-    dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "notEqual", TYPENAME_BOOLEAN, DPL_ARGS(TYPENAME_STRING, TYPENAME_STRING), INST_NOT_EQUAL);
-    dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "equal", TYPENAME_BOOLEAN, DPL_ARGS(TYPENAME_BOOLEAN, TYPENAME_BOOLEAN), INST_EQUAL);
-    dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "notEqual", TYPENAME_BOOLEAN, DPL_ARGS(TYPENAME_BOOLEAN, TYPENAME_BOOLEAN), INST_NOT_EQUAL);
+    dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "equal", TYPENAME_BOOLEAN, DPL_ARGS(TYPENAME_NUMBER, TYPENAME_NUMBER), INST_EQUAL_NUMBER);
+    dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "notEqual", TYPENAME_BOOLEAN, DPL_ARGS(TYPENAME_NUMBER, TYPENAME_NUMBER), INST_NOT_EQUAL_NUMBER);
+    dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "equal", TYPENAME_BOOLEAN, DPL_ARGS(TYPENAME_STRING, TYPENAME_STRING), INST_EQUAL_STRING);
+    dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "notEqual", TYPENAME_BOOLEAN, DPL_ARGS(TYPENAME_STRING, TYPENAME_STRING), INST_NOT_EQUAL_STRING);
+    dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "equal", TYPENAME_BOOLEAN, DPL_ARGS(TYPENAME_BOOLEAN, TYPENAME_BOOLEAN), INST_EQUAL_BOOLEAN);
+    dpl_symbols_push_function_instruction_cstr(&dpl->symbols, "notEqual", TYPENAME_BOOLEAN, DPL_ARGS(TYPENAME_BOOLEAN, TYPENAME_BOOLEAN), INST_NOT_EQUAL_BOOLEAN);
 
     // intrinsic functions
     DPL_Symbol_Type_ObjectQuery query = {0};
@@ -74,6 +77,15 @@ void dpl_init(DPL *dpl)
 
     dpl_symbols_push_function_intrinsic(&dpl->symbols, "length", number_t, DPL_SYMBOLS(string_t), INTRINSIC_STRING_LENGTH);
     dpl_symbols_push_function_intrinsic(&dpl->symbols, "print", string_t, DPL_SYMBOLS(string_t), INTRINSIC_STRING_PRINT);
+
+    DPL_Symbol *number_array_t = dpl_symbols_check_type_array_query(&dpl->symbols, number_t);
+    dpl_symbols_push_function_intrinsic(&dpl->symbols, "sum", number_t, DPL_SYMBOLS(number_array_t), INTRINSIC_NUMBERARRAY_SUM);
+    dpl_symbols_push_function_intrinsic(&dpl->symbols, "min", number_t, DPL_SYMBOLS(number_array_t), INTRINSIC_NUMBERARRAY_MIN);
+    dpl_symbols_push_function_intrinsic(&dpl->symbols, "max", number_t, DPL_SYMBOLS(number_array_t), INTRINSIC_NUMBERARRAY_MAX);
+    dpl_symbols_push_function_intrinsic(&dpl->symbols, "dot", number_t, DPL_SYMBOLS(number_array_t, number_array_t), INTRINSIC_NUMBERARRAY_DOT);
+    dpl_symbols_push_function_intrinsic(&dpl->symbols, "scale", number_array_t, DPL_SYMBOLS(number_array_t, number_t), INTRINSIC_NUMBERARRAY_SCALE);
+    dpl_symbols_push_function_intrinsic(&dpl->symbols, "add", number_array_t, DPL_SYMBOLS(number_array_t, number_array_t), INTRINSIC_NUMBERARRAY_ADD);
+    dpl_symbols_push_function_intrinsic(&dpl->symbols, "multiply", number_array_t, DPL_SYMBOLS(number_array_t, number_array_t), INTRINSIC_NUMBERARRAY_MULTIPLY);
 }
 
 void dpl_free(DPL *dpl)
@@ -84,7 +96,7 @@ void dpl_free(DPL *dpl)
 
 // COMPILATION PROCESS
 
-void dpl_compile(DPL *dpl, DPL_Program *program)
+static DPL_Bound_Node *_dpl_parse_and_bind(DPL *dpl, DPL_Binding *binding)
 {
     // lexer initialization
     DPL_Lexer lexer = {0};
@@ -104,42 +116,48 @@ void dpl_compile(DPL *dpl, DPL_Program *program)
         printf("\n");
     }
 
-    DPL_Binding binding = (DPL_Binding){
+    *binding = (DPL_Binding){
         .memory = dpl->memory,
         .source = dpl->source,
         .symbols = &dpl->symbols,
         .user_functions = {0},
     };
-    DPL_Bound_Node *bound_root_expression = dpl_bind_node(&binding, root_expression);
+    DPL_Bound_Node *bound_root_expression = dpl_bind_node(binding, root_expression);
 
     if (dpl->debug)
     {
-        for (size_t i = 0; i < binding.user_functions.count; ++i)
+        for (size_t i = 0; i < binding->user_functions.count; ++i)
         {
-            DPL_Binding_UserFunction *uf = &binding.user_functions.items[i];
+            DPL_Binding_UserFunction *uf = &binding->user_functions.items[i];
             printf("### " SV_Fmt " (arity: %zu) ###\n", SV_Arg(uf->function->name), uf->arity);
-            dpl_bind_print(&binding, uf->body, 0);
+            dpl_bind_print(binding, uf->body, 0);
             printf("\n");
         }
 
         printf("### program ###\n");
-        dpl_bind_print(&binding, bound_root_expression, 0);
+        dpl_bind_print(binding, bound_root_expression, 0);
         printf("\n");
     }
 
+    return bound_root_expression;
+}
+
+void dpl_compile(DPL *dpl, DPL_Program *program)
+{
+    DPL_Binding binding = {0};
+    DPL_Bound_Node *bound_root_expression = _dpl_parse_and_bind(dpl, &binding);
+
     DPL_Generator generator = {
         .user_functions = binding.user_functions,
     };
     for (size_t i = 0; i < generator.user_functions.count; ++i)
     {
-        DPL_Binding_UserFunction *uf = &generator.user_functions.items[i];
-        uf->begin_ip = program->code.count;
-        dpl_generate(&generator, uf->body, program);
-        dplp_write_return(program);
+        dpl_generate_function(&generator, &generator.user_functions.items[i], program);
     }
 
     program->entry = program->code.count;
     dpl_generate(&generator, bound_root_expression, program);
+    dpl_fuse(program);
     if (dpl->debug)
     {
         dplp_print(program);
@@ -153,4 +171,14 @@ void dpl_compile(DPL *dpl, DPL_Program *program)
     }
 
     nob_da_free(binding.user_functions);
-}
\ No newline at end of file
+}
+
+void dpl_compile_to_c(DPL *dpl, Nob_String_Builder *output)
+{
+    DPL_Binding binding = {0};
+    DPL_Bound_Node *bound_root_expression = _dpl_parse_and_bind(dpl, &binding);
+
+    dpl_emit_c(binding.user_functions, bound_root_expression, dpl->file_name, output);
+
+    nob_da_free(binding.user_functions);
+}
@@ -0,0 +1,833 @@
+#ifdef DPL_LEAKCHECK
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/emitter.h>
+#include <dw_error.h>
+
+typedef struct
+{
+    DPL_Binding_UserFunctions user_functions;
+    Nob_String_Builder *output;
+    size_t indent;
+    // Local variables are named after the slot the binder assigned to them,
+    // so references can be resolved by their scope index.
+    size_t slot_count;
+    size_t temporary_count;
+    // Set right before emitting a node whose value is directly returned from
+    // the user function `function_handle`. Calls to that function in this
+    // position jump back to its start instead of recursing.
+    bool tail;
+    size_t function_handle;
+    bool tail_called;
+    // Slots of the live locals holding values, released before such a jump.
+    struct
+    {
+        size_t *items;
+        size_t count;
+        size_t capacity;
+    } value_slots;
+} DPL_Emitter;
+
+static void _dpl_emit_node(DPL_Emitter *emitter, DPL_Bound_Node *node);
+
+static bool _dpl_emit_is_type(DPL_Symbol *type, DPL_Symbol_Type_Base_Kind kind)
+{
+    return dpl_symbols_is_type_base(dpl_symbols_resolve_type_alias(type), kind);
+}
+
+static bool _dpl_emit_is_value(DPL_Symbol *type)
+{
+    return !_dpl_emit_is_type(type, TYPE_BASE_NUMBER) && !_dpl_emit_is_type(type, TYPE_BASE_BOOLEAN);
+}
+
+static const char *_dpl_emit_ctype(DPL_Symbol *type)
+{
+    if (_dpl_emit_is_type(type, TYPE_BASE_NUMBER))
+    {
+        return "double";
+    }
+    if (_dpl_emit_is_type(type, TYPE_BASE_BOOLEAN))
+    {
+        return "bool";
+    }
+    return "DPL_Value";
+}
+
+static void _dpl_emit_newline(DPL_Emitter *emitter)
+{
+    nob_sb_append_cstr(emitter->output, "\n");
+    for (size_t i = 0; i < emitter->indent; ++i)
+    {
+        nob_sb_append_cstr(emitter->output, "    ");
+    }
+}
+
+static size_t _dpl_emit_temporary(DPL_Emitter *emitter)
+{
+    return emitter->temporary_count++;
+}
+
+// Emits `node` converted to a DPL_Value.
+static void _dpl_emit_boxed(DPL_Emitter *emitter, DPL_Bound_Node *node)
+{
+    if (_dpl_emit_is_type(node->type, TYPE_BASE_NUMBER))
+    {
+        nob_sb_append_cstr(emitter->output, "dpl_value_make_number(");
+        _dpl_emit_node(emitter, node);
+        nob_sb_append_cstr(emitter->output, ")");
+    }
+    else if (_dpl_emit_is_type(node->type, TYPE_BASE_BOOLEAN))
+    {
+        nob_sb_append_cstr(emitter->output, "dpl_value_make_boolean(");
+        _dpl_emit_node(emitter, node);
+        nob_sb_append_cstr(emitter->output, ")");
+    }
+    else
+    {
+        _dpl_emit_node(emitter, node);
+    }
+}
+
+static void _dpl_emit_boxed_temporary(DPL_Emitter *emitter, DPL_Symbol *type, size_t temporary)
+{
+    if (_dpl_emit_is_type(type, TYPE_BASE_NUMBER))
+    {
+        nob_sb_appendf(emitter->output, "dpl_value_make_number(t%zu)", temporary);
+    }
+    else if (_dpl_emit_is_type(type, TYPE_BASE_BOOLEAN))
+    {
+        nob_sb_appendf(emitter->output, "dpl_value_make_boolean(t%zu)", temporary);
+    }
+    else
+    {
+        nob_sb_appendf(emitter->output, "t%zu", temporary);
+    }
+}
+
+// Opens the conversion of a DPL_Value expression into the C type of `type`.
+static void _dpl_emit_unbox_begin(DPL_Emitter *emitter, DPL_Symbol *type)
+{
+    if (_dpl_emit_is_type(type, TYPE_BASE_NUMBER))
+    {
+        nob_sb_append_cstr(emitter->output, "dpl_value_as_number(");
+    }
+    else if (_dpl_emit_is_type(type, TYPE_BASE_BOOLEAN))
+    {
+        nob_sb_append_cstr(emitter->output, "dpl_value_as_boolean(");
+    }
+    else
+    {
+        nob_sb_append_cstr(emitter->output, "(");
+    }
+}
+
+// Evaluates `node` for its side effects only, releasing a resulting value.
+static void _dpl_emit_discard(DPL_Emitter *emitter, DPL_Bound_Node *node)
+{
+    if (_dpl_emit_is_value(node->type))
+    {
+        nob_sb_append_cstr(emitter->output, "dplv_release(&vm, ");
+    }
+    else
+    {
+        nob_sb_append_cstr(emitter->output, "(void)(");
+    }
+    _dpl_emit_node(emitter, node);
+    nob_sb_append_cstr(emitter->output, ");");
+}
+
+static void _dpl_emit_number(DPL_Emitter *emitter, double value)
+{
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.17g", value);
+    nob_sb_append_cstr(emitter->output, buffer);
+    if (strpbrk(buffer, ".eni") == NULL)
+    {
+        nob_sb_append_cstr(emitter->output, ".0");
+    }
+}
+
+static void _dpl_emit_string(DPL_Emitter *emitter, const char *value)
+{
+    size_t length = strlen(value);
+    nob_sb_appendf(emitter->output, "dpl_value_make_string(&vm.stack_pool, %zu, \"", length);
+    for (size_t i = 0; i < length; ++i)
+    {
+        unsigned char c = value[i];
+        switch (c)
+        {
+        case '"':
+            nob_sb_append_cstr(emitter->output, "\\\"");
+            break;
+        case '\\':
+            nob_sb_append_cstr(emitter->output, "\\\\");
+            break;
+        case '\n':
+            nob_sb_append_cstr(emitter->output, "\\n");
+            break;
+        case '\r':
+            nob_sb_append_cstr(emitter->output, "\\r");
+            break;
+        case '\t':
+            nob_sb_append_cstr(emitter->output, "\\t");
+            break;
+        default:
+            if (c < 0x20 || c >= 0x7F || c == '?')
+            {
+                // Octal escapes never swallow following digits and avoid trigraphs.
+                nob_sb_appendf(emitter->output, "\\%03o", c);
+            }
+            else
+            {
+                nob_da_append(emitter->output, (char)c);
+            }
+        }
+    }
+    nob_sb_append_cstr(emitter->output, "\")");
+}
+
+static void _dpl_emit_instruction_call(DPL_Emitter *emitter, DPL_Instruction_Kind kind, size_t first)
+{
+    const char *binary_operator = NULL;
+    const char *comparison = NULL;
+
+    switch (kind)
+    {
+    case INST_NEGATE:
+        nob_sb_appendf(emitter->output, "-t%zu", first);
+        return;
+    case INST_NOT:
+        nob_sb_appendf(emitter->output, "!t%zu", first);
+        return;
+    case INST_ADD_NUMBER:
+        binary_operator = "+";
+        break;
+    case INST_SUBTRACT:
+        binary_operator = "-";
+        break;
+    case INST_MULTIPLY:
+        binary_operator = "*";
+        break;
+    case INST_DIVIDE:
+        binary_operator = "/";
+        break;
+    case INST_EQUAL_BOOLEAN:
+        binary_operator = "==";
+        break;
+    case INST_NOT_EQUAL_BOOLEAN:
+        binary_operator = "!=";
+        break;
+    case INST_LESS:
+        comparison = "<";
+        break;
+    case INST_LESS_EQUAL:
+        comparison = "<=";
+        break;
+    case INST_GREATER:
+        comparison = ">";
+        break;
+    case INST_GREATER_EQUAL:
+        comparison = ">=";
+        break;
+    case INST_EQUAL_NUMBER:
+        comparison = "==";
+        break;
+    case INST_NOT_EQUAL_NUMBER:
+        comparison = "!=";
+        break;
+    case INST_CONCAT_STRING:
+        nob_sb_appendf(emitter->output, "dplv_runtime_concat_string(&vm, t%zu, t%zu)", first, first + 1);
+        return;
+    case INST_EQUAL_STRING:
+        nob_sb_appendf(emitter->output, "dplv_runtime_string_equals(&vm, t%zu, t%zu)", first, first + 1);
+        return;
+    case INST_NOT_EQUAL_STRING:
+        nob_sb_appendf(emitter->output, "!dplv_runtime_string_equals(&vm, t%zu, t%zu)", first, first + 1);
+        return;
+    default:
+        DW_UNIMPLEMENTED_MSG("Cannot emit C code for instruction `%s`.", dplp_inst_kind_name(kind));
+    }
+
+    if (binary_operator)
+    {
+        nob_sb_appendf(emitter->output, "t%zu %s t%zu", first, binary_operator, first + 1);
+    }
+    else
+    {
+        nob_sb_appendf(emitter->output, "dpl_value_compare_numbers(t%zu, t%zu) %s 0", first, first + 1, comparison);
+    }
+}
+
+static void _dpl_emit_function_call(DPL_Emitter *emitter, DPL_Bound_Node *node, bool tail)
+{
+    DPL_Bound_FunctionCall f = node->as.function_call;
+
+    // Arguments are evaluated into temporaries first, since C does not define
+    // the evaluation order of operands and function arguments.
+    size_t first = emitter->temporary_count;
+    emitter->temporary_count += f.arguments_count;
+
+    nob_sb_append_cstr(emitter->output, "({ ");
+    for (size_t i = 0; i < f.arguments_count; ++i)
+    {
+        nob_sb_appendf(emitter->output, "%s t%zu = ", _dpl_emit_ctype(f.arguments[i]->type), first + i);
+        _dpl_emit_node(emitter, f.arguments[i]);
+        nob_sb_append_cstr(emitter->output, "; ");
+    }
+
+    switch (f.function->as.function.kind)
+    {
+    case FUNCTION_INSTRUCTION:
+        _dpl_emit_instruction_call(emitter, f.function->as.function.as.instruction_function, first);
+        break;
+    case FUNCTION_INTRINSIC:
+    {
+        DPL_Intrinsic_Kind intrinsic = f.function->as.function.as.intrinsic_function;
+        _dpl_emit_unbox_begin(emitter, node->type);
+        nob_sb_appendf(emitter->output, "dplv_runtime_call_intrinsic(&vm, %d /* %s */, %zu, (DPL_Value[]){",
+                       intrinsic, dpl_intrinsic_kind_name(intrinsic), f.arguments_count);
+        for (size_t i = 0; i < f.arguments_count; ++i)
+        {
+            nob_sb_append_cstr(emitter->output, (i > 0) ? ", " : "");
+            _dpl_emit_boxed_temporary(emitter, f.arguments[i]->type, first + i);
+        }
+        nob_sb_append_cstr(emitter->output, "}))");
+    }
+    break;
+    case FUNCTION_USER:
+    {
+        size_t handle = f.function->as.function.as.user_function.user_handle;
+        if (tail && handle == emitter->function_handle)
+        {
+            // Like TAIL_CALL_USER: release the arguments and locals, then
+            // start over with the new arguments.
+            for (size_t i = 0; i < emitter->value_slots.count; ++i)
+            {
+                nob_sb_appendf(emitter->output, "dplv_release(&vm, l%zu); ", emitter->value_slots.items[i]);
+            }
+            for (size_t i = 0; i < f.arguments_count; ++i)
+            {
+                nob_sb_appendf(emitter->output, "l%zu = t%zu; ", i, first + i);
+            }
+            nob_sb_appendf(emitter->output, "goto tail_call; (%s){0}", _dpl_emit_ctype(node->type));
+            emitter->tail_called = true;
+            break;
+        }
+
+        nob_sb_appendf(emitter->output, "dpl_function_%zu(", handle);
+        for (size_t i = 0; i < f.arguments_count; ++i)
+        {
+            nob_sb_appendf(emitter->output, (i > 0) ? ", t%zu" : "t%zu", first + i);
+        }
+        nob_sb_append_cstr(emitter->output, ")");
+    }
+    break;
+    default:
+        DW_UNIMPLEMENTED_MSG("Function kind %d", f.function->as.function.kind);
+    }
+
+    nob_sb_append_cstr(emitter->output, "; })");
+}
+
+// Declares the local `slot` initialized with `expression`. Numbers and
+// booleans are not released, so locals that are never read (like unused loop
+// variables) are marked as used.
+static void _dpl_emit_local(DPL_Emitter *emitter, size_t slot, DPL_Bound_Node *expression)
+{
+    nob_sb_appendf(emitter->output, "%s l%zu = ", _dpl_emit_ctype(expression->type), slot);
+    _dpl_emit_node(emitter, expression);
+    nob_sb_append_cstr(emitter->output, ";");
+    if (_dpl_emit_is_value(expression->type))
+    {
+        nob_da_append(&emitter->value_slots, slot);
+    }
+    else
+    {
+        nob_sb_appendf(emitter->output, " (void)l%zu;", slot);
+    }
+}
+
+static void _dpl_emit_scope(DPL_Emitter *emitter, DPL_Bound_Node *node, bool tail)
+{
+    DPL_Bound_Scope s = node->as.scope;
+    size_t first_slot = emitter->slot_count;
+    size_t value_slot_count = emitter->value_slots.count;
+    size_t result = _dpl_emit_temporary(emitter);
+
+    nob_sb_append_cstr(emitter->output, "({");
+    emitter->indent++;
+    for (size_t i = 0; i < s.expressions_count; ++i)
+    {
+        DPL_Bound_Node *expression = s.expressions[i];
+        bool last = (i == s.expressions_count - 1);
+
+        _dpl_emit_newline(emitter);
+        if (expression->persistent && expression->kind == BOUND_NODE_OBJECT && expression->as.object.scalar)
+        {
+            // Each field of a scalar object gets a variable of its own.
+            DPL_Bound_Object object = expression->as.object;
+            size_t slot = emitter->slot_count;
+            for (size_t field = 0; field < object.field_count; ++field)
+            {
+                if (field > 0)
+                {
+                    _dpl_emit_newline(emitter);
+                }
+                _dpl_emit_local(emitter, slot + field, object.fields[field].expression);
+            }
+            emitter->slot_count = slot + object.field_count;
+        }
+        else if (expression->persistent)
+        {
+            // Declared variables stay alive until the end of the scope. Their
+            // slot only becomes visible after the initializer.
+            size_t slot = emitter->slot_count;
+            _dpl_emit_local(emitter, slot, expression);
+            emitter->slot_count = slot + 1;
+            if (last)
+            {
+                _dpl_emit_newline(emitter);
+                nob_sb_appendf(emitter->output, "%s t%zu = l%zu;", _dpl_emit_ctype(expression->type), result, slot);
+            }
+        }
+        else if (last)
+        {
+            nob_sb_appendf(emitter->output, "%s t%zu = ", _dpl_emit_ctype(expression->type), result);
+            emitter->tail = tail;
+            _dpl_emit_node(emitter, expression);
+            nob_sb_append_cstr(emitter->output, ";");
+        }
+        else
+        {
+            _dpl_emit_discard(emitter, expression);
+        }
+    }
+
+    // Release the variables of the scope, except for a result variable.
+    size_t slot = first_slot;
+    for (size_t i = 0; i + 1 < s.expressions_count; ++i)
+    {
+        if (s.expressions[i]->persistent && s.expressions[i]->kind == BOUND_NODE_OBJECT && s.expressions[i]->as.object.scalar)
+        {
+            DPL_Bound_Object object = s.expressions[i]->as.object;
+            for (size_t field = 0; field < object.field_count; ++field)
+            {
+                if (_dpl_emit_is_value(object.fields[field].expression->type))
+                {
+                    _dpl_emit_newline(emitter);
+                    nob_sb_appendf(emitter->output, "dplv_release(&vm, l%zu);", slot + field);
+                }
+            }
+            slot += object.field_count;
+        }
+        else if (s.expressions[i]->persistent)
+        {
+            if (_dpl_emit_is_value(s.expressions[i]->type))
+            {
+                _dpl_emit_newline(emitter);
+                nob_sb_appendf(emitter->output, "dplv_release(&vm, l%zu);", slot);
+            }
+            ++slot;
+        }
+    }
+
+    _dpl_emit_newline(emitter);
+    nob_sb_appendf(emitter->output, "t%zu;", result);
+    emitter->indent--;
+    _dpl_emit_newline(emitter);
+    nob_sb_append_cstr(emitter->output, "})");
+
+    emitter->slot_count = first_slot;
+    emitter->value_slots.count = value_slot_count;
+}
+
+static void _dpl_emit_while_loop(DPL_Emitter *emitter, DPL_Bound_Node *node)
+{
+    // The binder reserves a slot for the result array that stays allocated
+    // until the end of the enclosing scope.
+    emitter->slot_count++;
+
+    size_t result = _dpl_emit_temporary(emitter);
+    nob_sb_append_cstr(emitter->output, "({");
+    emitter->indent++;
+    _dpl_emit_newline(emitter);
+    nob_sb_appendf(emitter->output, "DPL_Value t%zu = dpl_value_make_array(&vm.stack_pool, 0, NULL);", result);
+    _dpl_emit_newline(emitter);
+    nob_sb_append_cstr(emitter->output, "while (");
+    _dpl_emit_node(emitter, node->as.while_loop.condition);
+    nob_sb_append_cstr(emitter->output, ")");
+    _dpl_emit_newline(emitter);
+    nob_sb_append_cstr(emitter->output, "{");
+    emitter->indent++;
+    _dpl_emit_newline(emitter);
+    if (node->as.while_loop.in_assignment)
+    {
+        nob_sb_appendf(emitter->output, "t%zu = dplv_runtime_concat_array(&vm, t%zu, ", result, result);
+        _dpl_emit_boxed(emitter, node->as.while_loop.body);
+        nob_sb_append_cstr(emitter->output, ");");
+    }
+    else
+    {
+        _dpl_emit_discard(emitter, node->as.while_loop.body);
+    }
+    emitter->indent--;
+    _dpl_emit_newline(emitter);
+    nob_sb_append_cstr(emitter->output, "}");
+    _dpl_emit_newline(emitter);
+    nob_sb_appendf(emitter->output, "t%zu;", result);
+    emitter->indent--;
+    _dpl_emit_newline(emitter);
+    nob_sb_append_cstr(emitter->output, "})");
+}
+
+static void _dpl_emit_node(DPL_Emitter *emitter, DPL_Bound_Node *node)
+{
+    bool tail = emitter->tail;
+    emitter->tail = false;
+
+    switch (node->kind)
+    {
+    case BOUND_NODE_VALUE:
+    {
+        if (_dpl_emit_is_type(node->type, TYPE_BASE_NUMBER))
+        {
+            _dpl_emit_number(emitter, node->as.value.as.number);
+        }
+        else if (_dpl_emit_is_type(node->type, TYPE_BASE_STRING))
+        {
+            _dpl_emit_string(emitter, node->as.value.as.string.data);
+        }
+        else if (_dpl_emit_is_type(node->type, TYPE_BASE_BOOLEAN))
+        {
+            nob_sb_append_cstr(emitter->output, node->as.value.as.boolean ? "true" : "false");
+        }
+        else
+        {
+            DW_ERROR("Cannot emit C code for value node of type " SV_Fmt ".", SV_Arg(node->type->name));
+        }
+    }
+    break;
+    case BOUND_NODE_OBJECT:
+    {
+        DPL_Bound_Object object = node->as.object;
+        size_t slot_count = emitter->slot_count;
+        size_t first = emitter->temporary_count;
+        emitter->temporary_count += object.field_count;
+
+        nob_sb_append_cstr(emitter->output, "({ ");
+        for (size_t i = 0; i < object.field_count; ++i)
+        {
+            nob_sb_appendf(emitter->output, "DPL_Value t%zu = ", first + i);
+            _dpl_emit_boxed(emitter, object.fields[i].expression);
+            nob_sb_append_cstr(emitter->output, "; ");
+        }
+        if (object.reuse)
+        {
+            nob_sb_appendf(emitter->output, "dplv_runtime_create_object_reuse(&vm, l%zu, %zu, (DPL_Value[]){",
+                           object.reuse->as.varref, object.field_count);
+        }
+        else
+        {
+            nob_sb_appendf(emitter->output, "dpl_value_make_object(&vm.stack_pool, %zu, (DPL_Value[]){", object.field_count);
+        }
+        for (size_t i = 0; i < object.field_count; ++i)
+        {
+            nob_sb_appendf(emitter->output, (i > 0) ? ", t%zu" : "t%zu", first + i);
+        }
+        nob_sb_append_cstr(emitter->output, "}); })");
+
+        emitter->slot_count = slot_count;
+    }
+    break;
+    case BOUND_NODE_LOAD_FIELD:
+    {
+        if (_dpl_emit_is_type(node->type, TYPE_BASE_NUMBER))
+        {
+            nob_sb_append_cstr(emitter->output, "dplv_runtime_load_field_number(&vm, ");
+        }
+        else if (_dpl_emit_is_type(node->type, TYPE_BASE_BOOLEAN))
+        {
+            nob_sb_append_cstr(emitter->output, "dplv_runtime_load_field_boolean(&vm, ");
+        }
+        else
+        {
+            nob_sb_append_cstr(emitter->output, "dplv_runtime_load_field(&vm, ");
+        }
+        _dpl_emit_node(emitter, node->as.load_field.expression);
+        nob_sb_appendf(emitter->output, ", %zu)", node->as.load_field.field_index);
+    }
+    break;
+    case BOUND_NODE_FUNCTIONCALL:
+        _dpl_emit_function_call(emitter, node, tail);
+        break;
+    case BOUND_NODE_SCOPE:
+        _dpl_emit_scope(emitter, node, tail);
+        break;
+    case BOUND_NODE_ARGREF:
+    case BOUND_NODE_VARREF:
+    {
+        if (_dpl_emit_is_value(node->type) && node->move)
+        {
+            nob_sb_appendf(emitter->output, "dplv_runtime_move(&l%zu)", node->as.varref);
+        }
+        else if (_dpl_emit_is_value(node->type))
+        {
+            nob_sb_appendf(emitter->output, "dplv_reference(&vm, l%zu)", node->as.varref);
+        }
+        else
+        {
+            nob_sb_appendf(emitter->output, "l%zu", node->as.varref);
+        }
+    }
+    break;
+    case BOUND_NODE_ASSIGNMENT:
+    {
+        size_t slot = node->as.assignment.scope_index;
+        if (_dpl_emit_is_value(node->type))
+        {
+            size_t value = _dpl_emit_temporary(emitter);
+            nob_sb_appendf(emitter->output, "({ DPL_Value t%zu = ", value);
+            _dpl_emit_node(emitter, node->as.assignment.expression);
+            nob_sb_appendf(emitter->output, "; dplv_release(&vm, l%zu); l%zu = dplv_reference(&vm, t%zu); t%zu; })",
+                           slot, slot, value, value);
+        }
+        else
+        {
+            nob_sb_appendf(emitter->output, "(l%zu = ", slot);
+            _dpl_emit_node(emitter, node->as.assignment.expression);
+            nob_sb_append_cstr(emitter->output, ")");
+        }
+    }
+    break;
+    case BOUND_NODE_CONDITIONAL:
+    {
+        nob_sb_append_cstr(emitter->output, "(");
+        _dpl_emit_node(emitter, node->as.conditional.condition);
+        emitter->indent++;
+        _dpl_emit_newline(emitter);
+        nob_sb_append_cstr(emitter->output, "? ");
+        emitter->tail = tail;
+        _dpl_emit_node(emitter, node->as.conditional.then_clause);
+        _dpl_emit_newline(emitter);
+        nob_sb_append_cstr(emitter->output, ": ");
+        emitter->tail = tail;
+        _dpl_emit_node(emitter, node->as.conditional.else_clause);
+        emitter->indent--;
+        nob_sb_append_cstr(emitter->output, ")");
+    }
+    break;
+    case BOUND_NODE_LOGICAL_OPERATOR:
+    {
+        nob_sb_append_cstr(emitter->output, "(");
+        _dpl_emit_node(emitter, node->as.logical_operator.lhs);
+        nob_sb_append_cstr(emitter->output,
+                           (node->as.logical_operator.operator.kind == TOKEN_AND_AND) ? " && " : " || ");
+        _dpl_emit_node(emitter, node->as.logical_operator.rhs);
+        nob_sb_append_cstr(emitter->output, ")");
+    }
+    break;
+    case BOUND_NODE_WHILE_LOOP:
+        _dpl_emit_while_loop(emitter, node);
+        break;
+    case BOUND_NODE_INTERPOLATION:
+    {
+        size_t count = node->as.interpolation.expressions_count;
+        size_t first = emitter->temporary_count;
+        emitter->temporary_count += count;
+
+        nob_sb_append_cstr(emitter->output, "({ ");
+        for (size_t i = 0; i < count; ++i)
+        {
+            nob_sb_appendf(emitter->output, "DPL_Value t%zu = ", first + i);
+            _dpl_emit_node(emitter, node->as.interpolation.expressions[i]);
+            nob_sb_append_cstr(emitter->output, "; ");
+        }
+        nob_sb_appendf(emitter->output, "dplv_runtime_interpolation(&vm, %zu, (DPL_Value[]){", count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            nob_sb_appendf(emitter->output, (i > 0) ? ", t%zu" : "t%zu", first + i);
+        }
+        nob_sb_append_cstr(emitter->output, "}); })");
+    }
+    break;
+    case BOUND_NODE_ARRAY:
+    {
+        size_t slot_count = emitter->slot_count;
+        size_t array = _dpl_emit_temporary(emitter);
+
+        nob_sb_appendf(emitter->output, "({ DPL_Runtime_Array t%zu = {0}; ", array);
+        for (size_t i = 0; i < node->as.array.element_count; ++i)
+        {
+            DPL_Bound_Node *element = node->as.array.elements[i];
+            if (element->kind == BOUND_NODE_SPREAD)
+            {
+                nob_sb_appendf(emitter->output, "dplv_runtime_array_spread(&vm, &t%zu, ", array);
+                _dpl_emit_node(emitter, element->as.spread);
+            }
+            else
+            {
+                nob_sb_appendf(emitter->output, "dplv_runtime_array_append(&t%zu, ", array);
+                _dpl_emit_boxed(emitter, element);
+            }
+            nob_sb_append_cstr(emitter->output, "); ");
+        }
+        nob_sb_appendf(emitter->output, "dplv_runtime_array_end(&vm, &t%zu); })", array);
+
+        emitter->slot_count = slot_count;
+    }
+    break;
+    case BOUND_NODE_ITERATE:
+    {
+        size_t slot = node->as.iterate.scope_index;
+        if (node->as.iterate.kind == ITERATE_RANGE)
+        {
+            nob_sb_appendf(emitter->output, "!(l%zu > l%zu)", slot, slot + 1);
+        }
+        else
+        {
+            nob_sb_appendf(emitter->output, "(l%zu < dpl_value_array_element_count(dpl_value_as_array(l%zu)))",
+                           slot + 1, slot);
+        }
+    }
+    break;
+    default:
+        DW_UNIMPLEMENTED_MSG("`%s`", dpl_bind_nodekind_name(node->kind));
+    }
+}
+
+static void _dpl_emit_function_signature(DPL_Emitter *emitter, DPL_Binding_UserFunction *function, size_t handle)
+{
+    DPL_Symbol_Type_Signature signature = function->function->as.function.signature;
+    nob_sb_appendf(emitter->output, "static %s dpl_function_%zu(", _dpl_emit_ctype(signature.returns), handle);
+    for (size_t i = 0; i < function->arity; ++i)
+    {
+        nob_sb_appendf(emitter->output, "%s%s l%zu", (i > 0) ? ", " : "", _dpl_emit_ctype(signature.arguments[i]), i);
+    }
+    if (function->arity == 0)
+    {
+        nob_sb_append_cstr(emitter->output, "void");
+    }
+    nob_sb_append_cstr(emitter->output, ")");
+}
+
+static void _dpl_emit_function(DPL_Emitter *emitter, DPL_Binding_UserFunction *function, size_t handle)
+{
+    DPL_Symbol_Type_Signature signature = function->function->as.function.signature;
+
+    nob_sb_appendf(emitter->output, "\n// " SV_Fmt "\n", SV_Arg(function->function->name));
+    _dpl_emit_function_signature(emitter, function, handle);
+    nob_sb_append_cstr(emitter->output, "\n{");
+
+    emitter->indent = 1;
+    emitter->slot_count = function->arity;
+    emitter->function_handle = handle;
+    emitter->tail_called = false;
+    emitter->value_slots.count = 0;
+    for (size_t i = 0; i < function->arity; ++i)
+    {
+        if (_dpl_emit_is_value(signature.arguments[i]))
+        {
+            nob_da_append(&emitter->value_slots, i);
+        }
+    }
+
+    // The body is emitted separately first, to know whether it needs the label
+    // that self calls in tail position jump to.
+    Nob_String_Builder *output = emitter->output;
+    Nob_String_Builder body = {0};
+    emitter->output = &body;
+    emitter->tail = true;
+    _dpl_emit_node(emitter, function->body);
+    emitter->output = output;
+
+    _dpl_emit_newline(emitter);
+    nob_sb_appendf(emitter->output, "%s result;", _dpl_emit_ctype(signature.returns));
+    if (emitter->tail_called)
+    {
+        nob_sb_append_cstr(emitter->output, "\ntail_call:");
+    }
+    _dpl_emit_newline(emitter);
+    nob_sb_append_cstr(emitter->output, "result = ");
+    nob_sb_append_buf(emitter->output, body.items, body.count);
+    nob_sb_append_cstr(emitter->output, ";");
+    nob_sb_free(body);
+    for (size_t i = 0; i < function->arity; ++i)
+    {
+        if (_dpl_emit_is_value(signature.arguments[i]))
+        {
+            _dpl_emit_newline(emitter);
+            nob_sb_appendf(emitter->output, "dplv_release(&vm, l%zu);", i);
+        }
+    }
+    _dpl_emit_newline(emitter);
+    nob_sb_append_cstr(emitter->output, "return result;\n}\n");
+}
+
+void dpl_emit_c(DPL_Binding_UserFunctions user_functions, DPL_Bound_Node *root, Nob_String_View file_name,
+                Nob_String_Builder *output)
+{
+    DPL_Emitter emitter = {
+        .user_functions = user_functions,
+        .output = output,
+    };
+
+    nob_sb_appendf(output, "// Generated by dplc from " SV_Fmt ".\n", SV_Arg(file_name));
+    nob_sb_append_cstr(output,
+                       "\n"
+                       "#ifdef DPL_LEAKCHECK\n"
+                       "#define STB_LEAKCHECK_IMPLEMENTATION\n"
+                       "#include <stb_leakcheck.h>\n"
+                       "#endif\n"
+                       "\n"
+                       "#include <dpl/vm/runtime.h>\n"
+                       "\n"
+                       "#define ARENA_IMPLEMENTATION\n"
+                       "#include <arena.h>\n"
+                       "\n"
+                       "#define NOB_IMPLEMENTATION\n"
+                       "#include <nob.h>\n"
+                       "#include <nobx.h>\n"
+                       "\n"
+                       "#define DW_BYTEBUFFER_IMPLEMENTATION\n"
+                       "#include <dw_byte_buffer.h>\n"
+                       "\n"
+                       "static DPL_VirtualMachine vm = {0};\n"
+                       "\n");
+
+    for (size_t i = 0; i < user_functions.count; ++i)
+    {
+        _dpl_emit_function_signature(&emitter, &user_functions.items[i], i);
+        nob_sb_append_cstr(output, ";\n");
+    }
+
+    for (size_t i = 0; i < user_functions.count; ++i)
+    {
+        _dpl_emit_function(&emitter, &user_functions.items[i], i);
+    }
+
+    nob_sb_append_cstr(output,
+                       "\n"
+                       "int main(void)\n"
+                       "{\n"
+                       "    dplv_runtime_init(&vm);\n");
+    if (root)
+    {
+        emitter.indent = 1;
+        emitter.slot_count = 0;
+        _dpl_emit_newline(&emitter);
+        _dpl_emit_discard(&emitter, root);
+        nob_sb_append_cstr(output, "\n");
+    }
+    nob_sb_append_cstr(output,
+                       "    dplv_runtime_free(&vm);\n"
+                       "\n"
+                       "#ifdef DPL_LEAKCHECK\n"
+                       "    stb_leakcheck_dumpmem();\n"
+                       "#endif\n"
+                       "\n"
+                       "    return 0;\n"
+                       "}\n");
+
+    nob_da_free(emitter.value_slots);
+}
@@ -0,0 +1,247 @@
+#ifdef DPL_LEAKCHECK
+#include <stb_leakcheck.h>
+#endif
+
+#include <dw_error.h>
+#include <dpl/fusion.h>
+
+typedef struct
+{
+    size_t *items;
+    size_t count;
+    size_t capacity;
+} DPL_Fusion_Offsets;
+
+typedef struct
+{
+    DPL_Instruction_Kind kind;
+    size_t operand_offset;
+    size_t target;
+} DPL_Fusion_Relocation;
+
+typedef struct
+{
+    DPL_Fusion_Relocation *items;
+    size_t count;
+    size_t capacity;
+} DPL_Fusion_Relocations;
+
+typedef struct
+{
+    DW_ByteBuffer source;
+    DPL_Fusion_Offsets instructions;
+    bool *is_target;
+
+    DW_ByteBuffer code;
+    DPL_Fusion_Relocations relocations;
+} DPL_Fusion;
+
+static DPL_Instruction_Kind dpl_fuse__kind(DPL_Fusion *fusion, size_t index)
+{
+    return fusion->source.items[fusion->instructions.items[index]];
+}
+
+static size_t dpl_fuse__jump_target(DW_ByteBuffer code, size_t ip)
+{
+    DPL_Instruction_Kind kind = code.items[ip];
+    size_t end = ip + 1 + sizeof(uint16_t);
+    uint16_t jump = *(uint16_t *)(code.items + ip + 1);
+
+    if (kind == INST_JUMP_LOOP)
+    {
+        return end - jump;
+    }
+    return end + jump;
+}
+
+// Checks whether the instructions starting at `index` have the given kinds and
+// none of them but the first one is targeted by a jump or call.
+static bool dpl_fuse__match(DPL_Fusion *fusion, size_t index, size_t count, const DPL_Instruction_Kind *kinds)
+{
+    if (index + count > fusion->instructions.count)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (dpl_fuse__kind(fusion, index + i) != kinds[i])
+        {
+            return false;
+        }
+        if (i > 0 && fusion->is_target[fusion->instructions.items[index + i]])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+#define dpl_fuse__match_kinds(fusion, index, ...)                                        \
+    dpl_fuse__match((fusion), (index), DPL_ARG_COUNT(__VA_ARGS__),                         \
+                    (DPL_Instruction_Kind[]){__VA_ARGS__})
+
+static const uint8_t *dpl_fuse__operands(DPL_Fusion *fusion, size_t index)
+{
+    return fusion->source.items + fusion->instructions.items[index] + 1;
+}
+
+static void dpl_fuse__relocate(DPL_Fusion *fusion, DPL_Instruction_Kind kind, size_t target)
+{
+    DPL_Fusion_Relocation relocation = {
+        .kind = kind,
+        .operand_offset = fusion->code.count,
+        .target = target,
+    };
+    nob_da_append(&fusion->relocations, relocation);
+}
+
+// Emits the instruction at `index` (possibly as a superinstruction together
+// with its successors) and returns the number of source instructions consumed.
+static size_t dpl_fuse__emit(DPL_Fusion *fusion, size_t index)
+{
+    // PUSH_LOCAL a; PUSH_NUMBER n; ADD_NUMBER; STORE_LOCAL b
+    //   => ADD_LOCAL_NUMBER a n b
+    if (dpl_fuse__match_kinds(fusion, index, INST_PUSH_LOCAL, INST_PUSH_NUMBER, INST_ADD_NUMBER, INST_STORE_LOCAL))
+    {
+        bb_write_u8(&fusion->code, INST_ADD_LOCAL_NUMBER);
+        bb_write_u64(&fusion->code, *(uint64_t *)dpl_fuse__operands(fusion, index));
+        bb_write_f64(&fusion->code, *(double *)dpl_fuse__operands(fusion, index + 1));
+        bb_write_u64(&fusion->code, *(uint64_t *)dpl_fuse__operands(fusion, index + 3));
+        return 4;
+    }
+
+    // PUSH_LOCAL a; LOAD_FIELD[_NUMBER|_BOOLEAN] f
+    //   => LOAD_LOCAL_FIELD[_NUMBER|_BOOLEAN] a f
+    static const DPL_Instruction_Kind field_loads[][2] = {
+        {INST_LOAD_FIELD, INST_LOAD_LOCAL_FIELD},
+        {INST_LOAD_FIELD_NUMBER, INST_LOAD_LOCAL_FIELD_NUMBER},
+        {INST_LOAD_FIELD_BOOLEAN, INST_LOAD_LOCAL_FIELD_BOOLEAN},
+    };
+    for (size_t i = 0; i < NOB_ARRAY_LEN(field_loads); ++i)
+    {
+        if (dpl_fuse__match_kinds(fusion, index, INST_PUSH_LOCAL, field_loads[i][0]))
+        {
+            bb_write_u8(&fusion->code, field_loads[i][1]);
+            bb_write_u64(&fusion->code, *(uint64_t *)dpl_fuse__operands(fusion, index));
+            bb_write_u32(&fusion->code, *(uint32_t *)dpl_fuse__operands(fusion, index + 1));
+            return 2;
+        }
+    }
+
+    // LESS; JUMP_IF_FALSE j; POP
+    //   => LESS_JUMP_IF_FALSE j
+    if (dpl_fuse__match_kinds(fusion, index, INST_LESS, INST_JUMP_IF_FALSE, INST_POP))
+    {
+        bb_write_u8(&fusion->code, INST_LESS_JUMP_IF_FALSE);
+        dpl_fuse__relocate(fusion, INST_LESS_JUMP_IF_FALSE,
+                           dpl_fuse__jump_target(fusion->source, fusion->instructions.items[index + 1]));
+        bb_write_u16(&fusion->code, 0);
+        return 3;
+    }
+
+    const size_t ip = fusion->instructions.items[index];
+    const DPL_Instruction_Kind kind = fusion->source.items[ip];
+    switch (kind)
+    {
+    case INST_JUMP:
+    case INST_JUMP_IF_FALSE:
+    case INST_JUMP_IF_TRUE:
+    case INST_JUMP_LOOP:
+        bb_write_u8(&fusion->code, kind);
+        dpl_fuse__relocate(fusion, kind, dpl_fuse__jump_target(fusion->source, ip));
+        bb_write_u16(&fusion->code, 0);
+        break;
+    case INST_CALL_USER:
+    case INST_TAIL_CALL_USER:
+        bb_write_u8(&fusion->code, kind);
+        bb_write_u8(&fusion->code, fusion->source.items[ip + 1]);
+        dpl_fuse__relocate(fusion, kind, *(uint64_t *)(fusion->source.items + ip + 2));
+        bb_write_u64(&fusion->code, 0);
+        break;
+    default:
+        nob_da_append_many(&fusion->code, fusion->source.items + ip, 1 + dplp_inst_operand_size(kind));
+        break;
+    }
+
+    return 1;
+}
+
+void dpl_fuse(DPL_Program *program)
+{
+    DPL_Fusion fusion = {
+        .source = program->code,
+        .is_target = malloc((program->code.count + 1) * sizeof(bool)),
+    };
+    memset(fusion.is_target, 0, (program->code.count + 1) * sizeof(bool));
+
+    // Collect instruction boundaries and everything that control flow can
+    // enter from somewhere else than the preceding instruction.
+    fusion.is_target[program->entry] = true;
+    size_t ip = 0;
+    while (ip < program->code.count)
+    {
+        nob_da_append(&fusion.instructions, ip);
+
+        DPL_Instruction_Kind kind = program->code.items[ip];
+        switch (kind)
+        {
+        case INST_JUMP:
+        case INST_JUMP_IF_FALSE:
+        case INST_JUMP_IF_TRUE:
+        case INST_JUMP_LOOP:
+            fusion.is_target[dpl_fuse__jump_target(program->code, ip)] = true;
+            break;
+        case INST_CALL_USER:
+        case INST_TAIL_CALL_USER:
+            fusion.is_target[*(uint64_t *)(program->code.items + ip + 2)] = true;
+            break;
+        default:
+            break;
+        }
+
+        ip += 1 + dplp_inst_operand_size(kind);
+    }
+
+    // Maps source offsets of instruction starts (and the end of the code) to
+    // their offsets in the fused code.
+    size_t *new_offsets = malloc((program->code.count + 1) * sizeof(*new_offsets));
+    size_t index = 0;
+    while (index < fusion.instructions.count)
+    {
+        new_offsets[fusion.instructions.items[index]] = fusion.code.count;
+        index += dpl_fuse__emit(&fusion, index);
+    }
+    new_offsets[program->code.count] = fusion.code.count;
+
+    for (size_t i = 0; i < fusion.relocations.count; ++i)
+    {
+        DPL_Fusion_Relocation relocation = fusion.relocations.items[i];
+        size_t target = new_offsets[relocation.target];
+        uint8_t *operand = fusion.code.items + relocation.operand_offset;
+
+        if (relocation.kind == INST_CALL_USER || relocation.kind == INST_TAIL_CALL_USER)
+        {
+            *(uint64_t *)operand = target;
+            continue;
+        }
+
+        size_t end = relocation.operand_offset + sizeof(uint16_t);
+        size_t jump = (relocation.kind == INST_JUMP_LOOP) ? end - target : target - end;
+        if (jump > UINT16_MAX)
+        {
+            DW_ERROR("Cannot generate jumps larger then %u bytes.", UINT16_MAX);
+        }
+        *(uint16_t *)operand = jump;
+    }
+
+    program->entry = new_offsets[program->entry];
+    nob_da_free(program->code);
+    program->code = fusion.code;
+
+    free(new_offsets);
+    free(fusion.is_target);
+    nob_da_free(fusion.instructions);
+    nob_da_free(fusion.relocations);
+}
@@ -1,8 +1,83 @@
 #include <dpl/generator.h>
 #include <dw_error.h>
 
-void dpl_generate(DPL_Generator *generator, DPL_Bound_Node *node, DPL_Program *program)
+// Whether evaluating `node` may assign to the local at `scope_index`.
+static bool _dpl_generate_assigns_local(DPL_Bound_Node *node, size_t scope_index)
+{
+    switch (node->kind)
+    {
+    case BOUND_NODE_VALUE:
+    case BOUND_NODE_VARREF:
+    case BOUND_NODE_ARGREF:
+    case BOUND_NODE_ITERATE:
+        return false;
+    case BOUND_NODE_LOAD_FIELD:
+        return _dpl_generate_assigns_local(node->as.load_field.expression, scope_index);
+    case BOUND_NODE_SPREAD:
+        return _dpl_generate_assigns_local(node->as.spread, scope_index);
+    case BOUND_NODE_FUNCTIONCALL:
+        for (size_t i = 0; i < node->as.function_call.arguments_count; ++i)
+        {
+            if (_dpl_generate_assigns_local(node->as.function_call.arguments[i], scope_index))
+            {
+                return true;
+            }
+        }
+        return false;
+    case BOUND_NODE_INTERPOLATION:
+        for (size_t i = 0; i < node->as.interpolation.expressions_count; ++i)
+        {
+            if (_dpl_generate_assigns_local(node->as.interpolation.expressions[i], scope_index))
+            {
+                return true;
+            }
+        }
+        return false;
+    default:
+        // Assignments, and anything that may contain them in nested scopes.
+        return true;
+    }
+}
+
+// `s := s + x` for a string local `s` extends the local's string directly.
+static bool _dpl_generate_is_append_local(DPL_Bound_Assignment assignment)
+{
+    DPL_Bound_Node *expression = assignment.expression;
+    if (expression->kind != BOUND_NODE_FUNCTIONCALL)
+    {
+        return false;
+    }
+
+    DPL_Bound_FunctionCall f = expression->as.function_call;
+    if (f.function->as.function.kind != FUNCTION_INSTRUCTION
+        || f.function->as.function.as.instruction_function != INST_CONCAT_STRING)
+    {
+        return false;
+    }
+
+    DPL_Bound_Node *lhs = f.arguments[0];
+    return (lhs->kind == BOUND_NODE_VARREF || lhs->kind == BOUND_NODE_ARGREF)
+        && lhs->as.varref == assignment.scope_index
+        && !_dpl_generate_assigns_local(f.arguments[1], assignment.scope_index);
+}
+
+// Number of locals a persistent expression occupies.
+static size_t _dpl_generate_local_count(DPL_Bound_Node *node)
 {
+    if (node->kind == BOUND_NODE_OBJECT && node->as.object.scalar)
+    {
+        return node->as.object.field_count;
+    }
+    return 1;
+}
+
+// `tail` is set when the value of `node` is directly returned from the
+// enclosing user function. Calls to user functions in tail position reuse the
+// callframe of the caller instead of pushing a new one.
+static void _dpl_generate(DPL_Generator *generator, DPL_Bound_Node *node, DPL_Program *program, bool tail)
+{
+    tail = tail && !node->persistent;
+
     switch (node->kind)
     {
     case BOUND_NODE_VALUE:
@@ -31,16 +106,39 @@ void dpl_generate(DPL_Generator *generator, DPL_Bound_Node *node, DPL_Program *p
         DPL_Bound_Object object = node->as.object;
         for (size_t i = 0; i < object.field_count; ++i)
         {
-            dpl_generate(generator, object.fields[i].expression, program);
+            _dpl_generate(generator, object.fields[i].expression, program, false);
         }
 
-        dplp_write_create_object(program, object.field_count);
+        if (object.scalar)
+        {
+            break;
+        }
+
+        if (object.reuse)
+        {
+            dplp_write_create_object_reuse(program, object.field_count, object.reuse->as.varref);
+        }
+        else
+        {
+            dplp_write_create_object(program, object.field_count);
+        }
     }
     break;
     case BOUND_NODE_LOAD_FIELD:
     {
-        dpl_generate(generator, node->as.load_field.expression, program);
-        dplp_write_load_field(program, node->as.load_field.field_index);
+        _dpl_generate(generator, node->as.load_field.expression, program, false);
+        if (dpl_symbols_is_type_base(node->type, TYPE_BASE_NUMBER))
+        {
+            dplp_write_load_field_number(program, node->as.load_field.field_index);
+        }
+        else if (dpl_symbols_is_type_base(node->type, TYPE_BASE_BOOLEAN))
+        {
+            dplp_write_load_field_boolean(program, node->as.load_field.field_index);
+        }
+        else
+        {
+            dplp_write_load_field(program, node->as.load_field.field_index);
+        }
     }
     break;
     case BOUND_NODE_FUNCTIONCALL:
@@ -48,7 +146,7 @@ void dpl_generate(DPL_Generator *generator, DPL_Bound_Node *node, DPL_Program *p
         DPL_Bound_FunctionCall f = node->as.function_call;
         for (size_t i = 0; i < f.arguments_count; ++i)
         {
-            dpl_generate(generator, f.arguments[i], program);
+            _dpl_generate(generator, f.arguments[i], program, false);
         }
 
         switch (f.function->as.function.kind)
@@ -62,7 +160,14 @@ void dpl_generate(DPL_Generator *generator, DPL_Bound_Node *node, DPL_Program *p
         case FUNCTION_USER:
         {
             DPL_Binding_UserFunction *uf = &generator->user_functions.items[f.function->as.function.as.user_function.user_handle];
-            dplp_write_call_user(program, uf->arity, uf->begin_ip);
+            if (tail)
+            {
+                dplp_write_tail_call_user(program, uf->arity, uf->begin_ip);
+            }
+            else
+            {
+                dplp_write_call_user(program, uf->arity, uf->begin_ip);
+            }
         }
         break;
         default:
@@ -86,10 +191,10 @@ void dpl_generate(DPL_Generator *generator, DPL_Bound_Node *node, DPL_Program *p
                 }
                 else
                 {
-                    persistent_count++;
+                    persistent_count += _dpl_generate_local_count(s.expressions[i - 1]);
                 }
             }
-            dpl_generate(generator, s.expressions[i], program);
+            _dpl_generate(generator, s.expressions[i], program, tail && i == s.expressions_count - 1);
             prev_was_persistent = s.expressions[i]->persistent;
         }
 
@@ -102,24 +207,38 @@ void dpl_generate(DPL_Generator *generator, DPL_Bound_Node *node, DPL_Program *p
     case BOUND_NODE_ARGREF:
     case BOUND_NODE_VARREF:
     {
-        dplp_write_push_local(program, node->as.varref);
+        if (node->move)
+        {
+            dplp_write_push_local_move(program, node->as.varref);
+        }
+        else
+        {
+            dplp_write_push_local(program, node->as.varref);
+        }
     }
     break;
     case BOUND_NODE_ASSIGNMENT:
     {
-        dpl_generate(generator, node->as.assignment.expression, program);
+        if (_dpl_generate_is_append_local(node->as.assignment))
+        {
+            _dpl_generate(generator, node->as.assignment.expression->as.function_call.arguments[1], program, false);
+            dplp_write_append_local(program, node->as.assignment.scope_index);
+            break;
+        }
+
+        _dpl_generate(generator, node->as.assignment.expression, program, false);
         dplp_write_store_local(program, node->as.assignment.scope_index);
     }
     break;
     case BOUND_NODE_CONDITIONAL:
     {
-        dpl_generate(generator, node->as.conditional.condition, program);
+        _dpl_generate(generator, node->as.conditional.condition, program, false);
 
         // jump over then clause if condition is false
         size_t then_jump = dplp_write_jump(program, INST_JUMP_IF_FALSE);
 
         dplp_write_pop(program);
-        dpl_generate(generator, node->as.conditional.then_clause, program);
+        _dpl_generate(generator, node->as.conditional.then_clause, program, tail);
 
         // jump over else clause if condition is true
         size_t else_jump = dplp_write_jump(program, INST_JUMP);
@@ -127,14 +246,14 @@ void dpl_generate(DPL_Generator *generator, DPL_Bound_Node *node, DPL_Program *p
 
         // else clause
         dplp_write_pop(program);
-        dpl_generate(generator, node->as.conditional.else_clause, program);
+        _dpl_generate(generator, node->as.conditional.else_clause, program, tail);
 
         dplp_patch_jump(program, else_jump);
     }
     break;
     case BOUND_NODE_LOGICAL_OPERATOR:
     {
-        dpl_generate(generator, node->as.logical_operator.lhs, program);
+        _dpl_generate(generator, node->as.logical_operator.lhs, program, false);
 
         size_t jump;
         if (node->as.logical_operator.operator.kind == TOKEN_AND_AND)
@@ -146,7 +265,9 @@ void dpl_generate(DPL_Generator *generator, DPL_Bound_Node *node, DPL_Program *p
             jump = dplp_write_jump(program, INST_JUMP_IF_TRUE);
         }
 
-        dpl_generate(generator, node->as.logical_operator.rhs, program);
+        // the right-hand side replaces the left-hand side value
+        dplp_write_pop(program);
+        _dpl_generate(generator, node->as.logical_operator.rhs, program, false);
 
         dplp_patch_jump(program, jump);
     }
@@ -159,13 +280,13 @@ void dpl_generate(DPL_Generator *generator, DPL_Bound_Node *node, DPL_Program *p
 
         size_t loop_start = program->code.count;
 
-        dpl_generate(generator, node->as.while_loop.condition, program);
+        _dpl_generate(generator, node->as.while_loop.condition, program, false);
 
         // jump over loop if condition is false
         size_t exit_jump = dplp_write_jump(program, INST_JUMP_IF_FALSE);
 
         dplp_write_pop(program);
-        dpl_generate(generator, node->as.while_loop.body, program);
+        _dpl_generate(generator, node->as.while_loop.body, program, false);
 
         if (node->as.while_loop.in_assignment)
         {
@@ -189,7 +310,7 @@ void dpl_generate(DPL_Generator *generator, DPL_Bound_Node *node, DPL_Program *p
         size_t count = node->as.interpolation.expressions_count;
         for (size_t i = 0; i < count; ++i)
         {
-            dpl_generate(generator, node->as.interpolation.expressions[i], program);
+            _dpl_generate(generator, node->as.interpolation.expressions[i], program, false);
         }
 
         dplp_write_interpolation(program, count);
@@ -197,22 +318,70 @@ void dpl_generate(DPL_Generator *generator, DPL_Bound_Node *node, DPL_Program *p
     break;
     case BOUND_NODE_ARRAY:
     {
-        dplp_write_begin_array(program);
         size_t count = node->as.array.element_count;
+        size_t spread_count = 0;
+        size_t spread_index = 0;
         for (size_t i = 0; i < count; ++i)
         {
-            dpl_generate(generator, node->as.array.elements[i], program);
+            if (node->as.array.elements[i]->kind == BOUND_NODE_SPREAD)
+            {
+                spread_count++;
+                spread_index = i;
+            }
+        }
+
+        if (spread_count == 1)
+        {
+            // The spread array is extended as a whole, so large arrays can
+            // share their elements with the result.
+            for (size_t i = 0; i < count; ++i)
+            {
+                DPL_Bound_Node *element = node->as.array.elements[i];
+                _dpl_generate(generator, (i == spread_index) ? element->as.spread : element, program, false);
+            }
+            dplp_write_extend_array(program, spread_index, count - spread_index - 1);
+            break;
+        }
+
+        dplp_write_begin_array(program);
+        for (size_t i = 0; i < count; ++i)
+        {
+            _dpl_generate(generator, node->as.array.elements[i], program, false);
         }
         dplp_write_end_array(program);
     }
     break;
     case BOUND_NODE_SPREAD:
     {
-        dpl_generate(generator, node->as.spread, program);
+        _dpl_generate(generator, node->as.spread, program, false);
         dplp_write_spread(program);
     }
     break;
+    case BOUND_NODE_ITERATE:
+    {
+        if (node->as.iterate.kind == ITERATE_RANGE)
+        {
+            dplp_write_iterate_range(program, node->as.iterate.scope_index);
+        }
+        else
+        {
+            dplp_write_iterate_array(program, node->as.iterate.scope_index);
+        }
+    }
+    break;
     default:
         DW_UNIMPLEMENTED_MSG("`%s`", dpl_bind_nodekind_name(node->kind));
     }
 }
+
+void dpl_generate(DPL_Generator *generator, DPL_Bound_Node *node, DPL_Program *program)
+{
+    _dpl_generate(generator, node, program, false);
+}
+
+void dpl_generate_function(DPL_Generator *generator, DPL_Binding_UserFunction *function, DPL_Program *program)
+{
+    function->begin_ip = program->code.count;
+    _dpl_generate(generator, function->body, program, true);
+    dplp_write_return(program);
+}
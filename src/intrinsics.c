@@ -17,11 +17,43 @@ const char *INTRINSIC_KIND_NAMES[COUNT_INTRINSICS] = {
     [INTRINSIC_ARRAY_ELEMENT] = "element([T], Number): T",
     [INTRINSIC_ARRAY_ITERATOR] = "<T>iterator([T]): Iterator<T>",
     [INTRINSIC_ARRAYITERATOR_NEXT] = "next(Iterator<T>): Iterator<T>",
+    [INTRINSIC_NUMBERARRAY_SUM] = "sum([Number]): Number",
+    [INTRINSIC_NUMBERARRAY_MIN] = "min([Number]): Number",
+    [INTRINSIC_NUMBERARRAY_MAX] = "max([Number]): Number",
+    [INTRINSIC_NUMBERARRAY_DOT] = "dot([Number], [Number]): Number",
+    [INTRINSIC_NUMBERARRAY_SCALE] = "scale([Number], Number): [Number]",
+    [INTRINSIC_NUMBERARRAY_ADD] = "add([Number], [Number]): [Number]",
+    [INTRINSIC_NUMBERARRAY_MULTIPLY] = "multiply([Number], [Number]): [Number]",
 };
 
-static_assert(COUNT_INTRINSICS == 12,
+static_assert(COUNT_INTRINSICS == 19,
               "Count of intrinsic kinds has changed, please update intrinsic kind names map.");
 
+const size_t INTRINSIC_KIND_ARITIES[COUNT_INTRINSICS] = {
+    [INTRINSIC_BOOLEAN_TOSTRING] = 1,
+    [INTRINSIC_BOOLEAN_PRINT] = 1,
+    [INTRINSIC_NUMBER_PRINT] = 1,
+    [INTRINSIC_NUMBER_TOSTRING] = 1,
+    [INTRINSIC_NUMBERITERATOR_NEXT] = 1,
+    [INTRINSIC_NUMBERRANGE_ITERATOR] = 1,
+    [INTRINSIC_STRING_LENGTH] = 1,
+    [INTRINSIC_STRING_PRINT] = 1,
+    [INTRINSIC_ARRAY_LENGTH] = 1,
+    [INTRINSIC_ARRAY_ELEMENT] = 2,
+    [INTRINSIC_ARRAY_ITERATOR] = 1,
+    [INTRINSIC_ARRAYITERATOR_NEXT] = 1,
+    [INTRINSIC_NUMBERARRAY_SUM] = 1,
+    [INTRINSIC_NUMBERARRAY_MIN] = 1,
+    [INTRINSIC_NUMBERARRAY_MAX] = 1,
+    [INTRINSIC_NUMBERARRAY_DOT] = 2,
+    [INTRINSIC_NUMBERARRAY_SCALE] = 2,
+    [INTRINSIC_NUMBERARRAY_ADD] = 2,
+    [INTRINSIC_NUMBERARRAY_MULTIPLY] = 2,
+};
+
+static_assert(COUNT_INTRINSICS == 19,
+              "Count of intrinsic kinds has changed, please update intrinsic kind arities map.");
+
 const char *dpl_intrinsic_kind_name(DPL_Intrinsic_Kind kind)
 {
     if (kind >= COUNT_INTRINSICS)
@@ -29,4 +61,12 @@ const char *dpl_intrinsic_kind_name(DPL_Intrinsic_Kind kind)
         DW_ERROR("Invalid intrinsic kind %u.", kind);
     }
     return INTRINSIC_KIND_NAMES[kind];
-}
\ No newline at end of file
+}
+size_t dpl_intrinsic_kind_arity(DPL_Intrinsic_Kind kind)
+{
+    if (kind >= COUNT_INTRINSICS)
+    {
+        DW_ERROR("Invalid intrinsic kind %u.", kind);
+    }
+    return INTRINSIC_KIND_ARITIES[kind];
+}
@@ -4,10 +4,11 @@
 
 #include <dw_error.h>
 #include <dpl/program.h>
+#include <dpl/verifier.h>
 
 void dplp_init(DPL_Program *program)
 {
-    program->version = 1;
+    program->version = DPL_PROGRAM_VERSION;
 }
 
 void dplp_free(DPL_Program *program)
@@ -15,6 +16,7 @@ void dplp_free(DPL_Program *program)
     nob_da_free(program->constants);
     nob_da_free(program->code);
     nob_da_free(program->constants_dictionary);
+    nob_da_free(program->functions);
 }
 
 bool _dplp_find_number_constant(DPL_Program *program, double value, size_t *output)
@@ -116,13 +118,32 @@ void dplp_write_push_boolean(DPL_Program *program, bool value)
 void dplp_write_create_object(DPL_Program *program, size_t field_count)
 {
     bb_write_u8(&program->code, INST_CREATE_OBJECT);
-    bb_write_u8(&program->code, field_count);
+    bb_write_u32(&program->code, field_count);
+}
+
+void dplp_write_create_object_reuse(DPL_Program *program, size_t field_count, size_t scope_index)
+{
+    bb_write_u8(&program->code, INST_CREATE_OBJECT_REUSE);
+    bb_write_u32(&program->code, field_count);
+    bb_write_u64(&program->code, scope_index);
 }
 
 void dplp_write_load_field(DPL_Program *program, size_t field_index)
 {
     bb_write_u8(&program->code, INST_LOAD_FIELD);
-    bb_write_u8(&program->code, field_index);
+    bb_write_u32(&program->code, field_index);
+}
+
+void dplp_write_load_field_number(DPL_Program *program, size_t field_index)
+{
+    bb_write_u8(&program->code, INST_LOAD_FIELD_NUMBER);
+    bb_write_u32(&program->code, field_index);
+}
+
+void dplp_write_load_field_boolean(DPL_Program *program, size_t field_index)
+{
+    bb_write_u8(&program->code, INST_LOAD_FIELD_BOOLEAN);
+    bb_write_u32(&program->code, field_index);
 }
 
 void dplp_write_push_local(DPL_Program *program, size_t scope_index)
@@ -131,6 +152,12 @@ void dplp_write_push_local(DPL_Program *program, size_t scope_index)
     bb_write_u64(&program->code, scope_index);
 }
 
+void dplp_write_push_local_move(DPL_Program *program, size_t scope_index)
+{
+    bb_write_u8(&program->code, INST_PUSH_LOCAL_MOVE);
+    bb_write_u64(&program->code, scope_index);
+}
+
 void dplp_write_pop(DPL_Program *program)
 {
     bb_write_u8(&program->code, INST_POP);
@@ -147,9 +174,9 @@ void dplp_write_negate(DPL_Program *program)
     bb_write_u8(&program->code, INST_NEGATE);
 }
 
-void dplp_write_add(DPL_Program *program)
+void dplp_write_add_number(DPL_Program *program)
 {
-    bb_write_u8(&program->code, INST_ADD);
+    bb_write_u8(&program->code, INST_ADD_NUMBER);
 }
 
 void dplp_write_subtract(DPL_Program *program)
@@ -180,6 +207,13 @@ void dplp_write_call_user(DPL_Program *program, size_t arity, size_t ip_begin)
     bb_write_u64(&program->code, ip_begin);
 }
 
+void dplp_write_tail_call_user(DPL_Program *program, size_t arity, size_t ip_begin)
+{
+    bb_write_u8(&program->code, INST_TAIL_CALL_USER);
+    bb_write_u8(&program->code, arity);
+    bb_write_u64(&program->code, ip_begin);
+}
+
 void dplp_write_return(DPL_Program *program)
 {
     bb_write_u8(&program->code, INST_RETURN);
@@ -228,7 +262,7 @@ void dplp_write_loop(DPL_Program *program, size_t target)
 void dplp_write_interpolation(DPL_Program *program, size_t count)
 {
     dplp_write(program, INST_INTERPOLATION);
-    bb_write_u8(&program->code, count);
+    bb_write_u32(&program->code, count);
 }
 
 void dplp_write_begin_array(DPL_Program *program)
@@ -251,6 +285,31 @@ void dplp_write_spread(DPL_Program *program)
     dplp_write(program, INST_SPREAD);
 }
 
+void dplp_write_iterate_range(DPL_Program *program, size_t scope_index)
+{
+    bb_write_u8(&program->code, INST_ITERATE_RANGE);
+    bb_write_u64(&program->code, scope_index);
+}
+
+void dplp_write_iterate_array(DPL_Program *program, size_t scope_index)
+{
+    bb_write_u8(&program->code, INST_ITERATE_ARRAY);
+    bb_write_u64(&program->code, scope_index);
+}
+
+void dplp_write_append_local(DPL_Program *program, size_t scope_index)
+{
+    bb_write_u8(&program->code, INST_APPEND_LOCAL);
+    bb_write_u64(&program->code, scope_index);
+}
+
+void dplp_write_extend_array(DPL_Program *program, size_t before_count, size_t after_count)
+{
+    bb_write_u8(&program->code, INST_EXTEND_ARRAY);
+    bb_write_u32(&program->code, before_count);
+    bb_write_u32(&program->code, after_count);
+}
+
 const char *dplp_inst_kind_name(DPL_Instruction_Kind kind)
 {
     switch (kind)
@@ -269,8 +328,8 @@ const char *dplp_inst_kind_name(DPL_Instruction_Kind kind)
         return "NEGATE";
     case INST_NOT:
         return "NOT";
-    case INST_ADD:
-        return "ADD";
+    case INST_ADD_NUMBER:
+        return "ADD_NUMBER";
     case INST_SUBTRACT:
         return "SUBTRACT";
     case INST_MULTIPLY:
@@ -285,14 +344,26 @@ const char *dplp_inst_kind_name(DPL_Instruction_Kind kind)
         return "GREATER";
     case INST_GREATER_EQUAL:
         return "GREATER_EQUAL";
-    case INST_EQUAL:
-        return "EQUAL";
-    case INST_NOT_EQUAL:
-        return "NOT_EQUAL";
+    case INST_EQUAL_NUMBER:
+        return "EQUAL_NUMBER";
+    case INST_NOT_EQUAL_NUMBER:
+        return "NOT_EQUAL_NUMBER";
+    case INST_EQUAL_STRING:
+        return "EQUAL_STRING";
+    case INST_NOT_EQUAL_STRING:
+        return "NOT_EQUAL_STRING";
+    case INST_EQUAL_BOOLEAN:
+        return "EQUAL_BOOLEAN";
+    case INST_NOT_EQUAL_BOOLEAN:
+        return "NOT_EQUAL_BOOLEAN";
+    case INST_CONCAT_STRING:
+        return "CONCAT_STRING";
     case INST_CALL_INTRINSIC:
         return "CALL_INTRINSIC";
     case INST_CALL_USER:
         return "CALL_USER";
+    case INST_TAIL_CALL_USER:
+        return "TAIL_CALL_USER";
     case INST_RETURN:
         return "RETURN";
     case INST_PUSH_LOCAL:
@@ -323,11 +394,110 @@ const char *dplp_inst_kind_name(DPL_Instruction_Kind kind)
         return "CONCAT_ARRAY";
     case INST_SPREAD:
         return "SPREAD";
+    case INST_ITERATE_RANGE:
+        return "ITERATE_RANGE";
+    case INST_ITERATE_ARRAY:
+        return "ITERATE_ARRAY";
+    case INST_APPEND_LOCAL:
+        return "APPEND_LOCAL";
+    case INST_EXTEND_ARRAY:
+        return "EXTEND_ARRAY";
+    case INST_LOAD_FIELD_NUMBER:
+        return "LOAD_FIELD_NUMBER";
+    case INST_LOAD_FIELD_BOOLEAN:
+        return "LOAD_FIELD_BOOLEAN";
+    case INST_PUSH_LOCAL_MOVE:
+        return "PUSH_LOCAL_MOVE";
+    case INST_CREATE_OBJECT_REUSE:
+        return "CREATE_OBJECT_REUSE";
+    case INST_ADD_LOCAL_NUMBER:
+        return "ADD_LOCAL_NUMBER";
+    case INST_LOAD_LOCAL_FIELD:
+        return "LOAD_LOCAL_FIELD";
+    case INST_LOAD_LOCAL_FIELD_NUMBER:
+        return "LOAD_LOCAL_FIELD_NUMBER";
+    case INST_LOAD_LOCAL_FIELD_BOOLEAN:
+        return "LOAD_LOCAL_FIELD_BOOLEAN";
+    case INST_LESS_JUMP_IF_FALSE:
+        return "LESS_JUMP_IF_FALSE";
     default:
         DW_UNIMPLEMENTED_MSG("%d", kind);
     }
 }
 
+size_t dplp_inst_operand_size(DPL_Instruction_Kind kind)
+{
+    switch (kind)
+    {
+    case INST_NOOP:
+    case INST_POP:
+    case INST_NEGATE:
+    case INST_NOT:
+    case INST_ADD_NUMBER:
+    case INST_SUBTRACT:
+    case INST_MULTIPLY:
+    case INST_DIVIDE:
+    case INST_LESS:
+    case INST_LESS_EQUAL:
+    case INST_GREATER:
+    case INST_GREATER_EQUAL:
+    case INST_EQUAL_NUMBER:
+    case INST_NOT_EQUAL_NUMBER:
+    case INST_EQUAL_STRING:
+    case INST_NOT_EQUAL_STRING:
+    case INST_EQUAL_BOOLEAN:
+    case INST_NOT_EQUAL_BOOLEAN:
+    case INST_CONCAT_STRING:
+    case INST_RETURN:
+    case INST_BEGIN_ARRAY:
+    case INST_END_ARRAY:
+    case INST_CONCAT_ARRAY:
+    case INST_SPREAD:
+        return 0;
+    case INST_PUSH_BOOLEAN:
+    case INST_CALL_INTRINSIC:
+        return sizeof(uint8_t);
+    case INST_CREATE_OBJECT:
+    case INST_LOAD_FIELD:
+    case INST_LOAD_FIELD_NUMBER:
+    case INST_LOAD_FIELD_BOOLEAN:
+    case INST_INTERPOLATION:
+        return sizeof(uint32_t);
+    case INST_JUMP:
+    case INST_JUMP_IF_FALSE:
+    case INST_JUMP_IF_TRUE:
+    case INST_JUMP_LOOP:
+    case INST_LESS_JUMP_IF_FALSE:
+        return sizeof(uint16_t);
+    case INST_PUSH_NUMBER:
+        return sizeof(double);
+    case INST_PUSH_STRING:
+    case INST_PUSH_LOCAL:
+    case INST_PUSH_LOCAL_MOVE:
+    case INST_STORE_LOCAL:
+    case INST_POP_SCOPE:
+    case INST_ITERATE_RANGE:
+    case INST_ITERATE_ARRAY:
+    case INST_APPEND_LOCAL:
+        return sizeof(uint64_t);
+    case INST_CALL_USER:
+    case INST_TAIL_CALL_USER:
+        return sizeof(uint8_t) + sizeof(uint64_t);
+    case INST_LOAD_LOCAL_FIELD:
+    case INST_LOAD_LOCAL_FIELD_NUMBER:
+    case INST_LOAD_LOCAL_FIELD_BOOLEAN:
+        return sizeof(uint64_t) + sizeof(uint32_t);
+    case INST_EXTEND_ARRAY:
+        return sizeof(uint32_t) + sizeof(uint32_t);
+    case INST_CREATE_OBJECT_REUSE:
+        return sizeof(uint32_t) + sizeof(uint64_t);
+    case INST_ADD_LOCAL_NUMBER:
+        return sizeof(uint64_t) + sizeof(double) + sizeof(uint64_t);
+    default:
+        DW_UNIMPLEMENTED_MSG("%s", dplp_inst_kind_name(kind));
+    }
+}
+
 void dplp_print_escaped_string(const char *value, size_t length)
 {
     char *pos = (char *)value;
@@ -403,6 +573,7 @@ void dplp_print_stream_instruction(DW_ByteStream *code, DW_ByteStream *constants
     }
     break;
     case INST_PUSH_LOCAL:
+    case INST_PUSH_LOCAL_MOVE:
     {
         size_t scope_index = bs_read_u64(code);
         printf(" %zu", scope_index);
@@ -410,13 +581,22 @@ void dplp_print_stream_instruction(DW_ByteStream *code, DW_ByteStream *constants
     break;
     case INST_CREATE_OBJECT:
     {
-        size_t field_count = bs_read_u8(code);
+        size_t field_count = bs_read_u32(code);
         printf(" %zu", field_count);
     }
     break;
+    case INST_CREATE_OBJECT_REUSE:
+    {
+        size_t field_count = bs_read_u32(code);
+        size_t scope_index = bs_read_u64(code);
+        printf(" %zu %zu", field_count, scope_index);
+    }
+    break;
     case INST_LOAD_FIELD:
+    case INST_LOAD_FIELD_NUMBER:
+    case INST_LOAD_FIELD_BOOLEAN:
     {
-        size_t field_index = bs_read_u8(code);
+        size_t field_index = bs_read_u32(code);
         printf(" %zu", field_index);
     }
     break;
@@ -424,7 +604,7 @@ void dplp_print_stream_instruction(DW_ByteStream *code, DW_ByteStream *constants
     case INST_POP:
     case INST_NEGATE:
     case INST_NOT:
-    case INST_ADD:
+    case INST_ADD_NUMBER:
     case INST_SUBTRACT:
     case INST_MULTIPLY:
     case INST_DIVIDE:
@@ -432,8 +612,13 @@ void dplp_print_stream_instruction(DW_ByteStream *code, DW_ByteStream *constants
     case INST_LESS_EQUAL:
     case INST_GREATER:
     case INST_GREATER_EQUAL:
-    case INST_EQUAL:
-    case INST_NOT_EQUAL:
+    case INST_EQUAL_NUMBER:
+    case INST_NOT_EQUAL_NUMBER:
+    case INST_EQUAL_STRING:
+    case INST_NOT_EQUAL_STRING:
+    case INST_EQUAL_BOOLEAN:
+    case INST_NOT_EQUAL_BOOLEAN:
+    case INST_CONCAT_STRING:
     case INST_RETURN:
     case INST_BEGIN_ARRAY:
     case INST_END_ARRAY:
@@ -446,6 +631,7 @@ void dplp_print_stream_instruction(DW_ByteStream *code, DW_ByteStream *constants
     }
     break;
     case INST_CALL_USER:
+    case INST_TAIL_CALL_USER:
     {
         uint8_t arity = bs_read_u8(code);
         size_t begin_ip = bs_read_u64(code);
@@ -453,6 +639,9 @@ void dplp_print_stream_instruction(DW_ByteStream *code, DW_ByteStream *constants
     }
     break;
     case INST_STORE_LOCAL:
+    case INST_ITERATE_RANGE:
+    case INST_ITERATE_ARRAY:
+    case INST_APPEND_LOCAL:
     {
         size_t scope_index = bs_read_u64(code);
         printf(" %zu", scope_index);
@@ -468,14 +657,39 @@ void dplp_print_stream_instruction(DW_ByteStream *code, DW_ByteStream *constants
     case INST_JUMP_IF_FALSE:
     case INST_JUMP_IF_TRUE:
     case INST_JUMP_LOOP:
+    case INST_LESS_JUMP_IF_FALSE:
     {
         uint16_t offset = bs_read_u16(code);
         printf(" %u", offset);
     }
     break;
+    case INST_ADD_LOCAL_NUMBER:
+    {
+        size_t source_index = bs_read_u64(code);
+        double value = bs_read_f64(code);
+        size_t target_index = bs_read_u64(code);
+        printf(" %zu %f %zu", source_index, value, target_index);
+    }
+    break;
+    case INST_LOAD_LOCAL_FIELD:
+    case INST_LOAD_LOCAL_FIELD_NUMBER:
+    case INST_LOAD_LOCAL_FIELD_BOOLEAN:
+    {
+        size_t scope_index = bs_read_u64(code);
+        size_t field_index = bs_read_u32(code);
+        printf(" %zu %zu", scope_index, field_index);
+    }
+    break;
+    case INST_EXTEND_ARRAY:
+    {
+        uint32_t before_count = bs_read_u32(code);
+        uint32_t after_count = bs_read_u32(code);
+        printf(" %u %u", before_count, after_count);
+    }
+    break;
     case INST_INTERPOLATION:
     {
-        uint8_t count = bs_read_u8(code);
+        uint32_t count = bs_read_u32(code);
         printf(" %u", count);
     }
     break;
@@ -585,6 +799,11 @@ bool _dplp_load_chunk(FILE *in, DPL_Loaded_Chunk *chunk)
 bool dplp_load(DPL_Program *program, const char *file_name)
 {
     FILE *in = fopen(file_name, "rb");
+    if (!in)
+    {
+        DW_ERROR_MSGLN("Cannot open program file \"%s\".", file_name);
+        return false;
+    }
 
     DPL_Loaded_Chunk chunk = {0};
     while (_dplp_load_chunk(in, &chunk))
@@ -593,6 +812,14 @@ bool dplp_load(DPL_Program *program, const char *file_name)
         {
             program->version = chunk.data.items[0];
             program->entry = *(uint64_t *)(chunk.data.items + sizeof(program->version));
+            if (program->version != DPL_PROGRAM_VERSION)
+            {
+                DW_ERROR_MSGLN("Program file \"%s\" has version %u, but this version of dpl requires version %u.",
+                               file_name, program->version, DPL_PROGRAM_VERSION);
+                nob_da_free(chunk.data);
+                fclose(in);
+                return false;
+            }
         }
         else if (strcmp(chunk.name, "CONS") == 0)
         {
@@ -610,5 +837,6 @@ bool dplp_load(DPL_Program *program, const char *file_name)
 
     nob_da_free(chunk.data);
     fclose(in);
-    return true;
+
+    return dplp_verify(program);
 }
\ No newline at end of file
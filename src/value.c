@@ -7,6 +7,7 @@
 
 #include <dpl/value.h>
 
+#ifdef DPL_MEMORYVALUE_POOL_TRACKING
 static void dpl_value_pool__insert_item(DPL_MemoryValue** anchor, DPL_MemoryValue* item)
 {
     if (!*anchor)
@@ -39,64 +40,73 @@ static void dpl_value_pool__remove_item(DPL_MemoryValue** anchor, DPL_MemoryValu
         item->next->prev = item->prev;
     }
 }
+#endif
 
 DPL_MemoryValue* dpl_value_pool_allocate_item(DPL_MemoryValue_Pool* pool, const size_t size)
 {
-    DPL_MemoryValue* candidate = pool->freed;
-    while (candidate)
-    {
-        if (candidate->capacity >= size)
-        {
-            dpl_value_pool__remove_item(&pool->freed, candidate);
-            dpl_value_pool__insert_item(&pool->allocated, candidate);
-
-            candidate->size = size;
-            candidate->ref_count = 1;
-            memset(candidate->data, 0, size);
-            return candidate;
-        }
-        candidate = candidate->next;
-    }
-
-    size_t capacity = 8;
+    size_t size_class = DPL_MEMORYVALUE_POOL_MIN_SIZE_CLASS;
+    size_t capacity = (size_t)1 << size_class;
     while (capacity < size * sizeof(uint8_t))
     {
         capacity *= 2;
+        size_class++;
         if (capacity > DPL_MEMORYVALUE_POOL_MAX_CAPACITY)
         {
-            DW_ERROR("Exceeded maximum capacity for value pool item %llu.", DPL_MEMORYVALUE_POOL_MAX_CAPACITY);
+            DW_ERROR("Exceeded maximum capacity for value pool item %zu.", DPL_MEMORYVALUE_POOL_MAX_CAPACITY);
         }
     }
 
-    const size_t pool_item_size = sizeof(DPL_MemoryValue) + capacity;
-    DPL_MemoryValue* item = arena_alloc(&pool->memory, pool_item_size);
-    memset(item, 0, pool_item_size);
-
+    DPL_MemoryValue* item = pool->freed[size_class];
+    if (item)
+    {
+        pool->freed[size_class] = item->next;
+    }
+    else
+    {
+        item = arena_alloc(&pool->memory, sizeof(DPL_MemoryValue) + capacity);
 #ifdef DPL_MEMORYVALUE_POOL_IDS
-    item->id = ++pool->next_id;
+        item->id = ++pool->next_id;
 #endif
-    item->capacity = capacity;
+        item->capacity = capacity;
+        item->size_class = size_class;
+        item->immortal = false;
+    }
+
     item->size = size;
     item->ref_count = 1;
-
+    item->hash = 0;
+#ifdef DPL_MEMORYVALUE_POOL_TRACKING
     dpl_value_pool__insert_item(&pool->allocated, item);
+#endif
     return item;
 }
 
 void dpl_value_pool_free_item(DPL_MemoryValue_Pool* pool, DPL_MemoryValue* item)
 {
+#ifdef DPL_MEMORYVALUE_POOL_TRACKING
     dpl_value_pool__remove_item(&pool->allocated, item);
-    dpl_value_pool__insert_item(&pool->freed, item);
+#endif
+    item->ref_count = 0;
+    item->next = pool->freed[item->size_class];
+    pool->freed[item->size_class] = item;
 }
 
 void dpl_value_pool_acquire_item(const DPL_MemoryValue_Pool* pool, DPL_MemoryValue* item)
 {
     DW_UNUSED(pool);
-    item->ref_count++;
+    if (!item->immortal)
+    {
+        item->ref_count++;
+    }
 }
 
 void dpl_value_pool_release_item(DPL_MemoryValue_Pool* pool, DPL_MemoryValue* item)
 {
+    if (item->immortal)
+    {
+        return;
+    }
+
     item->ref_count--;
     if (item->ref_count == 0)
     {
@@ -107,7 +117,7 @@ void dpl_value_pool_release_item(DPL_MemoryValue_Pool* pool, DPL_MemoryValue* it
 bool dpl_value_pool_will_release_item(const DPL_MemoryValue_Pool* pool, const DPL_MemoryValue* item)
 {
     DW_UNUSED(pool);
-    return item->ref_count == 1;
+    return item->ref_count == 1 && !item->immortal;
 }
 
 DPL_Value dpl_value_pool_item_to_value(DPL_MemoryValue *item)
@@ -115,20 +125,9 @@ DPL_Value dpl_value_pool_item_to_value(DPL_MemoryValue *item)
     switch (item->kind)
     {
     case VALUE_STRING:
-        return (DPL_Value) {
-            .kind = VALUE_STRING,
-            .as.string = item,
-        };
     case VALUE_OBJECT:
-        return (DPL_Value) {
-            .kind = VALUE_OBJECT,
-            .as.object = item,
-        };
     case VALUE_ARRAY:
-        return (DPL_Value) {
-            .kind = VALUE_ARRAY,
-            .as.array = item,
-        };
+        return dpl_value_make_item(item->kind, item);
     default:
         DW_UNIMPLEMENTED_MSG("Unsupported value kind `%s`.", dpl_value_kind_name(item->kind));
     }
@@ -146,18 +145,18 @@ static void dpl_value_pool__print_item_list(DPL_MemoryValue *item)
     {
         printf("  ");
 #ifdef DPL_MEMORYVALUE_POOL_IDS
-        printf("  #%llu", item->id);
+        printf("  #%llu", (unsigned long long)item->id);
 #else
         printf("  #%p", item);
 #endif
         if (item->ref_count > 0)
         {
-            printf(": %4d/%4d bytes, ref_count: %d, content: ", item->size, item->capacity, item->ref_count);
+            printf(": %4u/%4u bytes, ref_count: %u, content: ", item->size, item->capacity, item->ref_count);
             dpl_value_print(dpl_value_pool_item_to_value(item));
         }
         else
         {
-            printf(": %4d bytes", item->capacity);
+            printf(": %4u bytes", item->capacity);
         }
         printf("\n");
 
@@ -169,17 +168,36 @@ void dpl_value_pool_print(const DPL_MemoryValue_Pool* pool)
 {
     printf("======================================\n");
     printf(" Used memory\n");
+#ifdef DPL_MEMORYVALUE_POOL_TRACKING
     dpl_value_pool__print_item_list(pool->allocated);
+#else
+    printf(" <not tracked>\n");
+#endif
 
     printf("\n Free memory\n");
-    dpl_value_pool__print_item_list(pool->freed);
+    bool has_free_items = false;
+    for (size_t size_class = DPL_MEMORYVALUE_POOL_SIZE_CLASSES; size_class > 0; --size_class)
+    {
+        if (pool->freed[size_class - 1])
+        {
+            dpl_value_pool__print_item_list(pool->freed[size_class - 1]);
+            has_free_items = true;
+        }
+    }
+    if (!has_free_items)
+    {
+        dpl_value_pool__print_item_list(NULL);
+    }
     printf("======================================\n");
 }
 
 void dpl_value_pool_free(DPL_MemoryValue_Pool* pool)
 {
+#ifdef DPL_MEMORYVALUE_POOL_TRACKING
     pool->allocated = NULL;
-    pool->freed = NULL;
+#endif
+    memset(pool->freed, 0, sizeof(pool->freed));
+    memset(pool->shapes, 0, sizeof(pool->shapes));
     arena_free(&pool->memory);
 }
 
@@ -202,81 +220,681 @@ const char *dpl_value_kind_name(DPL_ValueKind kind)
     DW_UNIMPLEMENTED_MSG("ERROR: Invalid value kind `%02X`.", kind);
 }
 
-DPL_Value dpl_value_make_number(double value)
+DPL_Value dpl_value_make_string(DPL_MemoryValue_Pool* pool, const size_t length, const char* data)
 {
-    return (DPL_Value){
-        .kind = VALUE_NUMBER,
-        .as = {
-            .number = value}};
+    if (length <= DPL_VALUE_SMALL_STRING_CAPACITY)
+    {
+        return dpl_value__make_small_string(length, data);
+    }
+
+    DPL_MemoryValue* item = dpl_value_pool_allocate_item(pool, length);
+    item->kind = VALUE_STRING;
+    memcpy(item->data, data, length);
+
+    return dpl_value_make_item(VALUE_STRING, item);
 }
 
-DPL_Value dpl_value_make_string(DPL_MemoryValue_Pool* pool, const size_t length, const char* data)
+DPL_Value dpl_value_make_string_concat(DPL_MemoryValue_Pool* pool, DPL_Value string1, DPL_Value string2)
 {
-    DPL_MemoryValue* item = dpl_value_pool_allocate_item(pool, length);
+    return dpl_value_make_string_join(pool, 2, (DPL_Value[]) { string1, string2 });
+}
+
+DPL_Value dpl_value_make_string_join(DPL_MemoryValue_Pool* pool, const size_t count, const DPL_Value* strings)
+{
+    size_t length = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        length += dpl_value_string_sv(&strings[i]).count;
+    }
+
+    char small[DPL_VALUE_SMALL_STRING_CAPACITY];
+    DPL_MemoryValue* item = NULL;
+    char* data = small;
+    if (length > DPL_VALUE_SMALL_STRING_CAPACITY)
+    {
+        item = dpl_value_pool_allocate_item(pool, length);
+        item->kind = VALUE_STRING;
+        data = (char*)item->data;
+    }
+
+    for (size_t i = 0, offset = 0; i < count; ++i)
+    {
+        const Nob_String_View sv = dpl_value_string_sv(&strings[i]);
+        memcpy(data + offset, sv.data, sv.count);
+        offset += sv.count;
+    }
+
+    if (!item)
+    {
+        return dpl_value__make_small_string(length, small);
+    }
+    return dpl_value_make_item(VALUE_STRING, item);
+}
+
+DPL_Value dpl_value_string_append(DPL_MemoryValue_Pool* pool, DPL_MemoryValue* string, const size_t length, const char* data)
+{
+    if (string->size + length > string->capacity)
+    {
+        DPL_MemoryValue* new_string = dpl_value_pool_allocate_item(pool, string->size + length);
+        new_string->kind = VALUE_STRING;
+        memcpy(new_string->data, string->data, string->size);
+        memcpy(new_string->data + string->size, data, length);
+        dpl_value_pool_free_item(pool, string);
+        return dpl_value_make_item(VALUE_STRING, new_string);
+    }
+
+    memcpy(string->data + string->size, data, length);
+    string->size += length;
+    string->hash = 0;
+
+    return dpl_value_make_item(VALUE_STRING, string);
+}
+
+DPL_Value dpl_value_make_constant_string(Arena* memory, const size_t length, const char* data)
+{
+    if (length <= DPL_VALUE_SMALL_STRING_CAPACITY)
+    {
+        return dpl_value__make_small_string(length, data);
+    }
+
+    DPL_MemoryValue* item = arena_alloc(memory, sizeof(DPL_MemoryValue) + length);
+    memset(item, 0, sizeof(DPL_MemoryValue));
+    item->capacity = length;
+    item->size = length;
+    item->ref_count = 1;
+    item->immortal = true;
     item->kind = VALUE_STRING;
     memcpy(item->data, data, length);
 
-    return (DPL_Value){
-        .kind = VALUE_STRING,
-        .as = {
-            .string = item}};
+    return dpl_value_make_item(VALUE_STRING, item);
+}
+
+static size_t dpl_value__array_element_size(DPL_ArrayStorage storage)
+{
+    switch (storage)
+    {
+    case ARRAY_STORAGE_VALUES:
+        return sizeof(DPL_Value);
+    case ARRAY_STORAGE_NUMBERS:
+        return sizeof(double);
+    case ARRAY_STORAGE_BOOLEANS:
+        return sizeof(bool);
+    case ARRAY_STORAGE_TRIE:
+        break;
+    }
+
+    DW_UNIMPLEMENTED_MSG("Invalid array storage `%d`.", storage);
+}
+
+// Arrays are homogeneous, so the first element decides the storage. The
+// remaining ones are only checked for robustness.
+static DPL_ArrayStorage dpl_value__array_storage(const size_t element_count, const DPL_Value* elements)
+{
+    if (element_count == 0)
+    {
+        return ARRAY_STORAGE_VALUES;
+    }
+
+    const DPL_ValueKind kind = dpl_value_kind(elements[0]);
+    if (kind != VALUE_NUMBER && kind != VALUE_BOOLEAN)
+    {
+        return ARRAY_STORAGE_VALUES;
+    }
+
+    for (size_t i = 1; i < element_count; ++i)
+    {
+        if (dpl_value_kind(elements[i]) != kind)
+        {
+            return ARRAY_STORAGE_VALUES;
+        }
+    }
+
+    return (kind == VALUE_NUMBER) ? ARRAY_STORAGE_NUMBERS : ARRAY_STORAGE_BOOLEANS;
+}
+
+static DPL_ArrayStorage dpl_value__field_storage(const DPL_Value field)
+{
+    switch (dpl_value_kind(field))
+    {
+    case VALUE_NUMBER:
+        return ARRAY_STORAGE_NUMBERS;
+    case VALUE_BOOLEAN:
+        return ARRAY_STORAGE_BOOLEANS;
+    default:
+        return ARRAY_STORAGE_VALUES;
+    }
+}
+
+// Two bits per field storage for the first 32 fields.
+static uint64_t dpl_value__object_signature(const size_t field_count, const DPL_Value* fields)
+{
+    uint64_t signature = 0;
+    for (size_t i = 0; i < field_count && i < 32; ++i)
+    {
+        signature |= (uint64_t)dpl_value__field_storage(fields[i]) << (2 * i);
+    }
+    return signature;
 }
 
-DPL_Value dpl_value_make_boolean(bool value)
+static bool dpl_value__object_shape_matches(const DPL_ObjectShape* shape, uint64_t signature, const size_t field_count, const DPL_Value* fields)
 {
-    return (DPL_Value){
-        .kind = VALUE_BOOLEAN,
-        .as = {
-            .boolean = value}};
+    if (shape->field_count != field_count || shape->signature != signature)
+    {
+        return false;
+    }
+    for (size_t i = 32; i < field_count; ++i)
+    {
+        if (shape->fields[i].storage != dpl_value__field_storage(fields[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Finds or creates the shape for `fields`. Numbers and values are laid out
+// first in field order, booleans are packed behind them.
+static DPL_ObjectShape* dpl_value__object_shape(DPL_MemoryValue_Pool* pool, const size_t field_count, const DPL_Value* fields)
+{
+    const uint64_t signature = dpl_value__object_signature(field_count, fields);
+
+    DPL_ObjectShape** bucket = &pool->shapes[(signature ^ (signature >> 17) ^ field_count) % DPL_MEMORYVALUE_POOL_SHAPE_BUCKETS];
+    for (DPL_ObjectShape* shape = *bucket; shape; shape = shape->next)
+    {
+        if (dpl_value__object_shape_matches(shape, signature, field_count, fields))
+        {
+            return shape;
+        }
+    }
+
+    DPL_ObjectShape* shape = arena_alloc(&pool->memory, sizeof(DPL_ObjectShape) + field_count * sizeof(DPL_ObjectShapeField));
+    shape->field_count = field_count;
+    shape->value_field_count = 0;
+    shape->signature = signature;
+
+    size_t offset = sizeof(DPL_ObjectShape*);
+    for (size_t pass = 0; pass < 2; ++pass)
+    {
+        for (size_t i = 0; i < field_count; ++i)
+        {
+            const DPL_ArrayStorage storage = dpl_value__field_storage(fields[i]);
+            if ((storage == ARRAY_STORAGE_BOOLEANS) != (pass == 1))
+            {
+                continue;
+            }
+
+            shape->fields[i].storage = storage;
+            shape->fields[i].offset = offset;
+            offset += dpl_value__array_element_size(storage);
+            if (storage == ARRAY_STORAGE_VALUES)
+            {
+                shape->value_field_count++;
+            }
+        }
+    }
+    shape->size = offset;
+
+    shape->next = *bucket;
+    *bucket = shape;
+    return shape;
 }
 
 DPL_Value dpl_value_make_object(DPL_MemoryValue_Pool* pool, const size_t field_count, const DPL_Value* fields)
 {
-    const size_t object_size = field_count * sizeof(DPL_Value);
+    DPL_ObjectShape* shape = dpl_value__object_shape(pool, field_count, fields);
 
-    DPL_MemoryValue* item = dpl_value_pool_allocate_item(pool, object_size);
+    DPL_MemoryValue* item = dpl_value_pool_allocate_item(pool, shape->size);
     item->kind = VALUE_OBJECT;
-    memcpy(item->data, fields, object_size);
+    *(DPL_ObjectShape**)item->data = shape;
+    for (size_t i = 0; i < field_count; ++i)
+    {
+        uint8_t* field = item->data + shape->fields[i].offset;
+        switch (shape->fields[i].storage)
+        {
+        case ARRAY_STORAGE_NUMBERS:
+            *(double*)field = dpl_value_as_number(fields[i]);
+            break;
+        case ARRAY_STORAGE_BOOLEANS:
+            *(bool*)field = dpl_value_as_boolean(fields[i]);
+            break;
+        default:
+            *(DPL_Value*)field = fields[i];
+            break;
+        }
+    }
 
-    return (DPL_Value){
-        .kind = VALUE_OBJECT,
-        .as = {
-            .object = item}};
+    return dpl_value_make_item(VALUE_OBJECT, item);
 }
 
-DPL_Value dpl_value_make_array(DPL_MemoryValue_Pool* pool, const size_t element_count, const DPL_Value* elements)
+bool dpl_value_object_overwrite(DPL_MemoryValue* object, const size_t field_count, DPL_Value* fields)
+{
+    const DPL_ObjectShape* shape = dpl_value_object_shape(object);
+    if (shape->field_count != field_count)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < field_count; ++i)
+    {
+        if (shape->fields[i].storage != dpl_value__field_storage(fields[i]))
+        {
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < field_count; ++i)
+    {
+        uint8_t* field = object->data + shape->fields[i].offset;
+        switch (shape->fields[i].storage)
+        {
+        case ARRAY_STORAGE_NUMBERS:
+            *(double*)field = dpl_value_as_number(fields[i]);
+            break;
+        case ARRAY_STORAGE_BOOLEANS:
+            *(bool*)field = dpl_value_as_boolean(fields[i]);
+            break;
+        default:
+        {
+            const DPL_Value previous = *(DPL_Value*)field;
+            *(DPL_Value*)field = fields[i];
+            fields[i] = previous;
+        }
+        break;
+        }
+    }
+    object->hash = 0;
+
+    return true;
+}
+
+static void dpl_value__check_element(DPL_MemoryValue* array, DPL_ArrayStorage storage, const DPL_Value element)
+{
+    if (storage != dpl_value__array_storage(1, &element))
+    {
+        DW_ERROR("Cannot add a value of kind `%s` to an array of kind `%s`.",
+                 dpl_value_kind_name(dpl_value_kind(element)),
+                 dpl_value_kind_name(dpl_value_kind(dpl_value_array_get_element(array, 0))));
+    }
+}
+
+static void dpl_value__array_set_element(DPL_MemoryValue* array, size_t element_index, const DPL_Value element)
 {
-    const size_t array_size = element_count * sizeof(DPL_Value);
+    switch (array->storage)
+    {
+    case ARRAY_STORAGE_VALUES:
+        ((DPL_Value *)array->data)[element_index] = element;
+        break;
+    case ARRAY_STORAGE_NUMBERS:
+        ((double *)array->data)[element_index] = dpl_value_as_number(element);
+        break;
+    case ARRAY_STORAGE_BOOLEANS:
+        ((bool *)array->data)[element_index] = dpl_value_as_boolean(element);
+        break;
+    }
+}
+
+static void dpl_value__acquire(const DPL_MemoryValue_Pool* pool, const DPL_Value value)
+{
+    if (dpl_value_is_item(value))
+    {
+        dpl_value_pool_acquire_item(pool, dpl_value_as_item(value));
+    }
+}
 
-    DPL_MemoryValue* item = dpl_value_pool_allocate_item(pool, array_size);
+static DPL_MemoryValue* dpl_value__allocate_array(DPL_MemoryValue_Pool* pool, DPL_ArrayStorage storage, const size_t element_count)
+{
+    DPL_MemoryValue* item = dpl_value_pool_allocate_item(pool, element_count * dpl_value__array_element_size(storage));
     item->kind = VALUE_ARRAY;
-    memcpy(item->data, elements, array_size);
+    item->storage = storage;
+    return item;
+}
+
+// TRIES
 
-    return (DPL_Value){
-        .kind = VALUE_ARRAY,
-        .as = {
-            .array = item}};
+static DPL_ArrayTrie* dpl_value__trie(DPL_MemoryValue* array)
+{
+    return (DPL_ArrayTrie*)array->data;
+}
+
+static DPL_MemoryValue* dpl_value__allocate_trie(DPL_MemoryValue_Pool* pool, DPL_ArrayStorage element_storage)
+{
+    DPL_MemoryValue* item = dpl_value_pool_allocate_item(pool, sizeof(DPL_ArrayTrie));
+    item->kind = VALUE_ARRAY;
+    item->storage = ARRAY_STORAGE_TRIE;
+    *dpl_value__trie(item) = (DPL_ArrayTrie) {
+        .element_storage = element_storage,
+    };
+    return item;
+}
+
+// A new trie sharing all nodes with `array`.
+static DPL_MemoryValue* dpl_value__copy_trie(DPL_MemoryValue_Pool* pool, DPL_MemoryValue* array)
+{
+    DPL_MemoryValue* item = dpl_value__allocate_trie(pool, ARRAY_STORAGE_VALUES);
+    *dpl_value__trie(item) = *dpl_value__trie(array);
+    if (dpl_value__trie(item)->root)
+    {
+        dpl_value_pool_acquire_item(pool, dpl_value__trie(item)->root);
+    }
+    return item;
+}
+
+static DPL_MemoryValue* dpl_value__trie_allocate_node(DPL_MemoryValue_Pool* pool, DPL_ArrayStorage storage)
+{
+    DPL_MemoryValue* node = dpl_value__allocate_array(pool, storage, DPL_ARRAY_TRIE_BRANCHING);
+    // All zero bytes are the number 0 in both value layouts.
+    memset(node->data, 0, node->size);
+    return node;
+}
+
+// Stores `element` in the unused slot at `position` below `node` (NULL if the
+// node does not exist yet). Takes over the reference to `node` and returns the
+// updated node, which is a copy if `node` is shared.
+static DPL_MemoryValue* dpl_value__trie_set(DPL_MemoryValue_Pool* pool, DPL_MemoryValue* node,
+                                            DPL_ArrayStorage element_storage, uint8_t shift,
+                                            uint64_t position, const DPL_Value element)
+{
+    if (node == NULL)
+    {
+        node = dpl_value__trie_allocate_node(pool, (shift == 0) ? element_storage : ARRAY_STORAGE_VALUES);
+    }
+    else if (!dpl_value_pool_will_release_item(pool, node))
+    {
+        DPL_MemoryValue* copy = dpl_value__allocate_array(pool, node->storage, DPL_ARRAY_TRIE_BRANCHING);
+        memcpy(copy->data, node->data, node->size);
+        if (node->storage == ARRAY_STORAGE_VALUES)
+        {
+            for (size_t i = 0; i < DPL_ARRAY_TRIE_BRANCHING; ++i)
+            {
+                dpl_value__acquire(pool, ((DPL_Value*)node->data)[i]);
+            }
+        }
+        // Still referenced elsewhere, so this never frees the node.
+        dpl_value_pool_release_item(pool, node);
+        node = copy;
+    }
+
+    const size_t slot = (position >> shift) & (DPL_ARRAY_TRIE_BRANCHING - 1);
+    if (shift == 0)
+    {
+        dpl_value__array_set_element(node, slot, element);
+        return node;
+    }
+
+    DPL_Value* children = (DPL_Value*)node->data;
+    DPL_MemoryValue* child = (dpl_value_kind(children[slot]) == VALUE_ARRAY) ? dpl_value_as_array(children[slot]) : NULL;
+    children[slot] = dpl_value_make_item(
+        VALUE_ARRAY, dpl_value__trie_set(pool, child, element_storage, shift - DPL_ARRAY_TRIE_BITS, position, element));
+    return node;
+}
+
+// Adds a level above the root, which becomes the child in `slot`.
+static void dpl_value__trie_grow(DPL_MemoryValue_Pool* pool, DPL_ArrayTrie* trie, size_t slot)
+{
+    DPL_MemoryValue* root = dpl_value__trie_allocate_node(pool, ARRAY_STORAGE_VALUES);
+    if (trie->root)
+    {
+        ((DPL_Value*)root->data)[slot] = dpl_value_make_item(VALUE_ARRAY, trie->root);
+    }
+
+    trie->origin += (uint64_t)slot << (trie->shift + DPL_ARRAY_TRIE_BITS);
+    trie->shift += DPL_ARRAY_TRIE_BITS;
+    trie->root = root;
+}
+
+static void dpl_value__trie_check_element(DPL_MemoryValue* array, const DPL_Value element)
+{
+    DPL_ArrayTrie* trie = dpl_value__trie(array);
+    if (trie->count == 0)
+    {
+        trie->element_storage = dpl_value__array_storage(1, &element);
+    }
+    else
+    {
+        dpl_value__check_element(array, trie->element_storage, element);
+    }
+}
+
+static void dpl_value__trie_push_back(DPL_MemoryValue_Pool* pool, DPL_MemoryValue* array, const DPL_Value element)
+{
+    dpl_value__trie_check_element(array, element);
+
+    DPL_ArrayTrie* trie = dpl_value__trie(array);
+    const uint64_t position = trie->origin + trie->count;
+    if ((position >> (trie->shift + DPL_ARRAY_TRIE_BITS)) != 0)
+    {
+        dpl_value__trie_grow(pool, trie, 0);
+    }
+
+    trie->root = dpl_value__trie_set(pool, trie->root, trie->element_storage, trie->shift, position, element);
+    trie->count++;
+}
+
+static void dpl_value__trie_push_front(DPL_MemoryValue_Pool* pool, DPL_MemoryValue* array, const DPL_Value element)
+{
+    dpl_value__trie_check_element(array, element);
+
+    DPL_ArrayTrie* trie = dpl_value__trie(array);
+    if (trie->origin == 0)
+    {
+        // Center the old root, so both ends have room to grow.
+        dpl_value__trie_grow(pool, trie, DPL_ARRAY_TRIE_BRANCHING / 2);
+    }
+
+    trie->origin--;
+    trie->root = dpl_value__trie_set(pool, trie->root, trie->element_storage, trie->shift, trie->origin, element);
+    trie->count++;
+}
+
+static DPL_Value dpl_value__trie_get_element(DPL_MemoryValue* array, uint32_t element_index)
+{
+    const DPL_ArrayTrie* trie = dpl_value__trie(array);
+    const uint64_t position = trie->origin + element_index;
+
+    DPL_MemoryValue* node = trie->root;
+    for (uint8_t shift = trie->shift; shift > 0; shift -= DPL_ARRAY_TRIE_BITS)
+    {
+        node = dpl_value_as_array(((DPL_Value*)node->data)[(position >> shift) & (DPL_ARRAY_TRIE_BRANCHING - 1)]);
+    }
+    return dpl_value_array_get_element(node, position & (DPL_ARRAY_TRIE_BRANCHING - 1));
+}
+
+// A trie holding the elements of the flat `array`, which stays unchanged.
+static DPL_MemoryValue* dpl_value__trie_from_array(DPL_MemoryValue_Pool* pool, DPL_MemoryValue* array)
+{
+    DPL_MemoryValue* item = dpl_value__allocate_trie(pool, array->storage);
+    const uint32_t element_count = dpl_value_array_element_count(array);
+    for (uint32_t i = 0; i < element_count; ++i)
+    {
+        const DPL_Value element = dpl_value_array_get_element(array, i);
+        dpl_value__acquire(pool, element);
+        dpl_value__trie_push_back(pool, item, element);
+    }
+    return item;
+}
+
+// ARRAYS
+
+DPL_Value dpl_value_make_array(DPL_MemoryValue_Pool* pool, const size_t element_count, const DPL_Value* elements)
+{
+    const DPL_ArrayStorage storage = dpl_value__array_storage(element_count, elements);
+    if (element_count > DPL_ARRAY_TRIE_THRESHOLD)
+    {
+        DPL_MemoryValue* item = dpl_value__allocate_trie(pool, storage);
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            dpl_value__trie_push_back(pool, item, elements[i]);
+        }
+        return dpl_value_make_item(VALUE_ARRAY, item);
+    }
+
+    DPL_MemoryValue* item = dpl_value__allocate_array(pool, storage, element_count);
+    if (item->storage == ARRAY_STORAGE_VALUES)
+    {
+        memcpy(item->data, elements, element_count * sizeof(DPL_Value));
+    }
+    else
+    {
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            dpl_value__array_set_element(item, i, elements[i]);
+        }
+    }
+
+    return dpl_value_make_item(VALUE_ARRAY, item);
+}
+
+DPL_Value dpl_value_make_number_array(DPL_MemoryValue_Pool* pool, const size_t element_count)
+{
+    return dpl_value_make_item(VALUE_ARRAY, dpl_value__allocate_array(pool, ARRAY_STORAGE_NUMBERS, element_count));
 }
 
 DPL_Value dpl_value_make_array_concat(DPL_MemoryValue_Pool* pool, DPL_MemoryValue* array, const DPL_Value new_item)
 {
-    DPL_MemoryValue* new_array = dpl_value_pool_allocate_item(pool, array->size + sizeof(DPL_Value));
-    new_array->kind = VALUE_ARRAY;
+    if (array->storage == ARRAY_STORAGE_TRIE)
+    {
+        DPL_MemoryValue* new_array = dpl_value__copy_trie(pool, array);
+        dpl_value__trie_push_back(pool, new_array, new_item);
+        return dpl_value_make_item(VALUE_ARRAY, new_array);
+    }
+
+    const size_t element_count = dpl_value_array_element_count(array);
+    if (element_count == 0)
+    {
+        return dpl_value_make_array(pool, 1, &new_item);
+    }
+    dpl_value__check_element(array, array->storage, new_item);
+
+    if (element_count + 1 > DPL_ARRAY_TRIE_THRESHOLD)
+    {
+        DPL_MemoryValue* new_array = dpl_value__trie_from_array(pool, array);
+        dpl_value__trie_push_back(pool, new_array, new_item);
+        return dpl_value_make_item(VALUE_ARRAY, new_array);
+    }
+
+    DPL_MemoryValue* new_array = dpl_value__allocate_array(pool, array->storage, element_count + 1);
     memcpy(new_array->data, array->data, array->size);
-    memcpy(new_array->data + array->size, &new_item, sizeof(DPL_Value));
+    if (array->storage == ARRAY_STORAGE_VALUES)
+    {
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            dpl_value__acquire(pool, ((DPL_Value*)array->data)[i]);
+        }
+    }
+    dpl_value__array_set_element(new_array, element_count, new_item);
 
-    return (DPL_Value){
-        .kind = VALUE_ARRAY,
-        .as = {
-            .array = new_array}};
+    return dpl_value_make_item(VALUE_ARRAY, new_array);
+}
+
+DPL_Value dpl_value_array_append(DPL_MemoryValue_Pool* pool, DPL_MemoryValue* array, const DPL_Value new_item)
+{
+    array->hash = 0;
+    if (array->storage == ARRAY_STORAGE_TRIE)
+    {
+        dpl_value__trie_push_back(pool, array, new_item);
+        return dpl_value_make_item(VALUE_ARRAY, array);
+    }
+
+    if (array->size == 0)
+    {
+        array->storage = dpl_value__array_storage(1, &new_item);
+    }
+    else
+    {
+        dpl_value__check_element(array, array->storage, new_item);
+    }
+
+    const size_t element_size = dpl_value__array_element_size(array->storage);
+    const size_t element_count = array->size / element_size;
+    if (element_count + 1 > DPL_ARRAY_TRIE_THRESHOLD)
+    {
+        // Long arrays become tries, like in dpl_value_make_array_concat. The
+        // elements move over, so their references stay untouched.
+        DPL_MemoryValue* new_array = dpl_value__allocate_trie(pool, array->storage);
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            dpl_value__trie_push_back(pool, new_array, dpl_value_array_get_element(array, i));
+        }
+        dpl_value_pool_free_item(pool, array);
+        dpl_value__trie_push_back(pool, new_array, new_item);
+        return dpl_value_make_item(VALUE_ARRAY, new_array);
+    }
+
+    if (array->size + element_size > array->capacity)
+    {
+        // The elements move over, so their references stay untouched.
+        DPL_MemoryValue* new_array = dpl_value__allocate_array(pool, array->storage, element_count + 1);
+        memcpy(new_array->data, array->data, array->size);
+        dpl_value_pool_free_item(pool, array);
+        array = new_array;
+    }
+    else
+    {
+        array->size += element_size;
+    }
+
+    dpl_value__array_set_element(array, element_count, new_item);
+    return dpl_value_make_item(VALUE_ARRAY, array);
+}
+
+DPL_Value dpl_value_make_array_extend(DPL_MemoryValue_Pool* pool, DPL_MemoryValue* array,
+                                      const uint32_t before_count, const DPL_Value* before,
+                                      const uint32_t after_count, const DPL_Value* after)
+{
+    if (before_count == 0 && after_count == 0)
+    {
+        dpl_value_pool_acquire_item(pool, array);
+        return dpl_value_make_item(VALUE_ARRAY, array);
+    }
+
+    const uint32_t element_count = dpl_value_array_element_count(array);
+    const size_t total_count = (size_t)before_count + element_count + after_count;
+    if (array->storage != ARRAY_STORAGE_TRIE && total_count <= DPL_ARRAY_TRIE_THRESHOLD)
+    {
+        DPL_Value elements[DPL_ARRAY_TRIE_THRESHOLD];
+        memcpy(elements, before, before_count * sizeof(DPL_Value));
+        for (uint32_t i = 0; i < element_count; ++i)
+        {
+            elements[before_count + i] = dpl_value_array_get_element(array, i);
+            dpl_value__acquire(pool, elements[before_count + i]);
+        }
+        memcpy(elements + before_count + element_count, after, after_count * sizeof(DPL_Value));
+        return dpl_value_make_array(pool, total_count, elements);
+    }
+
+    DPL_MemoryValue* new_array = (array->storage == ARRAY_STORAGE_TRIE)
+        ? dpl_value__copy_trie(pool, array)
+        : dpl_value__trie_from_array(pool, array);
+    for (uint32_t i = before_count; i > 0; --i)
+    {
+        dpl_value__trie_push_front(pool, new_array, before[i - 1]);
+    }
+    for (uint32_t i = 0; i < after_count; ++i)
+    {
+        dpl_value__trie_push_back(pool, new_array, after[i]);
+    }
+    return dpl_value_make_item(VALUE_ARRAY, new_array);
+}
+
+DPL_Value dpl_value_make_array_flat(DPL_MemoryValue_Pool* pool, DPL_MemoryValue* array)
+{
+    const uint32_t element_count = dpl_value_array_element_count(array);
+    const DPL_ArrayStorage storage = (array->storage == ARRAY_STORAGE_TRIE)
+        ? dpl_value__trie(array)->element_storage
+        : array->storage;
+
+    DPL_MemoryValue* new_array = dpl_value__allocate_array(pool, storage, element_count);
+    for (uint32_t i = 0; i < element_count; ++i)
+    {
+        const DPL_Value element = dpl_value_array_get_element(array, i);
+        dpl_value__acquire(pool, element);
+        dpl_value__array_set_element(new_array, i, element);
+    }
+    return dpl_value_make_item(VALUE_ARRAY, new_array);
 }
 
 DPL_Value dpl_value_make_array_slot()
 {
-    return (DPL_Value){
-        .kind = VALUE_ARRAY,
-        .as = {
-            .array = NULL}};
+    return dpl_value_make_item(VALUE_ARRAY, NULL);
 }
 
 int dpl_value_compare_numbers(double a, double b)
@@ -338,9 +956,9 @@ void dpl_value_print_sv(const Nob_String_View sv)
     printf("\"]");
 }
 
-void dpl_value_print_string(DPL_MemoryValue *value)
+void dpl_value_print_string(DPL_Value value)
 {
-    dpl_value_print_sv(nob_sv_from_parts((char*)value->data, value->size));
+    dpl_value_print_sv(dpl_value_string_sv(&value));
 }
 
 const char *dpl_value_format_boolean(bool value)
@@ -353,35 +971,68 @@ void dpl_value_print_boolean(bool value)
     printf("[%s: %s]", dpl_value_kind_name(VALUE_BOOLEAN), dpl_value_format_boolean(value));
 }
 
-uint8_t dpl_value_object_field_count(DPL_MemoryValue *object)
+uint32_t dpl_value_object_field_count(DPL_MemoryValue *object)
 {
-    return object->size / sizeof(DPL_Value);
+    return dpl_value_object_shape(object)->field_count;
 }
 
-DPL_Value dpl_value_object_get_field(DPL_MemoryValue *object, uint8_t field_index)
+DPL_Value dpl_value_object_get_field(DPL_MemoryValue *object, uint32_t field_index)
 {
-    return ((DPL_Value *)object->data)[field_index];
+    const DPL_ObjectShapeField field = dpl_value_object_shape(object)->fields[field_index];
+    switch (field.storage)
+    {
+    case ARRAY_STORAGE_NUMBERS:
+        return dpl_value_make_number(*(double *)(object->data + field.offset));
+    case ARRAY_STORAGE_BOOLEANS:
+        return dpl_value_make_boolean(*(bool *)(object->data + field.offset));
+    default:
+        return *(DPL_Value *)(object->data + field.offset);
+    }
 }
 
 void dpl_value_print_object(DPL_MemoryValue *object)
 {
-    uint8_t field_count = dpl_value_object_field_count(object);
-    printf("[%s(%d): ", dpl_value_kind_name(VALUE_OBJECT), field_count);
-    for (uint8_t field_index = 0; field_index < field_count; ++field_index)
+    uint32_t field_count = dpl_value_object_field_count(object);
+    printf("[%s(%u): ", dpl_value_kind_name(VALUE_OBJECT), field_count);
+    for (uint32_t field_index = 0; field_index < field_count; ++field_index)
     {
         dpl_value_print(dpl_value_object_get_field(object, field_index));
     }
     printf("]");
 }
 
-uint8_t dpl_value_array_element_count(DPL_MemoryValue *array)
+uint32_t dpl_value_array_element_count(DPL_MemoryValue *array)
 {
-    return array->size / sizeof(DPL_Value);
+    if (array->storage == ARRAY_STORAGE_TRIE)
+    {
+        return dpl_value__trie(array)->count;
+    }
+    return array->size / dpl_value__array_element_size(array->storage);
 }
 
-DPL_Value dpl_value_array_get_element(DPL_MemoryValue *array, uint8_t element_index)
+double *dpl_value_array_numbers(DPL_MemoryValue *array)
 {
-    return ((DPL_Value *)array->data)[element_index];
+    if (array->storage != ARRAY_STORAGE_NUMBERS && array->size > 0)
+    {
+        DW_ERROR("Array elements are not stored as numbers.");
+    }
+    return (double *)array->data;
+}
+
+DPL_Value dpl_value_array_get_element(DPL_MemoryValue *array, uint32_t element_index)
+{
+    switch (array->storage)
+    {
+    case ARRAY_STORAGE_NUMBERS:
+        return dpl_value_make_number(((double *)array->data)[element_index]);
+    case ARRAY_STORAGE_BOOLEANS:
+        return dpl_value_make_boolean(((bool *)array->data)[element_index]);
+    case ARRAY_STORAGE_TRIE:
+        return dpl_value__trie_get_element(array, element_index);
+    case ARRAY_STORAGE_VALUES:
+    default:
+        return ((DPL_Value *)array->data)[element_index];
+    }
 }
 
 void dpl_value_print_array(DPL_MemoryValue *array)
@@ -392,9 +1043,9 @@ void dpl_value_print_array(DPL_MemoryValue *array)
         return;
     }
 
-    uint8_t element_count = dpl_value_array_element_count(array);
-    printf("[%s(%d): ", dpl_value_kind_name(VALUE_ARRAY), element_count);
-    for (uint8_t element_index = 0; element_index < element_count; ++element_index)
+    uint32_t element_count = dpl_value_array_element_count(array);
+    printf("[%s(%u): ", dpl_value_kind_name(VALUE_ARRAY), element_count);
+    for (uint32_t element_index = 0; element_index < element_count; ++element_index)
     {
         dpl_value_print(dpl_value_array_get_element(array, element_index));
     }
@@ -403,26 +1054,26 @@ void dpl_value_print_array(DPL_MemoryValue *array)
 
 void dpl_value_print(DPL_Value value)
 {
-    switch (value.kind)
+    switch (dpl_value_kind(value))
     {
     case VALUE_NUMBER:
-        dpl_value_print_number(value.as.number);
+        dpl_value_print_number(dpl_value_as_number(value));
         break;
     case VALUE_STRING:
-        dpl_value_print_string(value.as.string);
+        dpl_value_print_string(value);
         break;
     case VALUE_BOOLEAN:
-        dpl_value_print_boolean(value.as.boolean);
+        dpl_value_print_boolean(dpl_value_as_boolean(value));
         break;
     case VALUE_OBJECT:
-        dpl_value_print_object(value.as.object);
+        dpl_value_print_object(dpl_value_as_object(value));
         break;
     case VALUE_ARRAY:
-        dpl_value_print_array(value.as.array);
+        dpl_value_print_array(dpl_value_as_array(value));
         break;
     default:
         DW_UNIMPLEMENTED_MSG("Cannot debug print value of kind `%s`.",
-                             dpl_value_kind_name(value.kind));
+                             dpl_value_kind_name(dpl_value_kind(value)));
     }
 }
 
@@ -431,13 +1082,33 @@ bool dpl_value_number_equals(double number1, double number2)
     return fabs(number1 - number2) < DPL_VALUE_EPSILON;
 }
 
-bool dpl_value_string_equals(DPL_MemoryValue *string1, DPL_MemoryValue *string2)
+// Whether two items are known to differ by their hashes. Computes and caches
+// the hashes if needed.
+static bool dpl_value__hashes_differ(DPL_Value value1, DPL_Value value2)
+{
+    return dpl_value_hash(value1) != dpl_value_hash(value2);
+}
+
+bool dpl_value_string_equals(DPL_Value string1, DPL_Value string2)
 {
-    if (string1->size != string2->size)
+    const Nob_String_View sv1 = dpl_value_string_sv(&string1);
+    const Nob_String_View sv2 = dpl_value_string_sv(&string2);
+    if (sv1.count != sv2.count)
     {
         return false;
     }
-    return (memcmp(string1->data, string2->data, string1->size) == 0);
+    if (dpl_value_is_item(string1) && dpl_value_is_item(string2))
+    {
+        if (dpl_value_as_string(string1) == dpl_value_as_string(string2))
+        {
+            return true;
+        }
+        if (dpl_value__hashes_differ(string1, string2))
+        {
+            return false;
+        }
+    }
+    return memcmp(sv1.data, sv2.data, sv1.count) == 0;
 }
 
 bool dpl_value_boolean_equals(const bool boolean1, const bool boolean2)
@@ -447,8 +1118,14 @@ bool dpl_value_boolean_equals(const bool boolean1, const bool boolean2)
 
 bool dpl_value_object_equals(DPL_MemoryValue *object1, DPL_MemoryValue *object2)
 {
+    if (object1 == object2)
+    {
+        return true;
+    }
+
     const size_t count = dpl_value_object_field_count(object1);
-    if (count != dpl_value_object_field_count(object2))
+    if (count != dpl_value_object_field_count(object2)
+        || dpl_value__hashes_differ(dpl_value_make_item(VALUE_OBJECT, object1), dpl_value_make_item(VALUE_OBJECT, object2)))
     {
         return false;
     }
@@ -474,9 +1151,14 @@ bool dpl_value_array_equals(DPL_MemoryValue *array1, DPL_MemoryValue *array2)
     {
         return false;
     }
+    if (array1 == array2)
+    {
+        return true;
+    }
 
     const size_t count = dpl_value_array_element_count(array1);
-    if (count != dpl_value_array_element_count(array2))
+    if (count != dpl_value_array_element_count(array2)
+        || dpl_value__hashes_differ(dpl_value_make_item(VALUE_ARRAY, array1), dpl_value_make_item(VALUE_ARRAY, array2)))
     {
         return false;
     }
@@ -495,24 +1177,124 @@ bool dpl_value_array_equals(DPL_MemoryValue *array1, DPL_MemoryValue *array2)
 
 bool dpl_value_equals(DPL_Value value1, DPL_Value value2)
 {
-    if (value1.kind != value2.kind)
+    if (dpl_value_kind(value1) != dpl_value_kind(value2))
     {
         return false;
     }
 
-    switch (value1.kind)
+    switch (dpl_value_kind(value1))
     {
     case VALUE_NUMBER:
-        return dpl_value_number_equals(value1.as.number, value2.as.number);
+        return dpl_value_number_equals(dpl_value_as_number(value1), dpl_value_as_number(value2));
     case VALUE_STRING:
-        return dpl_value_string_equals(value1.as.string, value2.as.string);
+        return dpl_value_string_equals(value1, value2);
     case VALUE_BOOLEAN:
-        return dpl_value_boolean_equals(value1.as.boolean, value2.as.boolean);
+        return dpl_value_boolean_equals(dpl_value_as_boolean(value1), dpl_value_as_boolean(value2));
     case VALUE_OBJECT:
-        return dpl_value_object_equals(value1.as.object, value2.as.object);
+        return dpl_value_object_equals(dpl_value_as_object(value1), dpl_value_as_object(value2));
     case VALUE_ARRAY:
-        return dpl_value_array_equals(value1.as.array, value2.as.array);
+        return dpl_value_array_equals(dpl_value_as_array(value1), dpl_value_as_array(value2));
+    default:
+        DW_ERROR("Cannot compare values of unknown kind `%d`.", dpl_value_kind(value1));
+    }
+}
+
+// FNV-1a, applied to 32-bit words for combining hashes.
+#define DPL_VALUE_HASH_OFFSET 2166136261u
+#define DPL_VALUE_HASH_PRIME 16777619u
+
+static uint32_t dpl_value__hash_combine(uint32_t hash, uint32_t value)
+{
+    return (hash ^ value) * DPL_VALUE_HASH_PRIME;
+}
+
+static uint32_t dpl_value__hash_bytes(uint32_t hash, const uint8_t *data, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash = (hash ^ data[i]) * DPL_VALUE_HASH_PRIME;
+    }
+    return hash;
+}
+
+static uint32_t dpl_value__hash_item(DPL_MemoryValue *item)
+{
+    uint32_t hash = dpl_value__hash_combine(DPL_VALUE_HASH_OFFSET, item->kind);
+    switch (item->kind)
+    {
+    case VALUE_STRING:
+        return dpl_value__hash_bytes(hash, item->data, item->size);
+    case VALUE_OBJECT:
+    {
+        const uint32_t count = dpl_value_object_field_count(item);
+        hash = dpl_value__hash_combine(hash, count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            hash = dpl_value__hash_combine(hash, dpl_value_hash(dpl_value_object_get_field(item, i)));
+        }
+        return hash;
+    }
+    case VALUE_ARRAY:
+    {
+        const uint32_t count = dpl_value_array_element_count(item);
+        hash = dpl_value__hash_combine(hash, count);
+        // Numbers only hash their kind, so they are left out. That way number
+        // arrays skip their elements, whether they are flat or tries.
+        const DPL_ArrayStorage storage = (item->storage == ARRAY_STORAGE_TRIE)
+            ? dpl_value__trie(item)->element_storage
+            : item->storage;
+        if (storage == ARRAY_STORAGE_NUMBERS)
+        {
+            return hash;
+        }
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const DPL_Value element = dpl_value_array_get_element(item, i);
+            if (dpl_value_kind(element) != VALUE_NUMBER)
+            {
+                hash = dpl_value__hash_combine(hash, dpl_value_hash(element));
+            }
+        }
+        return hash;
+    }
+    default:
+        DW_ERROR("Cannot hash items of kind `%d`.", item->kind);
+    }
+}
+
+uint32_t dpl_value_hash(DPL_Value value)
+{
+    const DPL_ValueKind kind = dpl_value_kind(value);
+    switch (kind)
+    {
+    case VALUE_NUMBER:
+        return dpl_value__hash_combine(DPL_VALUE_HASH_OFFSET, kind);
+    case VALUE_BOOLEAN:
+        return dpl_value__hash_combine(dpl_value__hash_combine(DPL_VALUE_HASH_OFFSET, kind), dpl_value_as_boolean(value));
+    case VALUE_STRING:
+    case VALUE_OBJECT:
+    case VALUE_ARRAY:
+    {
+        if (!dpl_value_is_item(value))
+        {
+            const Nob_String_View sv = dpl_value_string_sv(&value);
+            return dpl_value__hash_bytes(dpl_value__hash_combine(DPL_VALUE_HASH_OFFSET, kind), (const uint8_t *)sv.data, sv.count);
+        }
+
+        DPL_MemoryValue *item = dpl_value_as_item(value);
+        if (item == NULL)
+        {
+            return dpl_value__hash_combine(dpl_value__hash_combine(DPL_VALUE_HASH_OFFSET, kind), 0);
+        }
+        if (item->hash == 0)
+        {
+            const uint32_t hash = dpl_value__hash_item(item);
+            // 0 marks hashes that are not computed yet.
+            item->hash = (hash == 0) ? 1 : hash;
+        }
+        return item->hash;
+    }
     default:
-        DW_ERROR("Cannot compare values of unknown kind `%d`.", value1.kind);
+        DW_ERROR("Cannot hash values of unknown kind `%d`.", kind);
     }
 }
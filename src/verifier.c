@@ -0,0 +1,487 @@
+#ifdef DPL_LEAKCHECK
+#include <stb_leakcheck.h>
+#endif
+
+#include <dw_error.h>
+#include <dpl/verifier.h>
+
+#define DPL_VERIFIER_MAX_ARRAY_NESTING 16
+
+// Abstract machine state before an instruction. Depths are counted relative
+// to the base of the current callframe (including the function arguments).
+typedef struct
+{
+    bool visited;
+    uint32_t function;
+    uint32_t depth;
+    uint32_t array_count;
+    // Depth of the array slot pushed by each BEGIN_ARRAY that is still open.
+    uint32_t arrays[DPL_VERIFIER_MAX_ARRAY_NESTING];
+} DPL_Verifier_State;
+
+typedef struct
+{
+    size_t *items;
+    size_t count;
+    size_t capacity;
+} DPL_Verifier_Worklist;
+
+typedef struct
+{
+    DPL_Program *program;
+
+    // Maps byte offsets to instruction indices (SIZE_MAX if no instruction
+    // starts there). The additional entry maps the end of the code.
+    size_t *instruction_indices;
+    size_t *instruction_ips;
+    size_t instruction_count;
+
+    DPL_Verifier_State *states;
+    DPL_Verifier_Worklist worklist;
+} DPL_Verifier;
+
+#define DPL_VERIFIER_ERROR(ip, format, ...)                                                         \
+    do                                                                                              \
+    {                                                                                               \
+        DW_ERROR_MSGLN("Invalid program: " format " (at position %zu).", ##__VA_ARGS__, (size_t)(ip)); \
+        return false;                                                                               \
+    } while (false)
+
+static bool dplp_verify__decode(DPL_Verifier *verifier)
+{
+    DW_ByteBuffer code = verifier->program->code;
+
+    verifier->instruction_indices = malloc((code.count + 1) * sizeof(*verifier->instruction_indices));
+    verifier->instruction_ips = malloc((code.count + 1) * sizeof(*verifier->instruction_ips));
+    for (size_t i = 0; i <= code.count; ++i)
+    {
+        verifier->instruction_indices[i] = SIZE_MAX;
+    }
+
+    size_t ip = 0;
+    while (ip < code.count)
+    {
+        DPL_Instruction_Kind kind = code.items[ip];
+        if (kind >= COUNT_INSTRUCTIONS)
+        {
+            DPL_VERIFIER_ERROR(ip, "Unknown instruction %u", kind);
+        }
+
+        size_t size = 1 + dplp_inst_operand_size(kind);
+        if (ip + size > code.count)
+        {
+            DPL_VERIFIER_ERROR(ip, "Truncated instruction `%s`", dplp_inst_kind_name(kind));
+        }
+
+        verifier->instruction_indices[ip] = verifier->instruction_count;
+        verifier->instruction_ips[verifier->instruction_count] = ip;
+        ++verifier->instruction_count;
+
+        ip += size;
+    }
+
+    verifier->instruction_indices[code.count] = verifier->instruction_count;
+    verifier->instruction_ips[verifier->instruction_count] = code.count;
+    return true;
+}
+
+static bool dplp_verify__function(DPL_Verifier *verifier, size_t ip, size_t begin_ip, size_t arity, size_t *function)
+{
+    DPL_Program_Functions *functions = &verifier->program->functions;
+    if (begin_ip >= verifier->program->code.count || verifier->instruction_indices[begin_ip] == SIZE_MAX)
+    {
+        DPL_VERIFIER_ERROR(ip, "Invalid function address %zu", begin_ip);
+    }
+
+    for (size_t i = 0; i < functions->count; ++i)
+    {
+        if (functions->items[i].begin_ip == begin_ip)
+        {
+            if (functions->items[i].arity != arity)
+            {
+                DPL_VERIFIER_ERROR(ip, "Function at %zu called with arity %zu instead of %zu", begin_ip, arity,
+                                   functions->items[i].arity);
+            }
+            *function = i;
+            return true;
+        }
+    }
+
+    // Functions are entered with their arguments on the stack.
+    DPL_Program_Function new_function = {
+        .begin_ip = begin_ip,
+        .arity = arity,
+        .max_stack_depth = arity,
+    };
+    nob_da_append(functions, new_function);
+    *function = functions->count - 1;
+
+    DPL_Verifier_State state = {
+        .function = *function,
+        .depth = arity,
+    };
+    size_t index = verifier->instruction_indices[begin_ip];
+    if (verifier->states[index].visited)
+    {
+        DPL_VERIFIER_ERROR(ip, "Function at %zu overlaps with other code", begin_ip);
+    }
+    verifier->states[index] = state;
+    verifier->states[index].visited = true;
+    nob_da_append(&verifier->worklist, index);
+    return true;
+}
+
+// Merges `state` into the state before the instruction at `target_ip`.
+static bool dplp_verify__flow(DPL_Verifier *verifier, size_t ip, size_t target_ip, DPL_Verifier_State state)
+{
+    DW_ByteBuffer code = verifier->program->code;
+    if (target_ip > code.count || verifier->instruction_indices[target_ip] == SIZE_MAX)
+    {
+        DPL_VERIFIER_ERROR(ip, "Invalid jump target %zu", target_ip);
+    }
+
+    // Values left at the end of the code occupy the stack as well.
+    DPL_Program_Function *function = &verifier->program->functions.items[state.function];
+    if (state.depth > function->max_stack_depth)
+    {
+        function->max_stack_depth = state.depth;
+    }
+
+    if (target_ip == code.count)
+    {
+        if (state.function != 0)
+        {
+            DPL_VERIFIER_ERROR(ip, "Control flow leaves the function at the end of the code");
+        }
+        return true;
+    }
+
+    size_t index = verifier->instruction_indices[target_ip];
+    DPL_Verifier_State *target = &verifier->states[index];
+    if (!target->visited)
+    {
+        *target = state;
+        target->visited = true;
+        nob_da_append(&verifier->worklist, index);
+        return true;
+    }
+
+    if (target->function != state.function)
+    {
+        DPL_VERIFIER_ERROR(ip, "Control flow crosses into another function at %zu", target_ip);
+    }
+    if (target->depth != state.depth || target->array_count != state.array_count
+        || memcmp(target->arrays, state.arrays, state.array_count * sizeof(*state.arrays)) != 0)
+    {
+        DPL_VERIFIER_ERROR(ip, "Inconsistent stack at %zu (%u vs. %u values)", target_ip, target->depth, state.depth);
+    }
+
+    return true;
+}
+
+#define DPL_VERIFIER_POP(count)                                                                   \
+    do                                                                                            \
+    {                                                                                             \
+        size_t __count = (count);                                                                 \
+        if (state.depth < __count                                                                 \
+            || (state.array_count > 0 && state.depth - __count < state.arrays[state.array_count - 1] + 1)) \
+        {                                                                                         \
+            DPL_VERIFIER_ERROR(ip, "Stack underflow in `%s`", dplp_inst_kind_name(kind));         \
+        }                                                                                         \
+        state.depth -= __count;                                                                   \
+    } while (false)
+
+#define DPL_VERIFIER_LOCAL(slot)                                                                  \
+    do                                                                                            \
+    {                                                                                             \
+        if ((slot) >= state.depth)                                                                \
+        {                                                                                         \
+            DPL_VERIFIER_ERROR(ip, "Invalid local slot %zu in `%s`", (size_t)(slot),              \
+                               dplp_inst_kind_name(kind));                                        \
+        }                                                                                         \
+    } while (false)
+
+static bool dplp_verify__instruction(DPL_Verifier *verifier, size_t index)
+{
+    DPL_Program *program = verifier->program;
+    DPL_Verifier_State state = verifier->states[index];
+    const DPL_Program_Function function = program->functions.items[state.function];
+    const bool in_entry = state.function == 0;
+
+    const size_t ip = verifier->instruction_ips[index];
+    const DPL_Instruction_Kind kind = program->code.items[ip];
+    const uint8_t *operands = program->code.items + ip + 1;
+    const size_t next_ip = verifier->instruction_ips[index + 1];
+
+    switch (kind)
+    {
+    case INST_NOOP:
+        break;
+    case INST_PUSH_NUMBER:
+    case INST_PUSH_BOOLEAN:
+    case INST_BEGIN_ARRAY:
+        if (kind == INST_BEGIN_ARRAY)
+        {
+            if (state.array_count >= DPL_VERIFIER_MAX_ARRAY_NESTING)
+            {
+                DPL_VERIFIER_ERROR(ip, "Array literals nested too deeply");
+            }
+            state.arrays[state.array_count++] = state.depth;
+        }
+        state.depth += 1;
+        break;
+    case INST_PUSH_STRING:
+    {
+        size_t offset = *(uint64_t *)operands;
+        DW_ByteBuffer constants = program->constants;
+        if (offset > constants.count || constants.count - offset < sizeof(uint64_t)
+            || *(uint64_t *)(constants.items + offset) > constants.count - offset - sizeof(uint64_t))
+        {
+            DPL_VERIFIER_ERROR(ip, "Invalid string constant offset %zu", offset);
+        }
+        state.depth += 1;
+    }
+    break;
+    case INST_POP:
+        DPL_VERIFIER_POP(1);
+        break;
+    case INST_NEGATE:
+    case INST_NOT:
+    case INST_LOAD_FIELD:
+    case INST_LOAD_FIELD_NUMBER:
+    case INST_LOAD_FIELD_BOOLEAN:
+        DPL_VERIFIER_POP(1);
+        state.depth += 1;
+        break;
+    case INST_ADD_NUMBER:
+    case INST_SUBTRACT:
+    case INST_MULTIPLY:
+    case INST_DIVIDE:
+    case INST_LESS:
+    case INST_LESS_EQUAL:
+    case INST_GREATER:
+    case INST_GREATER_EQUAL:
+    case INST_EQUAL_NUMBER:
+    case INST_NOT_EQUAL_NUMBER:
+    case INST_EQUAL_STRING:
+    case INST_NOT_EQUAL_STRING:
+    case INST_EQUAL_BOOLEAN:
+    case INST_NOT_EQUAL_BOOLEAN:
+    case INST_CONCAT_STRING:
+    case INST_CONCAT_ARRAY:
+        DPL_VERIFIER_POP(2);
+        state.depth += 1;
+        break;
+    case INST_CALL_INTRINSIC:
+    {
+        DPL_Intrinsic_Kind intrinsic = operands[0];
+        if (intrinsic >= COUNT_INTRINSICS)
+        {
+            DPL_VERIFIER_ERROR(ip, "Unknown intrinsic %u", intrinsic);
+        }
+        DPL_VERIFIER_POP(dpl_intrinsic_kind_arity(intrinsic));
+        state.depth += 1;
+    }
+    break;
+    case INST_CALL_USER:
+    case INST_TAIL_CALL_USER:
+    {
+        size_t arity = operands[0];
+        size_t callee;
+        if (!dplp_verify__function(verifier, ip, *(uint64_t *)(operands + 1), arity, &callee))
+        {
+            return false;
+        }
+
+        if (kind == INST_TAIL_CALL_USER)
+        {
+            if (in_entry || state.array_count > 0)
+            {
+                DPL_VERIFIER_ERROR(ip, "Tail call outside of a function body");
+            }
+            DPL_VERIFIER_POP(arity);
+            return true;
+        }
+
+        DPL_VERIFIER_POP(arity);
+        state.depth += 1;
+    }
+    break;
+    case INST_PUSH_LOCAL:
+    case INST_PUSH_LOCAL_MOVE:
+        DPL_VERIFIER_LOCAL(*(uint64_t *)operands);
+        state.depth += 1;
+        break;
+    case INST_STORE_LOCAL:
+        DPL_VERIFIER_LOCAL(*(uint64_t *)operands);
+        break;
+    case INST_APPEND_LOCAL:
+        DPL_VERIFIER_POP(1);
+        DPL_VERIFIER_LOCAL(*(uint64_t *)operands);
+        state.depth += 1;
+        break;
+    case INST_ITERATE_RANGE:
+    case INST_ITERATE_ARRAY:
+        DPL_VERIFIER_LOCAL(*(uint64_t *)operands + 1);
+        state.depth += 1;
+        break;
+    case INST_POP_SCOPE:
+    {
+        uint64_t scope_size = *(uint64_t *)operands;
+        if (scope_size >= state.depth)
+        {
+            DPL_VERIFIER_ERROR(ip, "Stack underflow in `%s`", dplp_inst_kind_name(kind));
+        }
+        DPL_VERIFIER_POP(scope_size + 1);
+        state.depth += 1;
+    }
+    break;
+    case INST_RETURN:
+        if (in_entry)
+        {
+            DPL_VERIFIER_ERROR(ip, "Return outside of a function body");
+        }
+        if (state.depth != function.arity + 1 || state.array_count > 0)
+        {
+            DPL_VERIFIER_ERROR(ip, "Function returns with %u values on the stack instead of %zu",
+                               state.depth, function.arity + 1);
+        }
+        return true;
+    case INST_JUMP:
+        return dplp_verify__flow(verifier, ip, next_ip + *(uint16_t *)operands, state);
+    case INST_JUMP_LOOP:
+    {
+        uint16_t jump = *(uint16_t *)operands;
+        if (jump > next_ip)
+        {
+            DPL_VERIFIER_ERROR(ip, "Invalid jump target");
+        }
+        return dplp_verify__flow(verifier, ip, next_ip - jump, state);
+    }
+    case INST_JUMP_IF_FALSE:
+    case INST_JUMP_IF_TRUE:
+        DPL_VERIFIER_POP(1);
+        state.depth += 1;
+        if (!dplp_verify__flow(verifier, ip, next_ip + *(uint16_t *)operands, state))
+        {
+            return false;
+        }
+        break;
+    case INST_LESS_JUMP_IF_FALSE:
+    {
+        DPL_VERIFIER_POP(2);
+        DPL_Verifier_State jump_state = state;
+        jump_state.depth += 1;
+        if (!dplp_verify__flow(verifier, ip, next_ip + *(uint16_t *)operands, jump_state))
+        {
+            return false;
+        }
+    }
+    break;
+    case INST_CREATE_OBJECT:
+    case INST_INTERPOLATION:
+    {
+        uint32_t count = *(uint32_t *)operands;
+        if (count == 0)
+        {
+            DPL_VERIFIER_ERROR(ip, "`%s` without values", dplp_inst_kind_name(kind));
+        }
+        DPL_VERIFIER_POP(count);
+        state.depth += 1;
+    }
+    break;
+    case INST_END_ARRAY:
+        if (state.array_count == 0)
+        {
+            DPL_VERIFIER_ERROR(ip, "`%s` without matching `%s`", dplp_inst_kind_name(kind),
+                               dplp_inst_kind_name(INST_BEGIN_ARRAY));
+        }
+        state.depth = state.arrays[--state.array_count] + 1;
+        break;
+    case INST_CREATE_OBJECT_REUSE:
+    {
+        uint32_t count = *(uint32_t *)operands;
+        if (count == 0)
+        {
+            DPL_VERIFIER_ERROR(ip, "`%s` without values", dplp_inst_kind_name(kind));
+        }
+        DPL_VERIFIER_POP(count);
+        // The reused object lives in a local below the field values.
+        DPL_VERIFIER_LOCAL(*(uint64_t *)(operands + sizeof(uint32_t)));
+        state.depth += 1;
+    }
+    break;
+    case INST_EXTEND_ARRAY:
+        DPL_VERIFIER_POP(*(uint32_t *)operands + *(uint32_t *)(operands + sizeof(uint32_t)) + 1);
+        state.depth += 1;
+        break;
+    case INST_SPREAD:
+        // The number of spread elements is only known at runtime. The VM
+        // reserves stack space for them, so only the array slot is tracked.
+        if (state.array_count == 0)
+        {
+            DPL_VERIFIER_ERROR(ip, "`%s` outside of an array literal", dplp_inst_kind_name(kind));
+        }
+        DPL_VERIFIER_POP(1);
+        state.depth = state.arrays[state.array_count - 1] + 1;
+        break;
+    case INST_ADD_LOCAL_NUMBER:
+        DPL_VERIFIER_LOCAL(*(uint64_t *)operands);
+        DPL_VERIFIER_LOCAL(*(uint64_t *)(operands + sizeof(uint64_t) + sizeof(double)));
+        state.depth += 1;
+        break;
+    case INST_LOAD_LOCAL_FIELD:
+    case INST_LOAD_LOCAL_FIELD_NUMBER:
+    case INST_LOAD_LOCAL_FIELD_BOOLEAN:
+        DPL_VERIFIER_LOCAL(*(uint64_t *)operands);
+        state.depth += 1;
+        break;
+    default:
+        DPL_VERIFIER_ERROR(ip, "Unknown instruction %u", kind);
+    }
+
+    return dplp_verify__flow(verifier, ip, next_ip, state);
+}
+
+bool dplp_verify(DPL_Program *program)
+{
+    program->verified = false;
+    program->functions.count = 0;
+
+    DPL_Verifier verifier = {
+        .program = program,
+    };
+
+    bool result = dplp_verify__decode(&verifier);
+    if (result)
+    {
+        verifier.states = malloc((verifier.instruction_count + 1) * sizeof(*verifier.states));
+        memset(verifier.states, 0, (verifier.instruction_count + 1) * sizeof(*verifier.states));
+
+        size_t entry_function;
+        if (program->entry == program->code.count)
+        {
+            // Empty entry code, the program does nothing.
+            DPL_Program_Function entry = {.begin_ip = program->entry};
+            nob_da_append(&program->functions, entry);
+        }
+        else
+        {
+            result = dplp_verify__function(&verifier, program->entry, program->entry, 0, &entry_function);
+        }
+
+        while (result && verifier.worklist.count > 0)
+        {
+            size_t index = verifier.worklist.items[--verifier.worklist.count];
+            result = dplp_verify__instruction(&verifier, index);
+        }
+    }
+
+    free(verifier.instruction_indices);
+    free(verifier.instruction_ips);
+    free(verifier.states);
+    nob_da_free(verifier.worklist);
+
+    program->verified = result;
+    return result;
+}
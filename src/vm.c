@@ -2,7 +2,9 @@
 #include <stb_leakcheck.h>
 #endif
 
+#include <dpl/verifier.h>
 #include <dpl/vm/intrinsics.h>
+#include <dpl/vm/jit.h>
 #include <dpl/vm/vm.h>
 
 #include <dw_error.h>
@@ -19,6 +21,208 @@ int dplv_print(void* context, char const *str, ...)
     return n;
 }
 
+static DPL_Instruction _dplv_decode_instruction(DW_ByteStream *code, DW_ByteBuffer constants, Arena *memory)
+{
+    DPL_Instruction instruction = {0};
+    instruction.ip = code->position;
+    instruction.kind = bs_read_u8(code);
+
+    switch (instruction.kind)
+    {
+    case INST_NOOP:
+    case INST_POP:
+    case INST_NEGATE:
+    case INST_NOT:
+    case INST_ADD_NUMBER:
+    case INST_SUBTRACT:
+    case INST_MULTIPLY:
+    case INST_DIVIDE:
+    case INST_LESS:
+    case INST_LESS_EQUAL:
+    case INST_GREATER:
+    case INST_GREATER_EQUAL:
+    case INST_EQUAL_NUMBER:
+    case INST_NOT_EQUAL_NUMBER:
+    case INST_EQUAL_STRING:
+    case INST_NOT_EQUAL_STRING:
+    case INST_EQUAL_BOOLEAN:
+    case INST_NOT_EQUAL_BOOLEAN:
+    case INST_CONCAT_STRING:
+    case INST_RETURN:
+    case INST_BEGIN_ARRAY:
+    case INST_END_ARRAY:
+    case INST_CONCAT_ARRAY:
+    case INST_SPREAD:
+        break;
+    case INST_PUSH_NUMBER:
+        instruction.as.number = bs_read_f64(code);
+        break;
+    case INST_PUSH_STRING:
+    {
+        Nob_String_View value = bb_read_sv(constants, bs_read_u64(code));
+        instruction.as.string = dpl_value_make_constant_string(memory, value.count, value.data);
+    }
+    break;
+    case INST_PUSH_BOOLEAN:
+        instruction.as.boolean = bs_read_u8(code) == 1;
+        break;
+    case INST_CALL_INTRINSIC:
+        instruction.count = bs_read_u8(code);
+        break;
+    case INST_CREATE_OBJECT:
+    case INST_LOAD_FIELD:
+    case INST_LOAD_FIELD_NUMBER:
+    case INST_LOAD_FIELD_BOOLEAN:
+    case INST_INTERPOLATION:
+        instruction.count = bs_read_u32(code);
+        break;
+    case INST_PUSH_LOCAL:
+    case INST_PUSH_LOCAL_MOVE:
+    case INST_STORE_LOCAL:
+    case INST_POP_SCOPE:
+    case INST_ITERATE_RANGE:
+    case INST_ITERATE_ARRAY:
+    case INST_APPEND_LOCAL:
+        instruction.as.index = bs_read_u64(code);
+        break;
+    case INST_CALL_USER:
+    case INST_TAIL_CALL_USER:
+        instruction.count = bs_read_u8(code);
+        instruction.as.call.target = bs_read_u64(code);
+        break;
+    case INST_JUMP:
+    case INST_JUMP_IF_FALSE:
+    case INST_JUMP_IF_TRUE:
+    {
+        uint16_t jump = bs_read_u16(code);
+        instruction.as.index = code->position + jump;
+    }
+    break;
+    case INST_JUMP_LOOP:
+    {
+        uint16_t jump = bs_read_u16(code);
+        instruction.as.index = code->position - jump;
+    }
+    break;
+    case INST_ADD_LOCAL_NUMBER:
+        instruction.as.update.source = bs_read_u64(code);
+        instruction.as.update.number = bs_read_f64(code);
+        instruction.as.update.target = bs_read_u64(code);
+        break;
+    case INST_LOAD_LOCAL_FIELD:
+    case INST_LOAD_LOCAL_FIELD_NUMBER:
+    case INST_LOAD_LOCAL_FIELD_BOOLEAN:
+        instruction.as.index = bs_read_u64(code);
+        instruction.count = bs_read_u32(code);
+        break;
+    case INST_EXTEND_ARRAY:
+        instruction.count = bs_read_u32(code);
+        instruction.as.index = bs_read_u32(code);
+        break;
+    case INST_CREATE_OBJECT_REUSE:
+        instruction.count = bs_read_u32(code);
+        instruction.as.index = bs_read_u64(code);
+        break;
+    case INST_LESS_JUMP_IF_FALSE:
+    {
+        uint16_t jump = bs_read_u16(code);
+        instruction.as.index = code->position + jump;
+    }
+    break;
+    default:
+        DW_ERROR("Fatal Error: Cannot decode unknown instruction %d at position %zu.", instruction.kind, instruction.ip);
+    }
+
+    return instruction;
+}
+
+static size_t _dplv_resolve_target(size_t *instruction_indices, size_t code_count, size_t target_ip)
+{
+    if (target_ip > code_count || instruction_indices[target_ip] == SIZE_MAX)
+    {
+        DW_ERROR("Fatal Error: Invalid jump target %zu in program code.", target_ip);
+    }
+    return instruction_indices[target_ip];
+}
+
+static size_t _dplv_function_stack_depth(const DPL_Program *program, size_t begin_ip)
+{
+    for (size_t i = 0; i < program->functions.count; ++i)
+    {
+        if (program->functions.items[i].begin_ip == begin_ip)
+        {
+            return program->functions.items[i].max_stack_depth;
+        }
+    }
+
+    DW_ERROR("Fatal Error: Call of unverified function at %zu in program code.", begin_ip);
+}
+
+static void _dplv_decode(DPL_VirtualMachine *vm)
+{
+    DW_ByteBuffer code = vm->program->code;
+
+    // Maps each byte offset in the program code to the index of the instruction
+    // starting there (or SIZE_MAX). The additional entry maps the end of the code.
+    size_t *instruction_indices = malloc((code.count + 1) * sizeof(*instruction_indices));
+    for (size_t i = 0; i <= code.count; ++i)
+    {
+        instruction_indices[i] = SIZE_MAX;
+    }
+
+    struct
+    {
+        DPL_Instruction *items;
+        size_t count;
+        size_t capacity;
+    } instructions = {0};
+
+    DW_ByteStream stream = {.buffer = code};
+    while (!bs_at_end(&stream))
+    {
+        instruction_indices[stream.position] = instructions.count;
+        nob_da_append(&instructions, _dplv_decode_instruction(&stream, vm->program->constants, &vm->memory));
+    }
+    instruction_indices[code.count] = instructions.count;
+
+    for (size_t i = 0; i < instructions.count; ++i)
+    {
+        DPL_Instruction *instruction = &instructions.items[i];
+        switch (instruction->kind)
+        {
+        case INST_CALL_USER:
+        case INST_TAIL_CALL_USER:
+            instruction->as.call.max_stack_depth = _dplv_function_stack_depth(vm->program, instruction->as.call.target);
+            instruction->as.call.target = _dplv_resolve_target(instruction_indices, code.count, instruction->as.call.target);
+            break;
+        case INST_JUMP:
+        case INST_JUMP_IF_FALSE:
+        case INST_JUMP_IF_TRUE:
+        case INST_JUMP_LOOP:
+        case INST_LESS_JUMP_IF_FALSE:
+            instruction->as.index = _dplv_resolve_target(instruction_indices, code.count, instruction->as.index);
+            break;
+        default:
+            break;
+        }
+    }
+
+    vm->entry = _dplv_resolve_target(instruction_indices, code.count, vm->program->entry);
+    for (size_t i = 0; i < vm->program->functions.count; ++i)
+    {
+        if (vm->program->functions.items[i].max_stack_depth > vm->max_stack_depth)
+        {
+            vm->max_stack_depth = vm->program->functions.items[i].max_stack_depth;
+        }
+    }
+    vm->code_count = instructions.count;
+    vm->code = arena_alloc(&vm->memory, instructions.count * sizeof(*vm->code));
+    memcpy(vm->code, instructions.items, instructions.count * sizeof(*vm->code));
+
+    nob_da_free(instructions);
+    free(instruction_indices);
+}
+
 void dplv_init(DPL_VirtualMachine *vm, DPL_Program *program)
 {
     vm->print_callback = dplv_print;
@@ -26,29 +230,122 @@ void dplv_init(DPL_VirtualMachine *vm, DPL_Program *program)
 
     if (vm->stack_capacity == 0)
     {
-        vm->stack_capacity = 1024;
+        vm->stack_capacity = DPLV_STACK_CAPACITY;
+    }
+    if (vm->stack_max_capacity == 0)
+    {
+        vm->stack_max_capacity = DPLV_STACK_MAX_CAPACITY;
+    }
+    if (vm->stack_capacity > vm->stack_max_capacity)
+    {
+        DW_ERROR("Fatal Error: Initial stack size %zu exceeds the maximum stack size %zu.",
+                 vm->stack_capacity, vm->stack_max_capacity);
     }
 
     vm->stack = arena_alloc(&vm->memory, vm->stack_capacity * sizeof(*vm->stack));
 
     if (vm->callstack_capacity == 0)
     {
-        vm->callstack_capacity = 256;
+        vm->callstack_capacity = DPLV_CALLSTACK_CAPACITY;
+    }
+    if (vm->callstack_max_capacity == 0)
+    {
+        vm->callstack_max_capacity = DPLV_CALLSTACK_MAX_CAPACITY;
+    }
+    if (vm->callstack_capacity > vm->callstack_max_capacity)
+    {
+        DW_ERROR("Fatal Error: Initial callstack size %zu exceeds the maximum callstack size %zu.",
+                 vm->callstack_capacity, vm->callstack_max_capacity);
     }
 
     vm->callstack = arena_alloc(&vm->memory, vm->callstack_capacity * sizeof(*vm->callstack));
+
+    if (!program->verified && !dplp_verify(program))
+    {
+        DW_ERROR("Fatal Error: Program verification failed.");
+    }
+    _dplv_decode(vm);
+
+    if (vm->jit)
+    {
+        dplv_jit_init(vm);
+    }
+
+    if (vm->profile)
+    {
+        size_t size = COUNT_INSTRUCTIONS * COUNT_INSTRUCTIONS * sizeof(*vm->profile_counts);
+        vm->profile_counts = arena_alloc(&vm->memory, size);
+        memset(vm->profile_counts, 0, size);
+    }
 }
 
 void dplv_free(DPL_VirtualMachine *vm)
 {
+    dplv_jit_free(vm);
+    nob_da_free(vm->release_queue);
     arena_free(&vm->memory);
 }
 
+size_t dplv_instruction_ip(const DPL_VirtualMachine *vm, size_t index)
+{
+    if (index >= vm->code_count)
+    {
+        return vm->program->code.count;
+    }
+    return vm->code[index].ip;
+}
+
+// Both stacks start small and double their capacity when needed, up to the
+// configured maximum. Since they are reallocated, pointers into the stacks
+// must not be kept across operations that may push values or callframes.
+static size_t _dplv_grow_capacity(size_t capacity, size_t max_capacity, size_t required)
+{
+    if (required > max_capacity)
+    {
+        return 0;
+    }
+
+    size_t new_capacity = capacity;
+    while (new_capacity < required)
+    {
+        new_capacity *= 2;
+    }
+
+    return (new_capacity > max_capacity) ? max_capacity : new_capacity;
+}
+
+void dplv_ensure_stack(DPL_VirtualMachine *vm, size_t required)
+{
+    if (required <= vm->stack_capacity)
+    {
+        return;
+    }
+
+    size_t new_capacity = _dplv_grow_capacity(vm->stack_capacity, vm->stack_max_capacity, required);
+    if (new_capacity == 0)
+    {
+        DW_ERROR("Fatal Error: Stack overflow in program execution.");
+    }
+
+    vm->stack = arena_realloc(&vm->memory, vm->stack,
+                              vm->stack_capacity * sizeof(*vm->stack), new_capacity * sizeof(*vm->stack));
+    vm->stack_capacity = new_capacity;
+}
+
 void _dplv_push_callframe(DPL_VirtualMachine *vm, size_t arity, size_t call_ip, size_t return_ip)
 {
     if (vm->callstack_top >= vm->callstack_capacity)
     {
-        DW_ERROR("Fatal Error: Callstack overflow in program execution.");
+        size_t new_capacity = _dplv_grow_capacity(vm->callstack_capacity, vm->callstack_max_capacity, vm->callstack_top + 1);
+        if (new_capacity == 0)
+        {
+            DW_ERROR("Fatal Error: Callstack overflow in program execution.");
+        }
+
+        vm->callstack = arena_realloc(&vm->memory, vm->callstack,
+                                      vm->callstack_capacity * sizeof(*vm->callstack),
+                                      new_capacity * sizeof(*vm->callstack));
+        vm->callstack_capacity = new_capacity;
     }
 
     vm->callstack[vm->callstack_top].arity = arity;
@@ -91,48 +388,72 @@ void _dplv_trace_stack(DPL_VirtualMachine *vm)
 
 DPL_Value dplv_reference(DPL_VirtualMachine *vm, DPL_Value value)
 {
-    if (value.kind == VALUE_STRING)
+    if (dpl_value_is_item(value))
     {
-        dpl_value_pool_acquire_item(&vm->stack_pool, value.as.string);
+        dpl_value_pool_acquire_item(&vm->stack_pool, dpl_value_as_item(value));
     }
-    else if (value.kind == VALUE_OBJECT)
+    return value;
+}
+
+static void _dplv_release_item(DPL_VirtualMachine *vm, DPL_MemoryValue *item)
+{
+    const bool has_references = (item->kind == VALUE_OBJECT && dpl_value_object_shape(item)->value_field_count > 0)
+        || (item->kind == VALUE_ARRAY && (item->storage == ARRAY_STORAGE_VALUES || item->storage == ARRAY_STORAGE_TRIE));
+    if (has_references && dpl_value_pool_will_release_item(&vm->stack_pool, item))
     {
-        dpl_value_pool_acquire_item(&vm->stack_pool, value.as.object);
+        nob_da_append(&vm->release_queue, item);
     }
-    else if (value.kind == VALUE_ARRAY)
+    else
     {
-        dpl_value_pool_acquire_item(&vm->stack_pool, value.as.array);
+        dpl_value_pool_release_item(&vm->stack_pool, item);
     }
-    return value;
 }
 
 void dplv_release(DPL_VirtualMachine *vm, DPL_Value value)
 {
-    if (value.kind == VALUE_STRING)
+    if (dpl_value_is_item(value))
     {
-        dpl_value_pool_release_item(&vm->stack_pool, value.as.string);
+        _dplv_release_item(vm, dpl_value_as_item(value));
+        if (vm->release_queue.count > 0)
+        {
+            dplv_release_pending(vm, vm->release_budget);
+        }
     }
-    else if (value.kind == VALUE_OBJECT)
+}
+
+// Frees up to `budget` queued objects and arrays (all of them if zero).
+void dplv_release_pending(DPL_VirtualMachine *vm, size_t budget)
+{
+    for (size_t released = 0; vm->release_queue.count > 0 && (budget == 0 || released < budget); ++released)
     {
-        if (dpl_value_pool_will_release_item(&vm->stack_pool, value.as.object))
+        DPL_MemoryValue *item = vm->release_queue.items[--vm->release_queue.count];
+        if (item->kind == VALUE_ARRAY && item->storage == ARRAY_STORAGE_TRIE)
         {
-            for (size_t i = 0; i < dpl_value_object_field_count(value.as.object); ++i)
+            // The nodes are arrays themselves and release their contents.
+            DPL_MemoryValue *root = ((DPL_ArrayTrie *)item->data)->root;
+            if (root)
             {
-                dplv_release(vm, dpl_value_object_get_field(value.as.object, i));
+                _dplv_release_item(vm, root);
             }
+            dpl_value_pool_release_item(&vm->stack_pool, item);
+            continue;
         }
-        dpl_value_pool_release_item(&vm->stack_pool, value.as.object);
-    }
-    else if (value.kind == VALUE_ARRAY)
-    {
-        if (dpl_value_pool_will_release_item(&vm->stack_pool, value.as.array))
+
+        const size_t count = (item->kind == VALUE_OBJECT)
+            ? dpl_value_object_field_count(item)
+            : dpl_value_array_element_count(item);
+        for (size_t i = 0; i < count; ++i)
         {
-            for (size_t i = 0; i < dpl_value_array_element_count(value.as.array); ++i)
+            const DPL_Value element = (item->kind == VALUE_OBJECT)
+                ? dpl_value_object_get_field(item, i)
+                : dpl_value_array_get_element(item, i);
+            if (dpl_value_is_item(element))
             {
-                dplv_release(vm, dpl_value_array_get_element(value.as.array, i));
+                _dplv_release_item(vm, dpl_value_as_item(element));
             }
         }
-        dpl_value_pool_release_item(&vm->stack_pool, value.as.array);
+
+        dpl_value_pool_release_item(&vm->stack_pool, item);
     }
 }
 
@@ -159,12 +480,11 @@ void dplv_return_boolean(DPL_VirtualMachine *vm, size_t arity, bool value)
 
 void dplv_run_begin(DPL_VirtualMachine *vm)
 {
-    _dplv_push_callframe(vm, 0, vm->program->entry, 0);
+    _dplv_push_callframe(vm, 0, vm->entry, 0);
+    dplv_ensure_stack(vm, vm->program->functions.items[0].max_stack_depth);
 
-    vm->program_stream = (DW_ByteStream) {
-        .buffer = vm->program->code,
-        .position = vm->program->entry,
-    };
+    vm->ip = vm->entry;
+    vm->profile_previous = SIZE_MAX;
     vm->constants_stream = (DW_ByteStream) {
         .buffer = vm->program->constants,
         .position = 0,
@@ -174,359 +494,804 @@ void dplv_run_begin(DPL_VirtualMachine *vm)
 void dplv_run_end(DPL_VirtualMachine *vm)
 {
     _dplv_pop_callframe(vm);
+    dplv_release_pending(vm, 0);
     dpl_value_pool_free(&vm->stack_pool);
 }
 
-void dplv_run_step(DPL_VirtualMachine *vm)
+// The instruction loop keeps the instruction pointer and the stack in locals
+// and only writes them back to the VM when calling out into helpers that
+// operate on the VM state (intrinsics, callframes, tracing). When compiled
+// with GCC or Clang, dispatch uses computed gotos (one indirect jump per
+// instruction instead of a shared switch jump); other compilers use a plain
+// switch.
+#if defined(__GNUC__) && !defined(DPL_NO_COMPUTED_GOTO)
+#define DPLV_COMPUTED_GOTO
+#endif
+
+static_assert(COUNT_INSTRUCTIONS == 53,
+              "Count of instructions has changed, please update the dispatch table in dplv_execute.");
+
+static void _dplv_execute(DPL_VirtualMachine *vm, const bool single_step)
 {
-#define TOP0 (vm->stack[vm->stack_top - 1])
-#define TOP1 (vm->stack[vm->stack_top - 2])
-    if (vm->trace)
+    const DPL_Instruction *code = vm->code;
+    const size_t code_count = vm->code_count;
+    size_t ip = vm->ip;
+    const DPL_Instruction *instruction;
+
+    DPL_Value *stack = vm->stack;
+    size_t stack_top = vm->stack_top;
+    size_t stack_capacity = vm->stack_capacity;
+    size_t frame_top = _dplv_peek_callframe(vm)->stack_top;
+
+#define TOP0 (stack[stack_top - 1])
+#define TOP1 (stack[stack_top - 2])
+#define SAVE_STATE()                           \
+    do                                         \
+    {                                          \
+        vm->ip = ip;                           \
+        vm->stack_top = stack_top;             \
+    } while (false)
+#define ENSURE_STACK(count)                                                   \
+    do                                                                        \
+    {                                                                         \
+        if (stack_top + (count) > stack_capacity)                             \
+        {                                                                     \
+            SAVE_STATE();                                                     \
+            dplv_ensure_stack(vm, stack_top + (count));                       \
+            stack = vm->stack;                                                \
+            stack_capacity = vm->stack_capacity;                              \
+        }                                                                     \
+    } while (false)
+#define BINARY_NUMBER(op)                                                     \
+    do                                                                        \
+    {                                                                         \
+        TOP1 = dpl_value_make_number(dpl_value_as_number(TOP1) op dpl_value_as_number(TOP0));       \
+        --stack_top;                                                          \
+    } while (false)
+#define COMPARE_NUMBER(op)                                                    \
+    do                                                                        \
+    {                                                                         \
+        TOP1 = dpl_value_make_boolean(                                        \
+            dpl_value_compare_numbers(dpl_value_as_number(TOP1), dpl_value_as_number(TOP0)) op 0);  \
+        --stack_top;                                                          \
+    } while (false)
+#define RETURN_BOOLEAN(value)                                                 \
+    do                                                                        \
+    {                                                                         \
+        bool result = (value);                                                \
+        dplv_release(vm, TOP1);                                               \
+        dplv_release(vm, TOP0);                                               \
+        --stack_top;                                                          \
+        TOP0 = dpl_value_make_boolean(result);                                \
+    } while (false)
+
+#ifdef DPLV_COMPUTED_GOTO
+    static void *dispatch_table[COUNT_INSTRUCTIONS] = {
+        [INST_NOOP] = &&label_INST_NOOP,
+        [INST_PUSH_NUMBER] = &&label_INST_PUSH_NUMBER,
+        [INST_PUSH_STRING] = &&label_INST_PUSH_STRING,
+        [INST_PUSH_BOOLEAN] = &&label_INST_PUSH_BOOLEAN,
+        [INST_POP] = &&label_INST_POP,
+        [INST_NEGATE] = &&label_INST_NEGATE,
+        [INST_NOT] = &&label_INST_NOT,
+        [INST_ADD_NUMBER] = &&label_INST_ADD_NUMBER,
+        [INST_SUBTRACT] = &&label_INST_SUBTRACT,
+        [INST_MULTIPLY] = &&label_INST_MULTIPLY,
+        [INST_DIVIDE] = &&label_INST_DIVIDE,
+        [INST_LESS] = &&label_INST_LESS,
+        [INST_LESS_EQUAL] = &&label_INST_LESS_EQUAL,
+        [INST_GREATER] = &&label_INST_GREATER,
+        [INST_GREATER_EQUAL] = &&label_INST_GREATER_EQUAL,
+        [INST_EQUAL_NUMBER] = &&label_INST_EQUAL_NUMBER,
+        [INST_NOT_EQUAL_NUMBER] = &&label_INST_NOT_EQUAL_NUMBER,
+        [INST_EQUAL_STRING] = &&label_INST_EQUAL_STRING,
+        [INST_NOT_EQUAL_STRING] = &&label_INST_NOT_EQUAL_STRING,
+        [INST_EQUAL_BOOLEAN] = &&label_INST_EQUAL_BOOLEAN,
+        [INST_NOT_EQUAL_BOOLEAN] = &&label_INST_NOT_EQUAL_BOOLEAN,
+        [INST_CONCAT_STRING] = &&label_INST_CONCAT_STRING,
+        [INST_CALL_INTRINSIC] = &&label_INST_CALL_INTRINSIC,
+        [INST_CALL_USER] = &&label_INST_CALL_USER,
+        [INST_TAIL_CALL_USER] = &&label_INST_TAIL_CALL_USER,
+        [INST_PUSH_LOCAL] = &&label_INST_PUSH_LOCAL,
+        [INST_STORE_LOCAL] = &&label_INST_STORE_LOCAL,
+        [INST_POP_SCOPE] = &&label_INST_POP_SCOPE,
+        [INST_RETURN] = &&label_INST_RETURN,
+        [INST_JUMP] = &&label_INST_JUMP,
+        [INST_JUMP_IF_FALSE] = &&label_INST_JUMP_IF_FALSE,
+        [INST_JUMP_IF_TRUE] = &&label_INST_JUMP_IF_TRUE,
+        [INST_JUMP_LOOP] = &&label_INST_JUMP_LOOP,
+        [INST_CREATE_OBJECT] = &&label_INST_CREATE_OBJECT,
+        [INST_LOAD_FIELD] = &&label_INST_LOAD_FIELD,
+        [INST_INTERPOLATION] = &&label_INST_INTERPOLATION,
+        [INST_BEGIN_ARRAY] = &&label_INST_BEGIN_ARRAY,
+        [INST_END_ARRAY] = &&label_INST_END_ARRAY,
+        [INST_CONCAT_ARRAY] = &&label_INST_CONCAT_ARRAY,
+        [INST_SPREAD] = &&label_INST_SPREAD,
+        [INST_ITERATE_RANGE] = &&label_INST_ITERATE_RANGE,
+        [INST_ITERATE_ARRAY] = &&label_INST_ITERATE_ARRAY,
+        [INST_APPEND_LOCAL] = &&label_INST_APPEND_LOCAL,
+        [INST_EXTEND_ARRAY] = &&label_INST_EXTEND_ARRAY,
+        [INST_LOAD_FIELD_NUMBER] = &&label_INST_LOAD_FIELD_NUMBER,
+        [INST_LOAD_FIELD_BOOLEAN] = &&label_INST_LOAD_FIELD_BOOLEAN,
+        [INST_PUSH_LOCAL_MOVE] = &&label_INST_PUSH_LOCAL_MOVE,
+        [INST_CREATE_OBJECT_REUSE] = &&label_INST_CREATE_OBJECT_REUSE,
+        [INST_ADD_LOCAL_NUMBER] = &&label_INST_ADD_LOCAL_NUMBER,
+        [INST_LOAD_LOCAL_FIELD] = &&label_INST_LOAD_LOCAL_FIELD,
+        [INST_LOAD_LOCAL_FIELD_NUMBER] = &&label_INST_LOAD_LOCAL_FIELD_NUMBER,
+        [INST_LOAD_LOCAL_FIELD_BOOLEAN] = &&label_INST_LOAD_LOCAL_FIELD_BOOLEAN,
+        [INST_LESS_JUMP_IF_FALSE] = &&label_INST_LESS_JUMP_IF_FALSE,
+    };
+
+#define CASE(kind) label_##kind
+#define DISPATCH()                                      \
+    do                                                  \
+    {                                                   \
+        instruction = &code[ip++];                      \
+        goto *dispatch_table[instruction->kind];        \
+    } while (false)
+#define NEXT()                                          \
+    do                                                  \
+    {                                                   \
+        if (single_step || ip >= code_count)            \
+        {                                               \
+            goto done;                                  \
+        }                                               \
+        DISPATCH();                                     \
+    } while (false)
+
+    DISPATCH();
+#else
+#define CASE(kind) case kind
+#define NEXT()                                          \
+    do                                                  \
+    {                                                   \
+        if (single_step || ip >= code_count)            \
+        {                                               \
+            goto done;                                  \
+        }                                               \
+        goto dispatch;                                  \
+    } while (false)
+
+dispatch:
+    instruction = &code[ip++];
+    switch (instruction->kind)
+#endif
     {
-        DW_ByteStream trace_program = vm->program_stream;
-        dplp_print_stream_instruction(&trace_program, &vm->constants_stream);
-        printf("    :: ");
-        _dplv_trace_stack(vm);
+    CASE(INST_NOOP):
+        NEXT();
+    CASE(INST_PUSH_NUMBER):
+    {
+        ++stack_top;
+        TOP0 = dpl_value_make_number(instruction->as.number);
     }
-
-    size_t ip_begin = vm->program_stream.position;
-
-    DPL_Instruction_Kind instruction = bs_read_u8(&vm->program_stream);
-    switch (instruction)
+        NEXT();
+    CASE(INST_PUSH_STRING):
     {
-    case INST_NOOP:
-        break;
-    case INST_PUSH_NUMBER:
+        ++stack_top;
+        TOP0 = instruction->as.string;
+    }
+        NEXT();
+    CASE(INST_PUSH_BOOLEAN):
+    {
+        ++stack_top;
+        TOP0 = dpl_value_make_boolean(instruction->as.boolean);
+    }
+        NEXT();
+    CASE(INST_NEGATE):
+        TOP0 = dpl_value_make_number(-dpl_value_as_number(TOP0));
+        NEXT();
+    CASE(INST_NOT):
+        TOP0 = dpl_value_make_boolean(!dpl_value_as_boolean(TOP0));
+        NEXT();
+    CASE(INST_ADD_NUMBER):
+        BINARY_NUMBER(+);
+        NEXT();
+    CASE(INST_SUBTRACT):
+        BINARY_NUMBER(-);
+        NEXT();
+    CASE(INST_MULTIPLY):
+        BINARY_NUMBER(*);
+        NEXT();
+    CASE(INST_DIVIDE):
+        BINARY_NUMBER(/);
+        NEXT();
+    CASE(INST_LESS):
+        COMPARE_NUMBER(<);
+        NEXT();
+    CASE(INST_LESS_EQUAL):
+        COMPARE_NUMBER(<=);
+        NEXT();
+    CASE(INST_GREATER):
+        COMPARE_NUMBER(>);
+        NEXT();
+    CASE(INST_GREATER_EQUAL):
+        COMPARE_NUMBER(>=);
+        NEXT();
+    CASE(INST_EQUAL_NUMBER):
+        COMPARE_NUMBER(==);
+        NEXT();
+    CASE(INST_NOT_EQUAL_NUMBER):
+        COMPARE_NUMBER(!=);
+        NEXT();
+    CASE(INST_EQUAL_STRING):
+        RETURN_BOOLEAN(dpl_value_string_equals(TOP0, TOP1));
+        NEXT();
+    CASE(INST_NOT_EQUAL_STRING):
+        RETURN_BOOLEAN(!dpl_value_string_equals(TOP0, TOP1));
+        NEXT();
+    CASE(INST_EQUAL_BOOLEAN):
+        TOP1 = dpl_value_make_boolean(dpl_value_as_boolean(TOP1) == dpl_value_as_boolean(TOP0));
+        --stack_top;
+        NEXT();
+    CASE(INST_NOT_EQUAL_BOOLEAN):
+        TOP1 = dpl_value_make_boolean(dpl_value_as_boolean(TOP1) != dpl_value_as_boolean(TOP0));
+        --stack_top;
+        NEXT();
+    CASE(INST_CONCAT_STRING):
     {
-        if (vm->stack_top >= vm->stack_capacity)
+        DPL_Value value;
+        if (dpl_value_is_item(TOP1) && dpl_value_pool_will_release_item(&vm->stack_pool, dpl_value_as_string(TOP1)))
         {
-            DW_ERROR("Fatal Error: Stack overflow in program execution.");
+            // Temporary results (as in `a + b + c`) are extended in place.
+            const Nob_String_View suffix = dpl_value_string_sv(&TOP0);
+            value = dpl_value_string_append(&vm->stack_pool, dpl_value_as_string(TOP1), suffix.count, suffix.data);
+        }
+        else
+        {
+            value = dpl_value_make_string_concat(&vm->stack_pool, TOP1, TOP0);
+            dplv_release(vm, TOP1);
         }
 
-        double value = bs_read_f64(&vm->program_stream);
-
-        ++vm->stack_top;
-        TOP0 = dpl_value_make_number(value);
+        dplv_release(vm, TOP0);
+        --stack_top;
+        TOP0 = value;
     }
-    break;
-    case INST_PUSH_STRING:
-    {
-        if (vm->stack_top >= vm->stack_capacity)
+        NEXT();
+    CASE(INST_POP):
+        if (stack_top == 0)
         {
-            DW_ERROR("Fatal Error: Stack overflow in program execution.");
+            DW_ERROR("Fatal Error: Stack underflow in program execution.");
         }
+        dplv_release(vm, TOP0);
+        --stack_top;
+        NEXT();
+    CASE(INST_CALL_INTRINSIC):
+    {
+        SAVE_STATE();
+        dpl_vm_call_intrinsic(vm, instruction->count);
+        stack_top = vm->stack_top;
+    }
+        NEXT();
+    CASE(INST_PUSH_LOCAL):
+    {
+        size_t slot = frame_top + instruction->as.index;
 
-        size_t offset = bs_read_u64(&vm->program_stream);
+        ++stack_top;
+        TOP0 = dplv_reference(vm, stack[slot]);
+    }
+        NEXT();
+    CASE(INST_PUSH_LOCAL_MOVE):
+    {
+        // The local is assigned before it is read again, so it can hand over
+        // its reference. A uniquely owned value stays uniquely owned.
+        size_t slot = frame_top + instruction->as.index;
 
-        Nob_String_View value = bb_read_sv(vm->program->constants, offset);
+        ++stack_top;
+        TOP0 = stack[slot];
+        stack[slot] = dpl_value_make_number(0);
+    }
+        NEXT();
+    CASE(INST_STORE_LOCAL):
+    {
+        size_t slot = frame_top + instruction->as.index;
 
-        ++vm->stack_top;
-        TOP0 = dpl_value_make_string(&vm->stack_pool, value.count, value.data);
+        dplv_release(vm, stack[slot]);
+        stack[slot] = dplv_reference(vm, TOP0);
     }
-    break;
-    case INST_PUSH_BOOLEAN:
+        NEXT();
+    CASE(INST_POP_SCOPE):
     {
-        if (vm->stack_top >= vm->stack_capacity)
+        size_t scope_size = instruction->as.index;
+
+        DPL_Value result = TOP0;
+        for (size_t i = stack_top - scope_size - 1; i < stack_top - 1; ++i)
         {
-            DW_ERROR("Fatal Error: Stack overflow in program execution.");
+            dplv_release(vm, stack[i]);
         }
 
-        size_t value = bs_read_u8(&vm->program_stream);
-
-        ++vm->stack_top;
-        TOP0 = dpl_value_make_boolean(value == 1);
+        stack_top -= scope_size;
+        TOP0 = result;
     }
-    break;
-    case INST_NEGATE:
-        dplv_return_number(vm, 1, -TOP0.as.number);
-        break;
-    case INST_NOT:
-        dplv_return_boolean(vm, 1, !TOP0.as.boolean);
-        break;
-    case INST_ADD:
-        if (TOP0.kind == VALUE_NUMBER && TOP1.kind == VALUE_NUMBER)
+        NEXT();
+    CASE(INST_CALL_USER):
+    {
+        size_t arity = instruction->count;
+
+        SAVE_STATE();
+        if (vm->jit && dplv_jit_call(vm, instruction->as.call.target, arity))
         {
-            dplv_return_number(vm, 2, TOP1.as.number + TOP0.as.number);
+            // Compiled code may run nested interpreters that grow the stack.
+            stack = vm->stack;
+            stack_capacity = vm->stack_capacity;
+            stack_top = vm->stack_top;
+            NEXT();
         }
-        else if (TOP0.kind == VALUE_STRING && TOP1.kind == VALUE_STRING)
-        {
-            Nob_String_Builder result = {0};
-            nob_sb_append_buf(&result, TOP1.as.string->data, TOP1.as.string->size);
-            nob_sb_append_buf(&result, TOP0.as.string->data, TOP0.as.string->size);
 
-            ++vm->stack_top;
-            TOP0 = dpl_value_make_string(&vm->stack_pool, result.count, result.items);
+        _dplv_push_callframe(vm, arity, instruction->as.call.target, ip);
 
-            nob_sb_free(result);
+        ip = instruction->as.call.target;
+        frame_top = stack_top - arity;
+        ENSURE_STACK(instruction->as.call.max_stack_depth - arity);
+    }
+        NEXT();
+    CASE(INST_TAIL_CALL_USER):
+    {
+        // Reuse the current callframe: release the arguments and locals of
+        // the calling function and slide the new arguments down in their place.
+        size_t arity = instruction->count;
+        DPL_CallFrame *frame = _dplv_peek_callframe(vm);
 
-            dplv_return(vm, 2, TOP0);
-        }
-        break;
-    case INST_SUBTRACT:
-        dplv_return_number(vm, 2, TOP1.as.number - TOP0.as.number);
-        break;
-    case INST_MULTIPLY:
-        dplv_return_number(vm, 2, TOP1.as.number * TOP0.as.number);
-        break;
-    case INST_DIVIDE:
-        dplv_return_number(vm, 2, TOP1.as.number / TOP0.as.number);
-        break;
-    case INST_LESS:
-        dplv_return_boolean(vm, 2, dpl_value_compare_numbers(TOP1.as.number, TOP0.as.number) < 0);
-        break;
-    case INST_LESS_EQUAL:
-        dplv_return_boolean(vm, 2, dpl_value_compare_numbers(TOP1.as.number, TOP0.as.number) <= 0);
-        break;
-    case INST_GREATER:
-        dplv_return_boolean(vm, 2, dpl_value_compare_numbers(TOP1.as.number, TOP0.as.number) > 0);
-        break;
-    case INST_GREATER_EQUAL:
-        dplv_return_boolean(vm, 2, dpl_value_compare_numbers(TOP1.as.number, TOP0.as.number) >= 0);
-        break;
-    case INST_EQUAL:
-        if (TOP0.kind == VALUE_NUMBER && TOP1.kind == VALUE_NUMBER)
+        for (size_t i = frame_top; i < stack_top - arity; ++i)
         {
-            dplv_return_boolean(vm, 2, dpl_value_compare_numbers(TOP1.as.number, TOP0.as.number) == 0);
+            dplv_release(vm, stack[i]);
         }
-        else if (TOP0.kind == VALUE_STRING && TOP1.kind == VALUE_STRING)
-        {
-            dplv_return_boolean(vm, 2, dpl_value_string_equals(TOP0.as.string, TOP1.as.string));
-        }
-        else if (TOP0.kind == VALUE_BOOLEAN && TOP1.kind == VALUE_BOOLEAN)
-        {
-            dplv_return_boolean(vm, 2, TOP0.as.boolean == TOP1.as.boolean);
-        }
-        break;
-    case INST_NOT_EQUAL:
-        if (TOP0.kind == VALUE_NUMBER && TOP1.kind == VALUE_NUMBER)
-        {
-            dplv_return_boolean(vm, 2, dpl_value_compare_numbers(TOP1.as.number, TOP0.as.number) != 0);
-        }
-        else if (TOP0.kind == VALUE_STRING && TOP1.kind == VALUE_STRING)
+        memmove(&stack[frame_top], &stack[stack_top - arity], arity * sizeof(*stack));
+
+        stack_top = frame_top + arity;
+        frame->arity = arity;
+        frame->call_ip = instruction->as.call.target;
+
+        ip = instruction->as.call.target;
+        ENSURE_STACK(instruction->as.call.max_stack_depth - arity);
+    }
+        NEXT();
+    CASE(INST_RETURN):
+    {
+        DPL_CallFrame *frame = _dplv_peek_callframe(vm);
+
+        DPL_Value result = TOP0;
+        for (size_t i = stack_top - frame->arity - 1; i < stack_top - 1; ++i)
         {
-            dplv_return_boolean(vm, 2, !dpl_value_string_equals(TOP0.as.string, TOP1.as.string));
+            dplv_release(vm, stack[i]);
         }
-        else if (TOP0.kind == VALUE_BOOLEAN && TOP1.kind == VALUE_BOOLEAN)
+
+        stack_top -= frame->arity;
+        TOP0 = result;
+        ip = frame->return_ip;
+
+        // Verified programs only return from user functions, so there is
+        // always the callframe of the program entry below.
+        --vm->callstack_top;
+        frame_top = vm->callstack[vm->callstack_top - 1].stack_top;
+    }
+        NEXT();
+    CASE(INST_JUMP):
+        ip = instruction->as.index;
+        NEXT();
+    CASE(INST_JUMP_IF_FALSE):
+        if (!dpl_value_as_boolean(TOP0))
         {
-            dplv_return_boolean(vm, 2, TOP0.as.boolean != TOP1.as.boolean);
+            ip = instruction->as.index;
         }
-        break;
-    case INST_POP:
-        if (vm->stack_top == 0)
+        NEXT();
+    CASE(INST_JUMP_IF_TRUE):
+        if (dpl_value_as_boolean(TOP0))
         {
-            DW_ERROR("Fatal Error: Stack underflow in program execution.");
+            ip = instruction->as.index;
         }
-        dplv_release(vm, TOP0);
-        --vm->stack_top;
-        break;
-    case INST_CALL_INTRINSIC:
+        NEXT();
+    CASE(INST_JUMP_LOOP):
+        ip = instruction->as.index;
+        NEXT();
+    CASE(INST_CREATE_OBJECT):
     {
-        DPL_Intrinsic_Kind intrinsic = bs_read_u8(&vm->program_stream);
-        dpl_vm_call_intrinsic(vm, intrinsic);
+        size_t field_count = instruction->count;
+        DPL_Value *fields = &stack[stack_top - field_count];
+
+        stack_top -= (field_count - 1);
+        TOP0 = dpl_value_make_object(&vm->stack_pool, field_count, fields);
     }
-    break;
-    case INST_PUSH_LOCAL:
+        NEXT();
+    CASE(INST_CREATE_OBJECT_REUSE):
     {
-        if (vm->stack_top >= vm->stack_capacity)
+        // The object in the local is dead after this instruction. When nobody
+        // else sees it and it has the same shape, its fields are overwritten.
+        size_t field_count = instruction->count;
+        DPL_Value *fields = &stack[stack_top - field_count];
+        const DPL_Value source = stack[frame_top + instruction->as.index];
+
+        DPL_Value result;
+        if (dpl_value_pool_will_release_item(&vm->stack_pool, dpl_value_as_object(source))
+            && dpl_value_object_overwrite(dpl_value_as_object(source), field_count, fields))
+        {
+            if (dpl_value_object_shape(dpl_value_as_object(source))->value_field_count > 0)
+            {
+                for (size_t i = 0; i < field_count; ++i)
+                {
+                    dplv_release(vm, fields[i]);
+                }
+            }
+            result = dplv_reference(vm, source);
+        }
+        else
         {
-            DW_ERROR("Fatal Error: Stack overflow in program execution.");
+            result = dpl_value_make_object(&vm->stack_pool, field_count, fields);
         }
 
-        size_t scope_index = bs_read_u64(&vm->program_stream);
-        size_t slot = _dplv_peek_callframe(vm)->stack_top + scope_index;
-
-        ++vm->stack_top;
-        TOP0 = dplv_reference(vm, vm->stack[slot]);
+        stack_top -= (field_count - 1);
+        TOP0 = result;
     }
-    break;
-    case INST_STORE_LOCAL:
+        NEXT();
+    CASE(INST_LOAD_FIELD):
     {
-        size_t scope_index = bs_read_u64(&vm->program_stream);
-        size_t slot = _dplv_peek_callframe(vm)->stack_top + scope_index;
+        size_t field_index = instruction->count;
 
-        dplv_release(vm, vm->stack[slot]);
-        vm->stack[slot] = dplv_reference(vm, TOP0);
+        DPL_Value field_value = dplv_reference(vm, dpl_value_object_get_field(dpl_value_as_object(TOP0), field_index));
+        dplv_release(vm, TOP0);
+        TOP0 = field_value;
     }
-    break;
-    case INST_POP_SCOPE:
+        NEXT();
+    CASE(INST_LOAD_FIELD_NUMBER):
     {
-        size_t scope_size = bs_read_u64(&vm->program_stream);
-
-        dplv_return(vm, scope_size + 1, dplv_reference(vm, TOP0));
+        const double number = dpl_value_object_get_number(dpl_value_as_object(TOP0), instruction->count);
+        dplv_release(vm, TOP0);
+        TOP0 = dpl_value_make_number(number);
     }
-    break;
-    case INST_CALL_USER:
+        NEXT();
+    CASE(INST_LOAD_FIELD_BOOLEAN):
     {
-        uint8_t arity = bs_read_u8(&vm->program_stream);
-        size_t begin_ip = bs_read_u64(&vm->program_stream);
-
-        _dplv_push_callframe(vm, arity, begin_ip, vm->program_stream.position);
-
-        vm->program_stream.position = begin_ip;
-    };
-    break;
-    case INST_RETURN:
+        const bool boolean = dpl_value_object_get_boolean(dpl_value_as_object(TOP0), instruction->count);
+        dplv_release(vm, TOP0);
+        TOP0 = dpl_value_make_boolean(boolean);
+    }
+        NEXT();
+    CASE(INST_INTERPOLATION):
     {
-        DPL_CallFrame *frame = _dplv_peek_callframe(vm);
-        dplv_return(vm, frame->arity + 1, dplv_reference(vm, TOP0));
-        vm->program_stream.position = frame->return_ip;
+        size_t count = instruction->count;
+        DPL_Value value = dpl_value_make_string_join(&vm->stack_pool, count, &stack[stack_top - count]);
 
-        _dplv_pop_callframe(vm);
-    };
-    break;
-    case INST_JUMP:
+        for (size_t i = stack_top - count; i < stack_top; ++i)
+        {
+            dplv_release(vm, stack[i]);
+        }
+
+        stack_top -= count - 1;
+        TOP0 = value;
+    }
+        NEXT();
+    CASE(INST_BEGIN_ARRAY):
     {
-        uint16_t jump = bs_read_u16(&vm->program_stream);
-        vm->program_stream.position += jump;
+        ++stack_top;
+        TOP0 = dpl_value_make_array_slot();
     }
-    break;
-    case INST_JUMP_IF_FALSE:
+        NEXT();
+    CASE(INST_END_ARRAY):
     {
-        uint16_t jump = bs_read_u16(&vm->program_stream);
-        if (!TOP0.as.boolean)
+        for (size_t i = stack_top; i > 0; --i)
         {
-            vm->program_stream.position += jump;
+            if (dpl_value_kind(stack[i - 1]) == VALUE_ARRAY && dpl_value_as_array(stack[i - 1]) == NULL)
+            {
+                const size_t element_count = stack_top - i;
+                const DPL_Value *elements = &stack[i];
+                stack[i - 1] = dpl_value_make_array(&vm->stack_pool, element_count, elements);
+                stack_top -= element_count;
+                break;
+            }
         }
     }
-    break;
-    case INST_JUMP_IF_TRUE:
+        NEXT();
+    CASE(INST_CONCAT_ARRAY):
     {
-        uint16_t jump = bs_read_u16(&vm->program_stream);
-        if (TOP0.as.boolean)
+        DPL_MemoryValue *array = dpl_value_as_array(TOP1);
+        if (dpl_value_pool_will_release_item(&vm->stack_pool, array))
         {
-            vm->program_stream.position += jump;
+            // Nobody else sees the array, so the element can be added in place.
+            TOP1 = dpl_value_array_append(&vm->stack_pool, array, TOP0);
+        }
+        else
+        {
+            const DPL_Value new_array = dpl_value_make_array_concat(&vm->stack_pool, array, TOP0);
+            dplv_release(vm, TOP1);
+            TOP1 = new_array;
         }
-    }
-    break;
-    case INST_JUMP_LOOP:
-    {
-        uint16_t jump = bs_read_u16(&vm->program_stream);
-        vm->program_stream.position -= jump;
-    }
-    break;
-    case INST_CREATE_OBJECT:
-    {
-        uint8_t field_count = bs_read_u8(&vm->program_stream);
-        DPL_Value* fields = &vm->stack[vm->stack_top - field_count];
 
-        vm->stack_top -= (field_count - 1);
-        TOP0 = dpl_value_make_object(&vm->stack_pool, field_count, fields);
+        --stack_top;
     }
-    break;
-    case INST_LOAD_FIELD:
+        NEXT();
+    CASE(INST_SPREAD):
     {
-        uint8_t field_index = bs_read_u8(&vm->program_stream);
+        DPL_Value value = TOP0;
 
-        DPL_Value field_value = dplv_reference(vm, dpl_value_object_get_field(TOP0.as.object, field_index));
-        dplv_release(vm, TOP0);
-        TOP0 = field_value;
-    }
-    break;
-    case INST_INTERPOLATION:
-    {
-        uint8_t count = bs_read_u8(&vm->program_stream);
+        size_t count = dpl_value_array_element_count(dpl_value_as_array(value));
+        // The verifier cannot know the number of spread elements, so reserve
+        // space for them and for anything the current function pushes later.
+        ENSURE_STACK(count + vm->max_stack_depth);
 
-        Nob_String_Builder result = {0};
-        for (size_t i = vm->stack_top - count; i < vm->stack_top; ++i)
+        for (size_t i = 0; i < count; ++i)
         {
-            nob_sb_append_buf(&result, vm->stack[i].as.string->data, vm->stack[i].as.string->size);
+            stack[stack_top - 1 + i] = dplv_reference(
+                vm, dpl_value_array_get_element(dpl_value_as_array(value), i));
         }
+        stack_top += count - 1;
 
-        ++vm->stack_top;
-        TOP0 = dpl_value_make_string(&vm->stack_pool, result.count, result.items);
+        dplv_release(vm, value);
+    }
+        NEXT();
+    CASE(INST_ITERATE_RANGE):
+    {
+        // The loop index is followed by the (inclusive) upper bound.
+        size_t slot = frame_top + instruction->as.index;
 
-        nob_sb_free(result);
+        ++stack_top;
+        TOP0 = dpl_value_make_boolean(
+            !(dpl_value_as_number(stack[slot]) > dpl_value_as_number(stack[slot + 1])));
+    }
+        NEXT();
+    CASE(INST_ITERATE_ARRAY):
+    {
+        // The array is followed by the loop index.
+        size_t slot = frame_top + instruction->as.index;
 
-        dplv_return(vm, count + 1, dplv_reference(vm, TOP0));
+        ++stack_top;
+        TOP0 = dpl_value_make_boolean(
+            dpl_value_as_number(stack[slot + 1]) < dpl_value_array_element_count(dpl_value_as_array(stack[slot])));
     }
-    break;
-    case INST_BEGIN_ARRAY:
+        NEXT();
+    CASE(INST_APPEND_LOCAL):
     {
-        if (vm->stack_top >= vm->stack_capacity)
+        // `s := s + x`, only emitted for string locals. The local's string is
+        // extended in place when it holds the only reference.
+        size_t slot = frame_top + instruction->as.index;
+        DPL_Value result;
+        if (dpl_value_is_item(stack[slot]) && dpl_value_pool_will_release_item(&vm->stack_pool, dpl_value_as_string(stack[slot])))
+        {
+            const Nob_String_View suffix = dpl_value_string_sv(&TOP0);
+            result = dpl_value_string_append(&vm->stack_pool, dpl_value_as_string(stack[slot]), suffix.count, suffix.data);
+        }
+        else
         {
-            DW_ERROR("Fatal Error: Stack overflow in program execution.");
+            result = dpl_value_make_string_concat(&vm->stack_pool, stack[slot], TOP0);
+            dplv_release(vm, stack[slot]);
         }
 
-        ++vm->stack_top;
-        TOP0 = dpl_value_make_array_slot();
+        dplv_release(vm, TOP0);
+        stack[slot] = result;
+        TOP0 = dplv_reference(vm, result);
     }
-    break;
-    case INST_END_ARRAY:
+        NEXT();
+    CASE(INST_EXTEND_ARRAY):
     {
-        for (size_t i = vm->stack_top; i > 0; --i)
-        {
-            if (vm->stack[i - 1].kind == VALUE_ARRAY && vm->stack[i - 1].as.array == NULL)
-            {
-                const size_t element_count = vm->stack_top - i;
-                const DPL_Value *elements = &vm->stack[i];
-                vm->stack[i - 1] = dpl_value_make_array(&vm->stack_pool, element_count, elements);
-                vm->stack_top -= element_count;
-                break;
-            }
-        }
+        // An array literal with a single spread: `count` elements before and
+        // `as.index` elements after the spread array. Large arrays share their
+        // nodes with the result instead of being copied.
+        const uint32_t before_count = instruction->count;
+        const uint32_t after_count = instruction->as.index;
+        DPL_Value *elements = &stack[stack_top - before_count - after_count - 1];
+        const DPL_Value array = elements[before_count];
+
+        const DPL_Value result = dpl_value_make_array_extend(
+            &vm->stack_pool, dpl_value_as_array(array),
+            before_count, elements, after_count, elements + before_count + 1);
+        dplv_release(vm, array);
+
+        stack_top -= before_count + after_count;
+        TOP0 = result;
     }
-    break;
-    case INST_CONCAT_ARRAY:
+        NEXT();
+    CASE(INST_ADD_LOCAL_NUMBER):
     {
-        const DPL_Value new_array = dpl_value_make_array_concat(&vm->stack_pool, TOP1.as.array, TOP0);
+        DPL_Value result = dpl_value_make_number(
+            dpl_value_as_number(stack[frame_top + instruction->as.update.source]) + instruction->as.update.number);
 
-        dplv_release(vm, TOP1);
-        TOP1 = new_array;
+        size_t slot = frame_top + instruction->as.update.target;
+        dplv_release(vm, stack[slot]);
+        stack[slot] = result;
 
-        --vm->stack_top;
+        ++stack_top;
+        TOP0 = result;
     }
-    break;
-    case INST_SPREAD:
+        NEXT();
+    CASE(INST_LOAD_LOCAL_FIELD):
     {
-        DPL_Value value = TOP0;
+        DPL_MemoryValue *object = dpl_value_as_object(stack[frame_top + instruction->as.index]);
+
+        ++stack_top;
+        TOP0 = dplv_reference(vm, dpl_value_object_get_field(object, instruction->count));
+    }
+        NEXT();
+    CASE(INST_LOAD_LOCAL_FIELD_NUMBER):
+    {
+        DPL_MemoryValue *object = dpl_value_as_object(stack[frame_top + instruction->as.index]);
+
+        ++stack_top;
+        TOP0 = dpl_value_make_number(dpl_value_object_get_number(object, instruction->count));
+    }
+        NEXT();
+    CASE(INST_LOAD_LOCAL_FIELD_BOOLEAN):
+    {
+        DPL_MemoryValue *object = dpl_value_as_object(stack[frame_top + instruction->as.index]);
 
-        size_t count = dpl_value_array_element_count(value.as.array);
-        if ((vm->stack_top + count - 1) >= vm->stack_capacity)
+        ++stack_top;
+        TOP0 = dpl_value_make_boolean(dpl_value_object_get_boolean(object, instruction->count));
+    }
+        NEXT();
+    CASE(INST_LESS_JUMP_IF_FALSE):
+        if (dpl_value_compare_numbers(dpl_value_as_number(TOP1), dpl_value_as_number(TOP0)) < 0)
         {
-            DW_ERROR("Fatal Error: Stack overflow in program execution.");
+            stack_top -= 2;
         }
-
-        for (size_t i = 0; i < count; ++i)
+        else
         {
-            vm->stack[vm->stack_top - 1 + i] = dplv_reference(
-                vm, dpl_value_array_get_element(value.as.array, i));
+            --stack_top;
+            TOP0 = dpl_value_make_boolean(false);
+            ip = instruction->as.index;
         }
-        vm->stack_top += count - 1;
-
-        dplv_release(vm, value);
-    }
-
-    break;
+        NEXT();
+#ifndef DPLV_COMPUTED_GOTO
     default:
+        SAVE_STATE();
         printf("\n=======================================\n");
         _dplv_trace_stack(vm);
         printf("\n");
-        DW_UNIMPLEMENTED_MSG("`%s` at position %zu.", dplp_inst_kind_name(instruction), ip_begin);
+        DW_UNIMPLEMENTED_MSG("`%s` at position %zu.", dplp_inst_kind_name(instruction->kind), instruction->ip);
+#endif
+    }
+
+done:
+    SAVE_STATE();
+
+#undef NEXT
+#undef DISPATCH
+#undef CASE
+#undef RETURN_BOOLEAN
+#undef COMPARE_NUMBER
+#undef BINARY_NUMBER
+#undef ENSURE_STACK
+#undef SAVE_STATE
+#undef TOP1
+#undef TOP0
+}
+
+static void _dplv_profile_step(DPL_VirtualMachine *vm)
+{
+    // Only pairs where control falls through from one instruction to the next
+    // are candidates for fusion, so pairs across jumps and calls are skipped.
+    if (vm->profile_previous != SIZE_MAX && vm->profile_previous + 1 == vm->ip)
+    {
+        DPL_Instruction_Kind first = vm->code[vm->profile_previous].kind;
+        DPL_Instruction_Kind second = vm->code[vm->ip].kind;
+        ++vm->profile_counts[first * COUNT_INSTRUCTIONS + second];
     }
+    vm->profile_previous = vm->ip;
+}
+
+void dplv_run_step(DPL_VirtualMachine *vm)
+{
+    if (vm->profile)
+    {
+        _dplv_profile_step(vm);
+    }
+
+    if (vm->trace)
+    {
+        DW_ByteStream trace_program = {
+            .buffer = vm->program->code,
+            .position = dplv_instruction_ip(vm, vm->ip),
+        };
+        dplp_print_stream_instruction(&trace_program, &vm->constants_stream);
+        printf("    :: ");
+        _dplv_trace_stack(vm);
+    }
+
+    _dplv_execute(vm, true);
 
     if (vm->trace)
     {
         printf("\n    :: ");
         _dplv_trace_stack(vm);
-        printf(" [%04zu]\n", vm->program_stream.position);
+        printf(" [%04zu]\n", dplv_instruction_ip(vm, vm->ip));
         getc(stdin);
     }
-#undef TOP1
-#undef TOP0
 }
 
 void dplv_run(DPL_VirtualMachine *vm)
 {
     dplv_run_begin(vm);
 
-    while (!dplv_run_at_end(vm))
+    if (vm->trace || vm->profile)
+    {
+        while (!dplv_run_at_end(vm))
+        {
+            dplv_run_step(vm);
+        }
+    }
+    else if (!dplv_run_at_end(vm))
     {
-        dplv_run_step(vm);
+        _dplv_execute(vm, false);
     }
 
     dplv_run_end(vm);
 }
 
+// Runs the user function starting at instruction `target` with its `arity`
+// arguments on top of the stack until it returns, leaving its result there.
+// Used to call back into the interpreter from compiled code.
+void dplv_run_function(DPL_VirtualMachine *vm, size_t target, size_t arity)
+{
+    size_t ip = vm->ip;
+
+    // Returning to the end of the code stops the instruction loop.
+    _dplv_push_callframe(vm, arity, target, vm->code_count);
+    dplv_ensure_stack(vm, vm->stack_top + vm->max_stack_depth);
+
+    vm->ip = target;
+    _dplv_execute(vm, false);
+    vm->ip = ip;
+}
+
+typedef struct
+{
+    DPL_Instruction_Kind first;
+    DPL_Instruction_Kind second;
+    size_t count;
+} DPL_Profile_Pair;
+
+static int _dplv_compare_profile_pairs(const void *a, const void *b)
+{
+    const DPL_Profile_Pair *pair_a = a;
+    const DPL_Profile_Pair *pair_b = b;
+    if (pair_a->count != pair_b->count)
+    {
+        return (pair_a->count < pair_b->count) ? 1 : -1;
+    }
+    return 0;
+}
+
+void dplv_print_profile(DPL_VirtualMachine *vm)
+{
+    if (!vm->profile_counts)
+    {
+        return;
+    }
+
+    struct
+    {
+        DPL_Profile_Pair *items;
+        size_t count;
+        size_t capacity;
+    } pairs = {0};
+
+    size_t total = 0;
+    for (size_t first = 0; first < COUNT_INSTRUCTIONS; ++first)
+    {
+        for (size_t second = 0; second < COUNT_INSTRUCTIONS; ++second)
+        {
+            size_t count = vm->profile_counts[first * COUNT_INSTRUCTIONS + second];
+            if (count > 0)
+            {
+                DPL_Profile_Pair pair = {.first = first, .second = second, .count = count};
+                nob_da_append(&pairs, pair);
+                total += count;
+            }
+        }
+    }
+
+    qsort(pairs.items, pairs.count, sizeof(*pairs.items), _dplv_compare_profile_pairs);
+
+    printf("\n================================================================\n");
+    printf("| Instruction pair frequencies (%zu pairs executed)\n", total);
+    printf("================================================================\n");
+    for (size_t i = 0; i < pairs.count; ++i)
+    {
+        DPL_Profile_Pair pair = pairs.items[i];
+        printf("| %12zu  %6.2f%%  %s %s\n", pair.count, 100.0 * pair.count / total,
+               dplp_inst_kind_name(pair.first), dplp_inst_kind_name(pair.second));
+    }
+    printf("================================================================\n\n");
+
+    nob_da_free(pairs);
+}
+
 
 DPL_Value dplv_peek(DPL_VirtualMachine *vm)
 {
@@ -1,4 +1,5 @@
 #include <dpl/vm/intrinsics.h>
+#include <dpl/vm/kernels.h>
 #include <dw_error.h>
 
 typedef void (*DPL_Intrinsic_Callback)(DPL_VirtualMachine *);
@@ -14,7 +15,7 @@ void dpl_vm_intrinsic_boolean_tostring(DPL_VirtualMachine *vm)
     //   <native>;
     DPL_Value value = dplv_peek(vm);
 
-    const char* string_value = dpl_value_format_boolean(value.as.boolean);
+    const char* string_value = dpl_value_format_boolean(dpl_value_as_boolean(value));
     dplv_return(vm, 1, dpl_value_make_string(&vm->stack_pool, strlen(string_value), string_value));
 }
 
@@ -24,7 +25,7 @@ void dpl_vm_intrinsic_number_tostring(DPL_VirtualMachine *vm)
     //   <native>;
     DPL_Value value = dplv_peek(vm);
 
-    const char* string_value = dpl_value_format_number(value.as.number);
+    const char* string_value = dpl_value_format_number(dpl_value_as_number(value));
     dplv_return(vm, 1, dpl_value_make_string(&vm->stack_pool, strlen(string_value), string_value));
 }
 
@@ -33,15 +34,15 @@ static void dpl_vm_intrinsic_number_iterator(DPL_VirtualMachine *vm)
     // function iterator(range: [from: Number, to: Number]): RangeIterator :=
     //   [ current := range.from, finished := range.from >= range.to, to := range.to ];
     DPL_Value range = dplv_peek(vm);
-    DPL_Value from = dpl_value_object_get_field(range.as.object, 0);
-    DPL_Value to = dpl_value_object_get_field(range.as.object, 1);
+    DPL_Value from = dpl_value_object_get_field(dpl_value_as_object(range), 0);
+    DPL_Value to = dpl_value_object_get_field(dpl_value_as_object(range), 1);
 
     dplv_return(
         vm,
         1,
         dpl_vm_intrinsic_make_object(
             vm,
-            DPL_VALUES(from, dpl_value_make_boolean(from.as.number > to.as.number), to)));
+            DPL_VALUES(from, dpl_value_make_boolean(dpl_value_as_number(from) > dpl_value_as_number(to)), to)));
 }
 
 static void dpl_vm_intrinsic_number_iterator_next(DPL_VirtualMachine *vm)
@@ -53,16 +54,16 @@ static void dpl_vm_intrinsic_number_iterator_next(DPL_VirtualMachine *vm)
 
     DPL_Value iterator = dplv_peek(vm);
 
-    DPL_Value current = dpl_value_object_get_field(iterator.as.object, 0);
-    DPL_Value to = dpl_value_object_get_field(iterator.as.object, 2);
+    DPL_Value current = dpl_value_object_get_field(dpl_value_as_object(iterator), 0);
+    DPL_Value to = dpl_value_object_get_field(dpl_value_as_object(iterator), 2);
 
-    double next = current.as.number + 1;
+    double next = dpl_value_as_number(current) + 1;
     dplv_return(
         vm,
         1,
         dpl_vm_intrinsic_make_object(
             vm,
-            DPL_VALUES(dpl_value_make_number(next), dpl_value_make_boolean(next > to.as.number), to)));
+            DPL_VALUES(dpl_value_make_number(next), dpl_value_make_boolean(next > dpl_value_as_number(to)), to)));
 }
 
 void dpl_vm_intrinsic_string_length(DPL_VirtualMachine *vm)
@@ -70,28 +71,28 @@ void dpl_vm_intrinsic_string_length(DPL_VirtualMachine *vm)
     // function length(String): Number :=
     //   <native>;
     DPL_Value value = dplv_peek(vm);
-    dplv_return_number(vm, 1, value.as.string->size);
+    dplv_return_number(vm, 1, dpl_value_string_sv(&value).count);
 }
 
 void dpl_vm_intrinsic_print(DPL_VirtualMachine *vm)
 {
     DPL_Value value = dplv_peek(vm);
-    switch (value.kind)
+    switch (dpl_value_kind(value))
     {
     case VALUE_NUMBER:
-        vm->print_callback(vm->print_context, "%s", dpl_value_format_number(value.as.number));
+        vm->print_callback(vm->print_context, "%s", dpl_value_format_number(dpl_value_as_number(value)));
         break;
     case VALUE_STRING:
     {
-        const Nob_String_View sv = nob_sv_from_parts((char*)value.as.string->data, value.as.string->size);
+        const Nob_String_View sv = dpl_value_string_sv(&value);
         vm->print_callback(vm->print_context, SV_Fmt, SV_Arg(sv));
     }
     break;
     case VALUE_BOOLEAN:
-        vm->print_callback(vm->print_context, "%s", dpl_value_format_boolean(value.as.boolean));
+        vm->print_callback(vm->print_context, "%s", dpl_value_format_boolean(dpl_value_as_boolean(value)));
         break;
     default:
-        DW_ERROR("ERROR: `print` function callback cannot print values of kind `%s`.", dpl_value_kind_name(value.kind));
+        DW_ERROR("ERROR: `print` function callback cannot print values of kind `%s`.", dpl_value_kind_name(dpl_value_kind(value)));
     }
 }
 
@@ -100,15 +101,15 @@ void dpl_vm_intrinsic_array_length(DPL_VirtualMachine *vm)
     // function length([T]): Number :=
     //   <native>;
     DPL_Value value = dplv_peek(vm);
-    dplv_return_number(vm, 1, dpl_value_array_element_count(value.as.array));
+    dplv_return_number(vm, 1, dpl_value_array_element_count(dpl_value_as_array(value)));
 }
 
 void dpl_vm_intrinsic_array_element(DPL_VirtualMachine *vm)
 {
     // function element([T], Number): T :=
     //   <native>
-    size_t index = dplv_peek(vm).as.number;
-    DPL_MemoryValue *array = dplv_peekn(vm, 2).as.array;
+    size_t index = dpl_value_as_number(dplv_peek(vm));
+    DPL_MemoryValue *array = dpl_value_as_array(dplv_peekn(vm, 2));
     size_t array_size = dpl_value_array_element_count(array);
 
     if (index >= array_size)
@@ -116,7 +117,7 @@ void dpl_vm_intrinsic_array_element(DPL_VirtualMachine *vm)
         DW_ERROR("Array index out of bounds (size: %zu, index: %zu).", array_size, index);
     }
 
-    DPL_Value result = dpl_value_array_get_element(array, index);
+    DPL_Value result = dplv_reference(vm, dpl_value_array_get_element(array, index));
     dplv_return(vm, 2, result);
 }
 
@@ -132,12 +133,12 @@ void dpl_vm_intrinsic_array_iterator(DPL_VirtualMachine *vm)
 
     DPL_Value array = dplv_peek(vm);
 
-    size_t count = dpl_value_array_element_count(array.as.array);
+    size_t count = dpl_value_array_element_count(dpl_value_as_array(array));
     DPL_Value iterator = dpl_vm_intrinsic_make_object(
         vm,
         DPL_VALUES(
             dplv_reference(vm, array),
-            (count > 0) ? dpl_value_array_get_element(array.as.array, 0) : dpl_value_make_number(0),
+            (count > 0) ? dplv_reference(vm, dpl_value_array_get_element(dpl_value_as_array(array), 0)) : dpl_value_make_number(0),
             dpl_value_make_boolean(count == 0),
             dpl_value_make_number(0)));
 
@@ -158,23 +159,135 @@ void dpl_vm_intrinsic_arrayiterator_next(DPL_VirtualMachine *vm)
 
     DPL_Value it = dplv_peek(vm);
 
-    DPL_Value array = dpl_value_object_get_field(it.as.object, 0);
-    size_t count = dpl_value_array_element_count(array.as.array);
+    DPL_Value array = dpl_value_object_get_field(dpl_value_as_object(it), 0);
+    size_t count = dpl_value_array_element_count(dpl_value_as_array(array));
 
-    DPL_Value index = dpl_value_object_get_field(it.as.object, 3);
-    size_t next_index = index.as.number + 1;
+    DPL_Value index = dpl_value_object_get_field(dpl_value_as_object(it), 3);
+    size_t next_index = dpl_value_as_number(index) + 1;
 
     DPL_Value next_it = dpl_vm_intrinsic_make_object(
         vm,
         DPL_VALUES(
             dplv_reference(vm, array),
-            (next_index < count) ? dpl_value_array_get_element(array.as.array, next_index) : dpl_value_make_number(0),
+            (next_index < count) ? dplv_reference(vm, dpl_value_array_get_element(dpl_value_as_array(array), next_index)) : dpl_value_make_number(0),
             dpl_value_make_boolean(next_index >= count),
             dpl_value_make_number(next_index)));
 
     dplv_return(vm, 1, next_it);
 }
 
+static size_t dpl_vm_intrinsic_number_array_count(DPL_MemoryValue *array1, DPL_MemoryValue *array2, const char *name)
+{
+    size_t count1 = dpl_value_array_element_count(array1);
+    size_t count2 = dpl_value_array_element_count(array2);
+    if (count1 != count2)
+    {
+        DW_ERROR("Arrays passed to `%s` differ in length (%zu and %zu).", name, count1, count2);
+    }
+    return count1;
+}
+
+// The kernels need contiguous elements, so an argument stored in a trie is
+// replaced by a flat copy first.
+static double *dpl_vm_intrinsic_numbers(DPL_VirtualMachine *vm, size_t n)
+{
+    DPL_Value *argument = &vm->stack[vm->stack_top - n];
+    DPL_MemoryValue *array = dpl_value_as_array(*argument);
+    if (array->storage == ARRAY_STORAGE_TRIE)
+    {
+        DPL_Value flat = dpl_value_make_array_flat(&vm->stack_pool, array);
+        dplv_release(vm, *argument);
+        *argument = flat;
+        array = dpl_value_as_array(flat);
+    }
+    return dpl_value_array_numbers(array);
+}
+
+void dpl_vm_intrinsic_number_array_sum(DPL_VirtualMachine *vm)
+{
+    // function sum([Number]): Number :=
+    //   <native>;
+    DPL_MemoryValue *array = dpl_value_as_array(dplv_peek(vm));
+    double result = dplv_kernels()->sum(dpl_vm_intrinsic_numbers(vm, 1), dpl_value_array_element_count(array));
+    dplv_return_number(vm, 1, result);
+}
+
+void dpl_vm_intrinsic_number_array_min(DPL_VirtualMachine *vm)
+{
+    // function min([Number]): Number :=
+    //   <native>;
+    DPL_MemoryValue *array = dpl_value_as_array(dplv_peek(vm));
+    size_t count = dpl_value_array_element_count(array);
+    if (count == 0)
+    {
+        DW_ERROR("Cannot compute the minimum of an empty array.");
+    }
+    dplv_return_number(vm, 1, dplv_kernels()->min(dpl_vm_intrinsic_numbers(vm, 1), count));
+}
+
+void dpl_vm_intrinsic_number_array_max(DPL_VirtualMachine *vm)
+{
+    // function max([Number]): Number :=
+    //   <native>;
+    DPL_MemoryValue *array = dpl_value_as_array(dplv_peek(vm));
+    size_t count = dpl_value_array_element_count(array);
+    if (count == 0)
+    {
+        DW_ERROR("Cannot compute the maximum of an empty array.");
+    }
+    dplv_return_number(vm, 1, dplv_kernels()->max(dpl_vm_intrinsic_numbers(vm, 1), count));
+}
+
+void dpl_vm_intrinsic_number_array_dot(DPL_VirtualMachine *vm)
+{
+    // function dot([Number], [Number]): Number :=
+    //   <native>;
+    DPL_MemoryValue *a = dpl_value_as_array(dplv_peekn(vm, 2));
+    DPL_MemoryValue *b = dpl_value_as_array(dplv_peek(vm));
+    size_t count = dpl_vm_intrinsic_number_array_count(a, b, "dot");
+    double result = dplv_kernels()->dot(dpl_vm_intrinsic_numbers(vm, 2), dpl_vm_intrinsic_numbers(vm, 1), count);
+    dplv_return_number(vm, 2, result);
+}
+
+void dpl_vm_intrinsic_number_array_scale(DPL_VirtualMachine *vm)
+{
+    // function scale([Number], Number): [Number] :=
+    //   <native>;
+    DPL_MemoryValue *array = dpl_value_as_array(dplv_peekn(vm, 2));
+    double factor = dpl_value_as_number(dplv_peek(vm));
+    size_t count = dpl_value_array_element_count(array);
+
+    DPL_Value result = dpl_value_make_number_array(&vm->stack_pool, count);
+    dplv_kernels()->scale(dpl_value_array_numbers(dpl_value_as_array(result)), dpl_vm_intrinsic_numbers(vm, 2), factor, count);
+    dplv_return(vm, 2, result);
+}
+
+void dpl_vm_intrinsic_number_array_add(DPL_VirtualMachine *vm)
+{
+    // function add([Number], [Number]): [Number] :=
+    //   <native>;
+    DPL_MemoryValue *a = dpl_value_as_array(dplv_peekn(vm, 2));
+    DPL_MemoryValue *b = dpl_value_as_array(dplv_peek(vm));
+    size_t count = dpl_vm_intrinsic_number_array_count(a, b, "add");
+
+    DPL_Value result = dpl_value_make_number_array(&vm->stack_pool, count);
+    dplv_kernels()->add(dpl_value_array_numbers(dpl_value_as_array(result)), dpl_vm_intrinsic_numbers(vm, 2), dpl_vm_intrinsic_numbers(vm, 1), count);
+    dplv_return(vm, 2, result);
+}
+
+void dpl_vm_intrinsic_number_array_multiply(DPL_VirtualMachine *vm)
+{
+    // function multiply([Number], [Number]): [Number] :=
+    //   <native>;
+    DPL_MemoryValue *a = dpl_value_as_array(dplv_peekn(vm, 2));
+    DPL_MemoryValue *b = dpl_value_as_array(dplv_peek(vm));
+    size_t count = dpl_vm_intrinsic_number_array_count(a, b, "multiply");
+
+    DPL_Value result = dpl_value_make_number_array(&vm->stack_pool, count);
+    dplv_kernels()->multiply(dpl_value_array_numbers(dpl_value_as_array(result)), dpl_vm_intrinsic_numbers(vm, 2), dpl_vm_intrinsic_numbers(vm, 1), count);
+    dplv_return(vm, 2, result);
+}
+
 const DPL_Intrinsic_Callback INTRINSIC_CALLBACKS[COUNT_INTRINSICS] = {
     [INTRINSIC_BOOLEAN_PRINT] = dpl_vm_intrinsic_print,
     [INTRINSIC_BOOLEAN_TOSTRING] = dpl_vm_intrinsic_boolean_tostring,
@@ -191,9 +304,17 @@ const DPL_Intrinsic_Callback INTRINSIC_CALLBACKS[COUNT_INTRINSICS] = {
     [INTRINSIC_ARRAY_ELEMENT] = dpl_vm_intrinsic_array_element,
     [INTRINSIC_ARRAY_ITERATOR] = dpl_vm_intrinsic_array_iterator,
     [INTRINSIC_ARRAYITERATOR_NEXT] = dpl_vm_intrinsic_arrayiterator_next,
+
+    [INTRINSIC_NUMBERARRAY_SUM] = dpl_vm_intrinsic_number_array_sum,
+    [INTRINSIC_NUMBERARRAY_MIN] = dpl_vm_intrinsic_number_array_min,
+    [INTRINSIC_NUMBERARRAY_MAX] = dpl_vm_intrinsic_number_array_max,
+    [INTRINSIC_NUMBERARRAY_DOT] = dpl_vm_intrinsic_number_array_dot,
+    [INTRINSIC_NUMBERARRAY_SCALE] = dpl_vm_intrinsic_number_array_scale,
+    [INTRINSIC_NUMBERARRAY_ADD] = dpl_vm_intrinsic_number_array_add,
+    [INTRINSIC_NUMBERARRAY_MULTIPLY] = dpl_vm_intrinsic_number_array_multiply,
 };
 
-static_assert(COUNT_INTRINSICS == 12,
+static_assert(COUNT_INTRINSICS == 19,
               "Count of intrinsic kinds has changed, please update intrinsic kind names map.");
 
 void dpl_vm_call_intrinsic(DPL_VirtualMachine *vm, DPL_Intrinsic_Kind kind)
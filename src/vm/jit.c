@@ -0,0 +1,1018 @@
+#ifdef DPL_LEAKCHECK
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/jit.h>
+#include <dw_error.h>
+
+#ifdef DPLV_JIT_SUPPORTED
+
+#include <sys/mman.h>
+
+typedef enum
+{
+    JIT_TYPE_UNKNOWN,
+    JIT_TYPE_NUMBER,
+    JIT_TYPE_BOOLEAN,
+} DPL_Jit_Type;
+
+typedef enum
+{
+    JIT_FUNCTION_COUNTING,
+    JIT_FUNCTION_COMPILING,
+    JIT_FUNCTION_COMPILED,
+    JIT_FUNCTION_FAILED,
+} DPL_Jit_FunctionState;
+
+// Compiled functions take their unboxed arguments (doubles or 0/1 for
+// booleans) as an array and return their unboxed result.
+typedef uint64_t (*DPL_Jit_Entry)(const uint64_t *arguments);
+
+typedef struct DPL_Jit_Function
+{
+    size_t target;
+    size_t arity;
+    size_t calls;
+    DPL_Jit_FunctionState state;
+
+    DPL_Jit_Type argument_types[DPLV_JIT_MAX_SLOTS];
+    DPL_Jit_Type return_type;
+
+    DPL_Jit_Entry entry;
+    void *code;
+    size_t code_size;
+} DPL_Jit_Function;
+
+typedef struct DPL_Jit
+{
+    // Indexed by instruction, only set for the targets of user calls.
+    DPL_Jit_Function **functions;
+    // Nesting of compiled functions on the native stack.
+    size_t depth;
+} DPL_Jit;
+
+bool dplv_jit_supported(void)
+{
+    return true;
+}
+
+void dplv_jit_init(DPL_VirtualMachine *vm)
+{
+    if (vm->jit_threshold == 0)
+    {
+        vm->jit_threshold = DPLV_JIT_THRESHOLD;
+    }
+
+    DPL_Jit *jit = arena_alloc(&vm->memory, sizeof(DPL_Jit));
+    jit->functions = arena_alloc(&vm->memory, vm->code_count * sizeof(*jit->functions));
+    memset(jit->functions, 0, vm->code_count * sizeof(*jit->functions));
+    jit->depth = 0;
+
+    vm->jit_state = jit;
+}
+
+void dplv_jit_free(DPL_VirtualMachine *vm)
+{
+    DPL_Jit *jit = vm->jit_state;
+    if (!jit)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < vm->code_count; ++i)
+    {
+        if (jit->functions[i] && jit->functions[i]->code)
+        {
+            munmap(jit->functions[i]->code, jit->functions[i]->code_size);
+        }
+    }
+    vm->jit_state = NULL;
+}
+
+static DPL_Jit_Function *_dplv_jit_function(DPL_VirtualMachine *vm, size_t target, size_t arity)
+{
+    DPL_Jit *jit = vm->jit_state;
+    if (!jit->functions[target])
+    {
+        DPL_Jit_Function *function = arena_alloc(&vm->memory, sizeof(DPL_Jit_Function));
+        memset(function, 0, sizeof(*function));
+        function->target = target;
+        function->arity = arity;
+        jit->functions[target] = function;
+    }
+    return jit->functions[target];
+}
+
+static DPL_Jit_Type _dplv_jit_type_of(DPL_Value value)
+{
+    switch (dpl_value_kind(value))
+    {
+    case VALUE_NUMBER:
+        return JIT_TYPE_NUMBER;
+    case VALUE_BOOLEAN:
+        return JIT_TYPE_BOOLEAN;
+    default:
+        return JIT_TYPE_UNKNOWN;
+    }
+}
+
+static uint64_t _dplv_jit_unbox(DPL_Value value)
+{
+    if (dpl_value_kind(value) == VALUE_BOOLEAN)
+    {
+        return dpl_value_as_boolean(value) ? 1 : 0;
+    }
+
+    double number = dpl_value_as_number(value);
+    uint64_t bits;
+    memcpy(&bits, &number, sizeof(bits));
+    return bits;
+}
+
+static DPL_Value _dplv_jit_box(DPL_Jit_Type type, uint64_t bits)
+{
+    if (type == JIT_TYPE_BOOLEAN)
+    {
+        return dpl_value_make_boolean(bits != 0);
+    }
+
+    double number;
+    memcpy(&number, &bits, sizeof(number));
+    return dpl_value_make_number(number);
+}
+
+// Called by compiled code instead of entering a function when the native
+// nesting limit is reached.
+static uint64_t _dplv_jit_interpret(DPL_VirtualMachine *vm, DPL_Jit_Function *function, const uint64_t *arguments)
+{
+    dplv_ensure_stack(vm, vm->stack_top + function->arity);
+    for (size_t i = 0; i < function->arity; ++i)
+    {
+        vm->stack[vm->stack_top++] = _dplv_jit_box(function->argument_types[i], arguments[i]);
+    }
+
+    dplv_run_function(vm, function->target, function->arity);
+    return _dplv_jit_unbox(vm->stack[--vm->stack_top]);
+}
+
+// TYPE INFERENCE
+//
+// Compiled code keeps every stack slot of a function at a fixed offset of its
+// native frame, so the stack depth and the type of each slot must be known
+// statically for each instruction. They are computed by abstract
+// interpretation over the reachable instructions of the function.
+
+typedef struct
+{
+    int depth;
+    DPL_Jit_Type types[DPLV_JIT_MAX_SLOTS];
+} DPL_Jit_SlotState;
+
+typedef struct
+{
+    size_t *items;
+    size_t count;
+    size_t capacity;
+} DPL_Jit_Worklist;
+
+typedef struct
+{
+    DPL_VirtualMachine *vm;
+    DPL_Jit_Function *function;
+    DPL_Jit_SlotState *states;
+    DPL_Jit_Worklist worklist;
+    DPL_Jit_Type return_type;
+    int max_depth;
+} DPL_Jit_Inference;
+
+static bool _dplv_jit_compile(DPL_VirtualMachine *vm, DPL_Jit_Function *function, const DPL_Jit_Type *argument_types);
+
+static bool _dplv_jit_merge_type(DPL_Jit_Type *type, DPL_Jit_Type other, bool *changed)
+{
+    if (other == JIT_TYPE_UNKNOWN || *type == other)
+    {
+        return true;
+    }
+    if (*type != JIT_TYPE_UNKNOWN)
+    {
+        return false;
+    }
+
+    *type = other;
+    *changed = true;
+    return true;
+}
+
+static bool _dplv_jit_flow(DPL_Jit_Inference *inference, size_t index, const DPL_Jit_SlotState *state)
+{
+    if (index >= inference->vm->code_count || state->depth < 0 || state->depth >= DPLV_JIT_MAX_SLOTS)
+    {
+        return false;
+    }
+    if (state->depth > inference->max_depth)
+    {
+        inference->max_depth = state->depth;
+    }
+
+    DPL_Jit_SlotState *target = &inference->states[index];
+    bool changed = false;
+    if (target->depth < 0)
+    {
+        *target = *state;
+        changed = true;
+    }
+    else
+    {
+        if (target->depth != state->depth)
+        {
+            return false;
+        }
+        for (int i = 0; i < state->depth; ++i)
+        {
+            if (!_dplv_jit_merge_type(&target->types[i], state->types[i], &changed))
+            {
+                return false;
+            }
+        }
+    }
+
+    if (changed)
+    {
+        nob_da_append(&inference->worklist, index);
+    }
+    return true;
+}
+
+// Determines the result type of a call with the argument types on top of
+// `state`, compiling the callee first if necessary.
+static bool _dplv_jit_infer_call(DPL_Jit_Inference *inference, const DPL_Instruction *instruction,
+                                 const DPL_Jit_SlotState *state, DPL_Jit_Type *result)
+{
+    size_t arity = instruction->count;
+    if ((size_t)state->depth < arity)
+    {
+        return false;
+    }
+    const DPL_Jit_Type *argument_types = &state->types[state->depth - arity];
+
+    // Argument types may still be unknown in an early iteration.
+    for (size_t i = 0; i < arity; ++i)
+    {
+        if (argument_types[i] == JIT_TYPE_UNKNOWN)
+        {
+            *result = JIT_TYPE_UNKNOWN;
+            return true;
+        }
+    }
+
+    DPL_Jit_Function *callee = _dplv_jit_function(inference->vm, instruction->as.call.target, arity);
+    if (callee == inference->function)
+    {
+        *result = inference->return_type;
+        return memcmp(argument_types, callee->argument_types, arity * sizeof(*argument_types)) == 0;
+    }
+
+    if (callee->state == JIT_FUNCTION_COUNTING)
+    {
+        _dplv_jit_compile(inference->vm, callee, argument_types);
+    }
+    if (callee->state != JIT_FUNCTION_COMPILED ||
+        memcmp(argument_types, callee->argument_types, arity * sizeof(*argument_types)) != 0)
+    {
+        return false;
+    }
+
+    *result = callee->return_type;
+    return true;
+}
+
+static bool _dplv_jit_infer_instruction(DPL_Jit_Inference *inference, size_t index)
+{
+    const DPL_Instruction *instruction = &inference->vm->code[index];
+    DPL_Jit_SlotState state = inference->states[index];
+    int depth = state.depth;
+
+#define REQUIRE_DEPTH(n)          \
+    do                            \
+    {                             \
+        if (depth < (int)(n))     \
+        {                         \
+            return false;         \
+        }                         \
+    } while (false)
+#define REQUIRE_SLOT(slot)                      \
+    do                                          \
+    {                                           \
+        if ((size_t)(slot) >= (size_t)depth)    \
+        {                                       \
+            return false;                       \
+        }                                       \
+    } while (false)
+
+    switch (instruction->kind)
+    {
+    case INST_NOOP:
+        break;
+    case INST_PUSH_NUMBER:
+        state.types[state.depth++] = JIT_TYPE_NUMBER;
+        break;
+    case INST_PUSH_BOOLEAN:
+        state.types[state.depth++] = JIT_TYPE_BOOLEAN;
+        break;
+    case INST_POP:
+        REQUIRE_DEPTH(1);
+        --state.depth;
+        break;
+    case INST_NEGATE:
+        REQUIRE_DEPTH(1);
+        state.types[depth - 1] = JIT_TYPE_NUMBER;
+        break;
+    case INST_NOT:
+        REQUIRE_DEPTH(1);
+        state.types[depth - 1] = JIT_TYPE_BOOLEAN;
+        break;
+    case INST_ADD_NUMBER:
+    case INST_SUBTRACT:
+    case INST_MULTIPLY:
+    case INST_DIVIDE:
+        REQUIRE_DEPTH(2);
+        state.types[--state.depth - 1] = JIT_TYPE_NUMBER;
+        break;
+    case INST_LESS:
+    case INST_LESS_EQUAL:
+    case INST_GREATER:
+    case INST_GREATER_EQUAL:
+    case INST_EQUAL_NUMBER:
+    case INST_NOT_EQUAL_NUMBER:
+    case INST_EQUAL_BOOLEAN:
+    case INST_NOT_EQUAL_BOOLEAN:
+        REQUIRE_DEPTH(2);
+        state.types[--state.depth - 1] = JIT_TYPE_BOOLEAN;
+        break;
+    case INST_PUSH_LOCAL:
+        REQUIRE_SLOT(instruction->as.index);
+        state.types[state.depth++] = state.types[instruction->as.index];
+        break;
+    case INST_STORE_LOCAL:
+    {
+        REQUIRE_SLOT(instruction->as.index);
+        bool changed = false;
+        if (!_dplv_jit_merge_type(&state.types[instruction->as.index], state.types[depth - 1], &changed))
+        {
+            return false;
+        }
+    }
+    break;
+    case INST_POP_SCOPE:
+        REQUIRE_DEPTH(instruction->as.index + 1);
+        state.types[depth - 1 - instruction->as.index] = state.types[depth - 1];
+        state.depth -= instruction->as.index;
+        break;
+    case INST_ADD_LOCAL_NUMBER:
+        REQUIRE_SLOT(instruction->as.update.source);
+        REQUIRE_SLOT(instruction->as.update.target);
+        state.types[instruction->as.update.target] = JIT_TYPE_NUMBER;
+        state.types[state.depth++] = JIT_TYPE_NUMBER;
+        break;
+    case INST_JUMP:
+    case INST_JUMP_LOOP:
+        return _dplv_jit_flow(inference, instruction->as.index, &state);
+    case INST_JUMP_IF_FALSE:
+    case INST_JUMP_IF_TRUE:
+        REQUIRE_DEPTH(1);
+        if (!_dplv_jit_flow(inference, instruction->as.index, &state))
+        {
+            return false;
+        }
+        break;
+    case INST_LESS_JUMP_IF_FALSE:
+    {
+        REQUIRE_DEPTH(2);
+        DPL_Jit_SlotState jump_state = state;
+        jump_state.types[--jump_state.depth - 1] = JIT_TYPE_BOOLEAN;
+        if (!_dplv_jit_flow(inference, instruction->as.index, &jump_state))
+        {
+            return false;
+        }
+        state.depth -= 2;
+    }
+    break;
+    case INST_CALL_USER:
+    {
+        DPL_Jit_Type result;
+        if (!_dplv_jit_infer_call(inference, instruction, &state, &result))
+        {
+            return false;
+        }
+        state.depth -= instruction->count;
+        state.types[state.depth++] = result;
+    }
+    break;
+    case INST_TAIL_CALL_USER:
+    {
+        DPL_Jit_Type result;
+        if (!_dplv_jit_infer_call(inference, instruction, &state, &result))
+        {
+            return false;
+        }
+        bool changed = false;
+        return _dplv_jit_merge_type(&inference->return_type, result, &changed);
+    }
+    case INST_RETURN:
+    {
+        REQUIRE_DEPTH(1);
+        bool changed = false;
+        return _dplv_jit_merge_type(&inference->return_type, state.types[depth - 1], &changed);
+    }
+    default:
+        // Strings, objects, arrays and intrinsics stay in the interpreter.
+        return false;
+    }
+
+#undef REQUIRE_SLOT
+#undef REQUIRE_DEPTH
+
+    return _dplv_jit_flow(inference, index + 1, &state);
+}
+
+static bool _dplv_jit_infer(DPL_Jit_Inference *inference)
+{
+    for (size_t i = 0; i < inference->vm->code_count; ++i)
+    {
+        inference->states[i].depth = -1;
+    }
+    inference->worklist.count = 0;
+    inference->max_depth = 0;
+
+    DPL_Jit_SlotState entry = {.depth = inference->function->arity};
+    memcpy(entry.types, inference->function->argument_types, sizeof(entry.types));
+    if (!_dplv_jit_flow(inference, inference->function->target, &entry))
+    {
+        return false;
+    }
+
+    while (inference->worklist.count > 0)
+    {
+        size_t index = inference->worklist.items[--inference->worklist.count];
+        if (!_dplv_jit_infer_instruction(inference, index))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// CODE GENERATION
+//
+// Each instruction is translated into a fixed machine code template. `rbx`
+// points to the native frame holding one 8-byte slot per stack slot of the
+// function. Numbers are stored as doubles and booleans as 0 or 1.
+
+typedef struct
+{
+    uint8_t *items;
+    size_t count;
+    size_t capacity;
+} DPL_Jit_Code;
+
+typedef struct
+{
+    size_t position;
+    size_t target;
+} DPL_Jit_Fixup;
+
+typedef struct
+{
+    DPL_Jit_Fixup *items;
+    size_t count;
+    size_t capacity;
+} DPL_Jit_Fixups;
+
+typedef struct
+{
+    DPL_VirtualMachine *vm;
+    DPL_Jit_Function *function;
+    DPL_Jit_Code code;
+    DPL_Jit_Fixups fixups;
+    size_t *offsets;
+    size_t body;
+} DPL_Jit_Emitter;
+
+static void _dplv_jit_emit(DPL_Jit_Emitter *emitter, size_t count, const uint8_t *bytes)
+{
+    nob_da_append_many(&emitter->code, bytes, count);
+}
+
+#define EMIT(...)                                                               \
+    _dplv_jit_emit(emitter, sizeof((uint8_t[]){__VA_ARGS__}), (uint8_t[]){__VA_ARGS__})
+
+static void _dplv_jit_emit_u32(DPL_Jit_Emitter *emitter, uint32_t value)
+{
+    _dplv_jit_emit(emitter, sizeof(value), (uint8_t *)&value);
+}
+
+static void _dplv_jit_emit_u64(DPL_Jit_Emitter *emitter, uint64_t value)
+{
+    _dplv_jit_emit(emitter, sizeof(value), (uint8_t *)&value);
+}
+
+static void _dplv_jit_emit_slot(DPL_Jit_Emitter *emitter, size_t slot)
+{
+    _dplv_jit_emit_u32(emitter, (uint32_t)(slot * sizeof(uint64_t)));
+}
+
+// mov rax, imm64
+static void _dplv_jit_emit_load_rax(DPL_Jit_Emitter *emitter, uint64_t value)
+{
+    EMIT(0x48, 0xB8);
+    _dplv_jit_emit_u64(emitter, value);
+}
+
+// mov rax, [rbx + slot]
+static void _dplv_jit_emit_load_slot(DPL_Jit_Emitter *emitter, size_t slot)
+{
+    EMIT(0x48, 0x8B, 0x83);
+    _dplv_jit_emit_slot(emitter, slot);
+}
+
+// mov [rbx + slot], rax
+static void _dplv_jit_emit_store_slot(DPL_Jit_Emitter *emitter, size_t slot)
+{
+    EMIT(0x48, 0x89, 0x83);
+    _dplv_jit_emit_slot(emitter, slot);
+}
+
+// mov qword [rbx + slot], imm32
+static void _dplv_jit_emit_store_slot_imm(DPL_Jit_Emitter *emitter, size_t slot, uint32_t value)
+{
+    EMIT(0x48, 0xC7, 0x83);
+    _dplv_jit_emit_slot(emitter, slot);
+    _dplv_jit_emit_u32(emitter, value);
+}
+
+// jmp/jcc rel32 to the given instruction, patched after all code is emitted.
+static void _dplv_jit_emit_jump(DPL_Jit_Emitter *emitter, size_t count, const uint8_t *opcode, size_t target)
+{
+    _dplv_jit_emit(emitter, count, opcode);
+    DPL_Jit_Fixup fixup = {.position = emitter->code.count, .target = target};
+    nob_da_append(&emitter->fixups, fixup);
+    _dplv_jit_emit_u32(emitter, 0);
+}
+
+// Calls dpl_value_compare_numbers on the two slots, leaving the result in eax.
+static void _dplv_jit_emit_compare(DPL_Jit_Emitter *emitter, size_t slot)
+{
+    EMIT(0xF2, 0x0F, 0x10, 0x83); // movsd xmm0, [rbx + slot]
+    _dplv_jit_emit_slot(emitter, slot);
+    EMIT(0xF2, 0x0F, 0x10, 0x8B); // movsd xmm1, [rbx + slot + 1]
+    _dplv_jit_emit_slot(emitter, slot + 1);
+    _dplv_jit_emit_load_rax(emitter, (uint64_t)(uintptr_t)dpl_value_compare_numbers);
+    EMIT(0xFF, 0xD0);             // call rax
+    EMIT(0x85, 0xC0);             // test eax, eax
+}
+
+// Stores the flag selected by `setcc` as boolean into the slot.
+static void _dplv_jit_emit_store_flag(DPL_Jit_Emitter *emitter, uint8_t setcc, size_t slot)
+{
+    EMIT(0x0F, setcc, 0xC0);      // setcc al
+    EMIT(0x0F, 0xB6, 0xC0);       // movzx eax, al
+    _dplv_jit_emit_store_slot(emitter, slot);
+}
+
+static void _dplv_jit_emit_epilogue(DPL_Jit_Emitter *emitter)
+{
+    EMIT(0x48, 0xB9);             // mov rcx, &jit->depth
+    _dplv_jit_emit_u64(emitter, (uint64_t)(uintptr_t)&emitter->vm->jit_state->depth);
+    EMIT(0x48, 0xFF, 0x09);       // dec qword [rcx]
+    EMIT(0x48, 0x8D, 0x65, 0xF0); // lea rsp, [rbp - 16]
+    EMIT(0x41, 0x5C);             // pop r12
+    EMIT(0x5B);                   // pop rbx
+    EMIT(0x5D);                   // pop rbp
+    EMIT(0xC3);                   // ret
+}
+
+static void _dplv_jit_emit_prologue(DPL_Jit_Emitter *emitter, size_t frame_size)
+{
+    EMIT(0x55);                   // push rbp
+    EMIT(0x48, 0x89, 0xE5);       // mov rbp, rsp
+    EMIT(0x53);                   // push rbx
+    EMIT(0x41, 0x54);             // push r12 (keeps rsp 16-byte aligned)
+
+    _dplv_jit_emit_load_rax(emitter, (uint64_t)(uintptr_t)&emitter->vm->jit_state->depth);
+    EMIT(0x48, 0x8B, 0x08);       // mov rcx, [rax]
+    EMIT(0x48, 0x81, 0xF9);       // cmp rcx, DPLV_JIT_MAX_DEPTH
+    _dplv_jit_emit_u32(emitter, DPLV_JIT_MAX_DEPTH);
+    EMIT(0x72, 0x2C);             // jb enter
+
+    // Nesting limit reached: run the function in the interpreter instead.
+    EMIT(0x48, 0x89, 0xFA);       // mov rdx, rdi
+    EMIT(0x48, 0xBF);             // mov rdi, vm
+    _dplv_jit_emit_u64(emitter, (uint64_t)(uintptr_t)emitter->vm);
+    EMIT(0x48, 0xBE);             // mov rsi, function
+    _dplv_jit_emit_u64(emitter, (uint64_t)(uintptr_t)emitter->function);
+    _dplv_jit_emit_load_rax(emitter, (uint64_t)(uintptr_t)_dplv_jit_interpret);
+    EMIT(0xFF, 0xD0);             // call rax
+    EMIT(0x48, 0x8D, 0x65, 0xF0); // lea rsp, [rbp - 16]
+    EMIT(0x41, 0x5C);             // pop r12
+    EMIT(0x5B);                   // pop rbx
+    EMIT(0x5D);                   // pop rbp
+    EMIT(0xC3);                   // ret
+
+    // enter:
+    EMIT(0x48, 0xFF, 0xC1);       // inc rcx
+    EMIT(0x48, 0x89, 0x08);       // mov [rax], rcx
+    EMIT(0x48, 0x81, 0xEC);       // sub rsp, frame_size
+    _dplv_jit_emit_u32(emitter, (uint32_t)frame_size);
+    EMIT(0x48, 0x89, 0xE3);       // mov rbx, rsp
+
+    for (size_t i = 0; i < emitter->function->arity; ++i)
+    {
+        EMIT(0x48, 0x8B, 0x87);   // mov rax, [rdi + i]
+        _dplv_jit_emit_slot(emitter, i);
+        _dplv_jit_emit_store_slot(emitter, i);
+    }
+}
+
+// Calls the compiled callee with the arguments in the slots starting at
+// `slot`, leaving the result in rax.
+static void _dplv_jit_emit_call(DPL_Jit_Emitter *emitter, const DPL_Instruction *instruction, size_t slot)
+{
+    EMIT(0x48, 0x8D, 0xBB);       // lea rdi, [rbx + slot]
+    _dplv_jit_emit_slot(emitter, slot);
+
+    DPL_Jit_Function *callee = emitter->vm->jit_state->functions[instruction->as.call.target];
+    if (callee == emitter->function)
+    {
+        EMIT(0xE8);               // call rel32 (start of this function)
+        _dplv_jit_emit_u32(emitter, (uint32_t)(-(int64_t)(emitter->code.count + sizeof(uint32_t))));
+    }
+    else
+    {
+        _dplv_jit_emit_load_rax(emitter, (uint64_t)(uintptr_t)callee->entry);
+        EMIT(0xFF, 0xD0);         // call rax
+    }
+}
+
+static void _dplv_jit_emit_instruction(DPL_Jit_Emitter *emitter, const DPL_Instruction *instruction, size_t depth)
+{
+    static const uint8_t jmp[] = {0xE9};
+    static const uint8_t je[] = {0x0F, 0x84};
+    static const uint8_t jne[] = {0x0F, 0x85};
+
+    switch (instruction->kind)
+    {
+    case INST_NOOP:
+    case INST_POP:
+        break;
+    case INST_PUSH_NUMBER:
+    {
+        uint64_t bits;
+        memcpy(&bits, &instruction->as.number, sizeof(bits));
+        _dplv_jit_emit_load_rax(emitter, bits);
+        _dplv_jit_emit_store_slot(emitter, depth);
+    }
+    break;
+    case INST_PUSH_BOOLEAN:
+        _dplv_jit_emit_store_slot_imm(emitter, depth, instruction->as.boolean ? 1 : 0);
+        break;
+    case INST_NEGATE:
+        _dplv_jit_emit_load_slot(emitter, depth - 1);
+        EMIT(0x48, 0x0F, 0xBA, 0xF8, 0x3F); // btc rax, 63
+        _dplv_jit_emit_store_slot(emitter, depth - 1);
+        break;
+    case INST_NOT:
+        EMIT(0x48, 0x83, 0xB3);             // xor qword [rbx + slot], 1
+        _dplv_jit_emit_slot(emitter, depth - 1);
+        EMIT(0x01);
+        break;
+    case INST_ADD_NUMBER:
+    case INST_SUBTRACT:
+    case INST_MULTIPLY:
+    case INST_DIVIDE:
+    {
+        uint8_t operation = (instruction->kind == INST_ADD_NUMBER)   ? 0x58
+                            : (instruction->kind == INST_SUBTRACT) ? 0x5C
+                            : (instruction->kind == INST_MULTIPLY) ? 0x59
+                                                                   : 0x5E;
+        EMIT(0xF2, 0x0F, 0x10, 0x83);       // movsd xmm0, [rbx + slot]
+        _dplv_jit_emit_slot(emitter, depth - 2);
+        EMIT(0xF2, 0x0F, operation, 0x83);  // addsd/subsd/mulsd/divsd xmm0, [rbx + slot]
+        _dplv_jit_emit_slot(emitter, depth - 1);
+        EMIT(0xF2, 0x0F, 0x11, 0x83);       // movsd [rbx + slot], xmm0
+        _dplv_jit_emit_slot(emitter, depth - 2);
+    }
+    break;
+    case INST_LESS:
+        _dplv_jit_emit_compare(emitter, depth - 2);
+        _dplv_jit_emit_store_flag(emitter, 0x9C, depth - 2); // setl
+        break;
+    case INST_LESS_EQUAL:
+        _dplv_jit_emit_compare(emitter, depth - 2);
+        _dplv_jit_emit_store_flag(emitter, 0x9E, depth - 2); // setle
+        break;
+    case INST_GREATER:
+        _dplv_jit_emit_compare(emitter, depth - 2);
+        _dplv_jit_emit_store_flag(emitter, 0x9F, depth - 2); // setg
+        break;
+    case INST_GREATER_EQUAL:
+        _dplv_jit_emit_compare(emitter, depth - 2);
+        _dplv_jit_emit_store_flag(emitter, 0x9D, depth - 2); // setge
+        break;
+    case INST_EQUAL_NUMBER:
+        _dplv_jit_emit_compare(emitter, depth - 2);
+        _dplv_jit_emit_store_flag(emitter, 0x94, depth - 2); // sete
+        break;
+    case INST_NOT_EQUAL_NUMBER:
+        _dplv_jit_emit_compare(emitter, depth - 2);
+        _dplv_jit_emit_store_flag(emitter, 0x95, depth - 2); // setne
+        break;
+    case INST_EQUAL_BOOLEAN:
+    case INST_NOT_EQUAL_BOOLEAN:
+        _dplv_jit_emit_load_slot(emitter, depth - 2);
+        EMIT(0x48, 0x3B, 0x83);             // cmp rax, [rbx + slot]
+        _dplv_jit_emit_slot(emitter, depth - 1);
+        _dplv_jit_emit_store_flag(emitter, (instruction->kind == INST_EQUAL_BOOLEAN) ? 0x94 : 0x95, depth - 2);
+        break;
+    case INST_PUSH_LOCAL:
+        _dplv_jit_emit_load_slot(emitter, instruction->as.index);
+        _dplv_jit_emit_store_slot(emitter, depth);
+        break;
+    case INST_STORE_LOCAL:
+        _dplv_jit_emit_load_slot(emitter, depth - 1);
+        _dplv_jit_emit_store_slot(emitter, instruction->as.index);
+        break;
+    case INST_POP_SCOPE:
+        _dplv_jit_emit_load_slot(emitter, depth - 1);
+        _dplv_jit_emit_store_slot(emitter, depth - 1 - instruction->as.index);
+        break;
+    case INST_ADD_LOCAL_NUMBER:
+    {
+        uint64_t bits;
+        memcpy(&bits, &instruction->as.update.number, sizeof(bits));
+        EMIT(0xF2, 0x0F, 0x10, 0x83);       // movsd xmm0, [rbx + source]
+        _dplv_jit_emit_slot(emitter, instruction->as.update.source);
+        _dplv_jit_emit_load_rax(emitter, bits);
+        EMIT(0x66, 0x48, 0x0F, 0x6E, 0xC8); // movq xmm1, rax
+        EMIT(0xF2, 0x0F, 0x58, 0xC1);       // addsd xmm0, xmm1
+        EMIT(0xF2, 0x0F, 0x11, 0x83);       // movsd [rbx + target], xmm0
+        _dplv_jit_emit_slot(emitter, instruction->as.update.target);
+        EMIT(0xF2, 0x0F, 0x11, 0x83);       // movsd [rbx + slot], xmm0
+        _dplv_jit_emit_slot(emitter, depth);
+    }
+    break;
+    case INST_JUMP:
+    case INST_JUMP_LOOP:
+        _dplv_jit_emit_jump(emitter, sizeof(jmp), jmp, instruction->as.index);
+        break;
+    case INST_JUMP_IF_FALSE:
+    case INST_JUMP_IF_TRUE:
+        EMIT(0x48, 0x83, 0xBB);             // cmp qword [rbx + slot], 0
+        _dplv_jit_emit_slot(emitter, depth - 1);
+        EMIT(0x00);
+        if (instruction->kind == INST_JUMP_IF_FALSE)
+        {
+            _dplv_jit_emit_jump(emitter, sizeof(je), je, instruction->as.index);
+        }
+        else
+        {
+            _dplv_jit_emit_jump(emitter, sizeof(jne), jne, instruction->as.index);
+        }
+        break;
+    case INST_LESS_JUMP_IF_FALSE:
+        _dplv_jit_emit_compare(emitter, depth - 2);
+        EMIT(0x78, 0x10);                   // js over the next 16 bytes
+        _dplv_jit_emit_store_slot_imm(emitter, depth - 2, 0);
+        _dplv_jit_emit_jump(emitter, sizeof(jmp), jmp, instruction->as.index);
+        break;
+    case INST_CALL_USER:
+        _dplv_jit_emit_call(emitter, instruction, depth - instruction->count);
+        _dplv_jit_emit_store_slot(emitter, depth - instruction->count);
+        break;
+    case INST_TAIL_CALL_USER:
+        if (emitter->vm->jit_state->functions[instruction->as.call.target] == emitter->function)
+        {
+            // Self recursion becomes a loop: move the arguments in place and
+            // jump back to the start of the body.
+            for (size_t i = 0; i < instruction->count; ++i)
+            {
+                _dplv_jit_emit_load_slot(emitter, depth - instruction->count + i);
+                _dplv_jit_emit_store_slot(emitter, i);
+            }
+            EMIT(0xE9);
+            _dplv_jit_emit_u32(emitter, (uint32_t)(emitter->body - (emitter->code.count + sizeof(uint32_t))));
+        }
+        else
+        {
+            _dplv_jit_emit_call(emitter, instruction, depth - instruction->count);
+            _dplv_jit_emit_epilogue(emitter);
+        }
+        break;
+    case INST_RETURN:
+        _dplv_jit_emit_load_slot(emitter, depth - 1);
+        _dplv_jit_emit_epilogue(emitter);
+        break;
+    default:
+        DW_UNIMPLEMENTED_MSG("`%s` in compiled code.", dplp_inst_kind_name(instruction->kind));
+    }
+}
+
+#undef EMIT
+
+static bool _dplv_jit_emit_function(DPL_Jit_Inference *inference)
+{
+    DPL_VirtualMachine *vm = inference->vm;
+    DPL_Jit_Function *function = inference->function;
+
+    DPL_Jit_Emitter emitter = {
+        .vm = vm,
+        .function = function,
+        .offsets = malloc(vm->code_count * sizeof(size_t)),
+    };
+
+    // One additional slot for instructions pushing at the maximum depth,
+    // rounded up to keep the native stack 16-byte aligned.
+    size_t frame_size = ((inference->max_depth + 2) & ~(size_t)1) * sizeof(uint64_t);
+    _dplv_jit_emit_prologue(&emitter, frame_size);
+    emitter.body = emitter.code.count;
+
+    for (size_t i = 0; i < vm->code_count; ++i)
+    {
+        if (inference->states[i].depth >= 0)
+        {
+            emitter.offsets[i] = emitter.code.count;
+            _dplv_jit_emit_instruction(&emitter, &vm->code[i], inference->states[i].depth);
+        }
+    }
+
+    for (size_t i = 0; i < emitter.fixups.count; ++i)
+    {
+        DPL_Jit_Fixup fixup = emitter.fixups.items[i];
+        uint32_t relative = (uint32_t)(emitter.offsets[fixup.target] - (fixup.position + sizeof(uint32_t)));
+        memcpy(&emitter.code.items[fixup.position], &relative, sizeof(relative));
+    }
+
+    bool success = false;
+    void *code = mmap(NULL, emitter.code.count, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (code != MAP_FAILED)
+    {
+        memcpy(code, emitter.code.items, emitter.code.count);
+        if (mprotect(code, emitter.code.count, PROT_READ | PROT_EXEC) == 0)
+        {
+            function->code = code;
+            function->code_size = emitter.code.count;
+            function->entry = (DPL_Jit_Entry)code;
+            success = true;
+        }
+        else
+        {
+            munmap(code, emitter.code.count);
+        }
+    }
+
+    nob_da_free(emitter.code);
+    nob_da_free(emitter.fixups);
+    free(emitter.offsets);
+    return success;
+}
+
+static bool _dplv_jit_compile(DPL_VirtualMachine *vm, DPL_Jit_Function *function, const DPL_Jit_Type *argument_types)
+{
+    function->state = JIT_FUNCTION_FAILED;
+    if (function->arity > DPLV_JIT_MAX_SLOTS)
+    {
+        return false;
+    }
+
+    function->state = JIT_FUNCTION_COMPILING;
+    memcpy(function->argument_types, argument_types, function->arity * sizeof(*argument_types));
+
+    DPL_Jit_Inference inference = {
+        .vm = vm,
+        .function = function,
+        .states = malloc(vm->code_count * sizeof(DPL_Jit_SlotState)),
+    };
+
+    // The result type of recursive calls is only known once a non-recursive
+    // return has been seen, so infer until the return type is stable.
+    bool success = false;
+    for (int iteration = 0; iteration < 3; ++iteration)
+    {
+        DPL_Jit_Type return_type = inference.return_type;
+        if (!_dplv_jit_infer(&inference))
+        {
+            break;
+        }
+        if (inference.return_type == return_type)
+        {
+            success = (return_type != JIT_TYPE_UNKNOWN);
+            break;
+        }
+    }
+
+    // Recursive calls must have resolved to a known type as well.
+    for (size_t i = 0; success && i < vm->code_count; ++i)
+    {
+        for (int j = 0; j < inference.states[i].depth; ++j)
+        {
+            if (inference.states[i].types[j] == JIT_TYPE_UNKNOWN)
+            {
+                success = false;
+                break;
+            }
+        }
+    }
+
+    if (success)
+    {
+        function->return_type = inference.return_type;
+        success = _dplv_jit_emit_function(&inference);
+    }
+
+    function->state = success ? JIT_FUNCTION_COMPILED : JIT_FUNCTION_FAILED;
+
+    nob_da_free(inference.worklist);
+    free(inference.states);
+    return success;
+}
+
+bool dplv_jit_call(DPL_VirtualMachine *vm, size_t target, size_t arity)
+{
+    DPL_Jit *jit = vm->jit_state;
+    if (jit->depth >= DPLV_JIT_MAX_DEPTH)
+    {
+        return false;
+    }
+
+    DPL_Jit_Function *function = _dplv_jit_function(vm, target, arity);
+    DPL_Value *arguments = &vm->stack[vm->stack_top - arity];
+
+    if (function->state == JIT_FUNCTION_COUNTING)
+    {
+        if (++function->calls < vm->jit_threshold)
+        {
+            return false;
+        }
+
+        DPL_Jit_Type argument_types[DPLV_JIT_MAX_SLOTS];
+        for (size_t i = 0; i < arity && i < DPLV_JIT_MAX_SLOTS; ++i)
+        {
+            argument_types[i] = _dplv_jit_type_of(arguments[i]);
+            if (argument_types[i] == JIT_TYPE_UNKNOWN)
+            {
+                function->state = JIT_FUNCTION_FAILED;
+                return false;
+            }
+        }
+
+        _dplv_jit_compile(vm, function, argument_types);
+    }
+
+    if (function->state != JIT_FUNCTION_COMPILED)
+    {
+        return false;
+    }
+
+    uint64_t unboxed[DPLV_JIT_MAX_SLOTS];
+    for (size_t i = 0; i < arity; ++i)
+    {
+        if (_dplv_jit_type_of(arguments[i]) != function->argument_types[i])
+        {
+            return false;
+        }
+        unboxed[i] = _dplv_jit_unbox(arguments[i]);
+    }
+
+    uint64_t result = function->entry(unboxed);
+
+    vm->stack_top -= arity;
+    vm->stack[vm->stack_top++] = _dplv_jit_box(function->return_type, result);
+    return true;
+}
+
+#else
+
+bool dplv_jit_supported(void)
+{
+    return false;
+}
+
+void dplv_jit_init(DPL_VirtualMachine *vm)
+{
+    vm->jit = false;
+}
+
+void dplv_jit_free(DPL_VirtualMachine *vm)
+{
+    DW_UNUSED(vm);
+}
+
+bool dplv_jit_call(DPL_VirtualMachine *vm, size_t target, size_t arity)
+{
+    DW_UNUSED(vm);
+    DW_UNUSED(target);
+    DW_UNUSED(arity);
+    return false;
+}
+
+#endif // DPLV_JIT_SUPPORTED
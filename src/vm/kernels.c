@@ -0,0 +1,390 @@
+#include <math.h>
+
+#include <dpl/vm/kernels.h>
+
+#ifdef DPLV_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+// SCALAR
+
+// A NaN anywhere makes the minimum and maximum NaN, in every kernel.
+static inline double dplv_kernels__min2(double a, double b)
+{
+    return (isnan(a) || a < b) ? a : b;
+}
+
+static inline double dplv_kernels__max2(double a, double b)
+{
+    return (isnan(a) || a > b) ? a : b;
+}
+
+static double dplv_kernels__sum_scalar(const double *a, size_t n)
+{
+    double result = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        result += a[i];
+    }
+    return result;
+}
+
+static double dplv_kernels__min_scalar(const double *a, size_t n)
+{
+    double result = a[0];
+    for (size_t i = 1; i < n; ++i)
+    {
+        result = dplv_kernels__min2(a[i], result);
+    }
+    return result;
+}
+
+static double dplv_kernels__max_scalar(const double *a, size_t n)
+{
+    double result = a[0];
+    for (size_t i = 1; i < n; ++i)
+    {
+        result = dplv_kernels__max2(a[i], result);
+    }
+    return result;
+}
+
+static double dplv_kernels__dot_scalar(const double *a, const double *b, size_t n)
+{
+    double result = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        result += a[i] * b[i];
+    }
+    return result;
+}
+
+static void dplv_kernels__scale_scalar(double *out, const double *a, double factor, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        out[i] = a[i] * factor;
+    }
+}
+
+static void dplv_kernels__add_scalar(double *out, const double *a, const double *b, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        out[i] = a[i] + b[i];
+    }
+}
+
+static void dplv_kernels__multiply_scalar(double *out, const double *a, const double *b, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        out[i] = a[i] * b[i];
+    }
+}
+
+#ifdef DPLV_KERNELS_X86
+
+// SSE2 (always available on x86-64)
+
+static double dplv_kernels__hsum_sse2(__m128d v)
+{
+    return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+}
+
+static double dplv_kernels__sum_sse2(const double *a, size_t n)
+{
+    __m128d acc = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        acc = _mm_add_pd(acc, _mm_loadu_pd(a + i));
+    }
+    return dplv_kernels__hsum_sse2(acc) + dplv_kernels__sum_scalar(a + i, n - i);
+}
+
+static double dplv_kernels__min_sse2(const double *a, size_t n)
+{
+    if (n < 2)
+    {
+        return dplv_kernels__min_scalar(a, n);
+    }
+
+    // _mm_min_pd drops NaNs in its first operand. They are tracked apart and
+    // handled by the scalar kernel, which returns the same NaN.
+    __m128d acc = _mm_loadu_pd(a);
+    __m128d nan = _mm_cmpunord_pd(acc, acc);
+    size_t i = 2;
+    for (; i + 2 <= n; i += 2)
+    {
+        const __m128d v = _mm_loadu_pd(a + i);
+        acc = _mm_min_pd(acc, v);
+        nan = _mm_or_pd(nan, _mm_cmpunord_pd(v, v));
+    }
+    if (_mm_movemask_pd(nan))
+    {
+        return dplv_kernels__min_scalar(a, n);
+    }
+    acc = _mm_min_sd(acc, _mm_unpackhi_pd(acc, acc));
+
+    double result = _mm_cvtsd_f64(acc);
+    if (i < n)
+    {
+        result = dplv_kernels__min2(dplv_kernels__min_scalar(a + i, n - i), result);
+    }
+    return result;
+}
+
+static double dplv_kernels__max_sse2(const double *a, size_t n)
+{
+    if (n < 2)
+    {
+        return dplv_kernels__max_scalar(a, n);
+    }
+
+    // _mm_max_pd drops NaNs in its first operand. They are tracked apart and
+    // handled by the scalar kernel, which returns the same NaN.
+    __m128d acc = _mm_loadu_pd(a);
+    __m128d nan = _mm_cmpunord_pd(acc, acc);
+    size_t i = 2;
+    for (; i + 2 <= n; i += 2)
+    {
+        const __m128d v = _mm_loadu_pd(a + i);
+        acc = _mm_max_pd(acc, v);
+        nan = _mm_or_pd(nan, _mm_cmpunord_pd(v, v));
+    }
+    if (_mm_movemask_pd(nan))
+    {
+        return dplv_kernels__max_scalar(a, n);
+    }
+    acc = _mm_max_sd(acc, _mm_unpackhi_pd(acc, acc));
+
+    double result = _mm_cvtsd_f64(acc);
+    if (i < n)
+    {
+        result = dplv_kernels__max2(dplv_kernels__max_scalar(a + i, n - i), result);
+    }
+    return result;
+}
+
+static double dplv_kernels__dot_sse2(const double *a, const double *b, size_t n)
+{
+    __m128d acc = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        acc = _mm_add_pd(acc, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    }
+    return dplv_kernels__hsum_sse2(acc) + dplv_kernels__dot_scalar(a + i, b + i, n - i);
+}
+
+static void dplv_kernels__scale_sse2(double *out, const double *a, double factor, size_t n)
+{
+    const __m128d f = _mm_set1_pd(factor);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        _mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(a + i), f));
+    }
+    dplv_kernels__scale_scalar(out + i, a + i, factor, n - i);
+}
+
+static void dplv_kernels__add_sse2(double *out, const double *a, const double *b, size_t n)
+{
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        _mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    }
+    dplv_kernels__add_scalar(out + i, a + i, b + i, n - i);
+}
+
+static void dplv_kernels__multiply_sse2(double *out, const double *a, const double *b, size_t n)
+{
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        _mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    }
+    dplv_kernels__multiply_scalar(out + i, a + i, b + i, n - i);
+}
+
+static const DPLV_Kernels dplv_kernels__sse2 = {
+    .sum = dplv_kernels__sum_sse2,
+    .min = dplv_kernels__min_sse2,
+    .max = dplv_kernels__max_sse2,
+    .dot = dplv_kernels__dot_sse2,
+    .scale = dplv_kernels__scale_sse2,
+    .add = dplv_kernels__add_sse2,
+    .multiply = dplv_kernels__multiply_sse2,
+};
+
+// AVX2 (selected at runtime)
+
+#define DPLV_AVX2 __attribute__((target("avx2")))
+
+DPLV_AVX2 static __m128d dplv_kernels__fold_avx2(__m256d v)
+{
+    return _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+}
+
+DPLV_AVX2 static double dplv_kernels__sum_avx2(const double *a, size_t n)
+{
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(a + i));
+        acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(a + i + 4));
+    }
+    const double head = dplv_kernels__hsum_sse2(dplv_kernels__fold_avx2(_mm256_add_pd(acc0, acc1)));
+    return head + dplv_kernels__sum_sse2(a + i, n - i);
+}
+
+DPLV_AVX2 static double dplv_kernels__min_avx2(const double *a, size_t n)
+{
+    if (n < 4)
+    {
+        return dplv_kernels__min_sse2(a, n);
+    }
+
+    __m256d acc = _mm256_loadu_pd(a);
+    __m256d nan = _mm256_cmp_pd(acc, acc, _CMP_UNORD_Q);
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4)
+    {
+        const __m256d v = _mm256_loadu_pd(a + i);
+        acc = _mm256_min_pd(acc, v);
+        nan = _mm256_or_pd(nan, _mm256_cmp_pd(v, v, _CMP_UNORD_Q));
+    }
+    if (_mm256_movemask_pd(nan))
+    {
+        return dplv_kernels__min_scalar(a, n);
+    }
+    __m128d half = _mm_min_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+    half = _mm_min_sd(half, _mm_unpackhi_pd(half, half));
+
+    double result = _mm_cvtsd_f64(half);
+    if (i < n)
+    {
+        result = dplv_kernels__min2(dplv_kernels__min_scalar(a + i, n - i), result);
+    }
+    return result;
+}
+
+DPLV_AVX2 static double dplv_kernels__max_avx2(const double *a, size_t n)
+{
+    if (n < 4)
+    {
+        return dplv_kernels__max_sse2(a, n);
+    }
+
+    __m256d acc = _mm256_loadu_pd(a);
+    __m256d nan = _mm256_cmp_pd(acc, acc, _CMP_UNORD_Q);
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4)
+    {
+        const __m256d v = _mm256_loadu_pd(a + i);
+        acc = _mm256_max_pd(acc, v);
+        nan = _mm256_or_pd(nan, _mm256_cmp_pd(v, v, _CMP_UNORD_Q));
+    }
+    if (_mm256_movemask_pd(nan))
+    {
+        return dplv_kernels__max_scalar(a, n);
+    }
+    __m128d half = _mm_max_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+    half = _mm_max_sd(half, _mm_unpackhi_pd(half, half));
+
+    double result = _mm_cvtsd_f64(half);
+    if (i < n)
+    {
+        result = dplv_kernels__max2(dplv_kernels__max_scalar(a + i, n - i), result);
+    }
+    return result;
+}
+
+DPLV_AVX2 static double dplv_kernels__dot_avx2(const double *a, const double *b, size_t n)
+{
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+    }
+    const double head = dplv_kernels__hsum_sse2(dplv_kernels__fold_avx2(_mm256_add_pd(acc0, acc1)));
+    return head + dplv_kernels__dot_sse2(a + i, b + i, n - i);
+}
+
+DPLV_AVX2 static void dplv_kernels__scale_avx2(double *out, const double *a, double factor, size_t n)
+{
+    const __m256d f = _mm256_set1_pd(factor);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), f));
+    }
+    dplv_kernels__scale_scalar(out + i, a + i, factor, n - i);
+}
+
+DPLV_AVX2 static void dplv_kernels__add_avx2(double *out, const double *a, const double *b, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    }
+    dplv_kernels__add_scalar(out + i, a + i, b + i, n - i);
+}
+
+DPLV_AVX2 static void dplv_kernels__multiply_avx2(double *out, const double *a, const double *b, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    }
+    dplv_kernels__multiply_scalar(out + i, a + i, b + i, n - i);
+}
+
+static const DPLV_Kernels dplv_kernels__avx2 = {
+    .sum = dplv_kernels__sum_avx2,
+    .min = dplv_kernels__min_avx2,
+    .max = dplv_kernels__max_avx2,
+    .dot = dplv_kernels__dot_avx2,
+    .scale = dplv_kernels__scale_avx2,
+    .add = dplv_kernels__add_avx2,
+    .multiply = dplv_kernels__multiply_avx2,
+};
+
+const DPLV_Kernels *dplv_kernels(void)
+{
+    static const DPLV_Kernels *kernels = NULL;
+    if (!kernels)
+    {
+        __builtin_cpu_init();
+        kernels = __builtin_cpu_supports("avx2") ? &dplv_kernels__avx2 : &dplv_kernels__sse2;
+    }
+    return kernels;
+}
+
+#else
+
+static const DPLV_Kernels dplv_kernels__scalar = {
+    .sum = dplv_kernels__sum_scalar,
+    .min = dplv_kernels__min_scalar,
+    .max = dplv_kernels__max_scalar,
+    .dot = dplv_kernels__dot_scalar,
+    .scale = dplv_kernels__scale_scalar,
+    .add = dplv_kernels__add_scalar,
+    .multiply = dplv_kernels__multiply_scalar,
+};
+
+const DPLV_Kernels *dplv_kernels(void)
+{
+    return &dplv_kernels__scalar;
+}
+
+#endif
@@ -0,0 +1,147 @@
+#ifdef DPL_LEAKCHECK
+#include <stb_leakcheck.h>
+#endif
+
+#include <dpl/vm/intrinsics.h>
+#include <dpl/vm/runtime.h>
+#include <dw_error.h>
+
+void dplv_runtime_init(DPL_VirtualMachine *vm)
+{
+    vm->print_callback = dplv_print;
+    vm->stack_capacity = DPLV_STACK_CAPACITY;
+    vm->stack_max_capacity = DPLV_STACK_MAX_CAPACITY;
+    vm->stack = arena_alloc(&vm->memory, vm->stack_capacity * sizeof(*vm->stack));
+}
+
+void dplv_runtime_free(DPL_VirtualMachine *vm)
+{
+    dplv_release_pending(vm, 0);
+    nob_da_free(vm->release_queue);
+    dpl_value_pool_free(&vm->stack_pool);
+    arena_free(&vm->memory);
+}
+
+DPL_Value dplv_runtime_call_intrinsic(DPL_VirtualMachine *vm, DPL_Intrinsic_Kind kind, size_t count, const DPL_Value *arguments)
+{
+    dplv_ensure_stack(vm, vm->stack_top + count);
+    memcpy(&vm->stack[vm->stack_top], arguments, count * sizeof(*arguments));
+    vm->stack_top += count;
+
+    dpl_vm_call_intrinsic(vm, kind);
+    return vm->stack[--vm->stack_top];
+}
+
+DPL_Value dplv_runtime_concat_string(DPL_VirtualMachine *vm, DPL_Value string1, DPL_Value string2)
+{
+    DPL_Value value;
+    if (dpl_value_is_item(string1) && dpl_value_pool_will_release_item(&vm->stack_pool, dpl_value_as_string(string1)))
+    {
+        const Nob_String_View suffix = dpl_value_string_sv(&string2);
+        value = dpl_value_string_append(&vm->stack_pool, dpl_value_as_string(string1), suffix.count, suffix.data);
+    }
+    else
+    {
+        value = dpl_value_make_string_concat(&vm->stack_pool, string1, string2);
+        dplv_release(vm, string1);
+    }
+
+    dplv_release(vm, string2);
+    return value;
+}
+
+bool dplv_runtime_string_equals(DPL_VirtualMachine *vm, DPL_Value string1, DPL_Value string2)
+{
+    bool result = dpl_value_string_equals(string1, string2);
+    dplv_release(vm, string1);
+    dplv_release(vm, string2);
+    return result;
+}
+
+DPL_Value dplv_runtime_interpolation(DPL_VirtualMachine *vm, size_t count, const DPL_Value *strings)
+{
+    DPL_Value value = dpl_value_make_string_join(&vm->stack_pool, count, strings);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        dplv_release(vm, strings[i]);
+    }
+    return value;
+}
+
+DPL_Value dplv_runtime_move(DPL_Value *local)
+{
+    DPL_Value value = *local;
+    *local = dpl_value_make_number(0);
+    return value;
+}
+
+DPL_Value dplv_runtime_create_object_reuse(DPL_VirtualMachine *vm, DPL_Value source, size_t field_count, DPL_Value *fields)
+{
+    if (dpl_value_pool_will_release_item(&vm->stack_pool, dpl_value_as_object(source))
+        && dpl_value_object_overwrite(dpl_value_as_object(source), field_count, fields))
+    {
+        for (size_t i = 0; i < field_count; ++i)
+        {
+            dplv_release(vm, fields[i]);
+        }
+        return dplv_reference(vm, source);
+    }
+
+    return dpl_value_make_object(&vm->stack_pool, field_count, fields);
+}
+
+DPL_Value dplv_runtime_load_field(DPL_VirtualMachine *vm, DPL_Value object, size_t field_index)
+{
+    DPL_Value field_value = dplv_reference(vm, dpl_value_object_get_field(dpl_value_as_object(object), field_index));
+    dplv_release(vm, object);
+    return field_value;
+}
+
+double dplv_runtime_load_field_number(DPL_VirtualMachine *vm, DPL_Value object, size_t field_index)
+{
+    double number = dpl_value_object_get_number(dpl_value_as_object(object), field_index);
+    dplv_release(vm, object);
+    return number;
+}
+
+bool dplv_runtime_load_field_boolean(DPL_VirtualMachine *vm, DPL_Value object, size_t field_index)
+{
+    bool boolean = dpl_value_object_get_boolean(dpl_value_as_object(object), field_index);
+    dplv_release(vm, object);
+    return boolean;
+}
+
+void dplv_runtime_array_append(DPL_Runtime_Array *array, DPL_Value element)
+{
+    nob_da_append(array, element);
+}
+
+void dplv_runtime_array_spread(DPL_VirtualMachine *vm, DPL_Runtime_Array *array, DPL_Value source)
+{
+    DPL_MemoryValue *items = dpl_value_as_array(source);
+    for (size_t i = 0; i < dpl_value_array_element_count(items); ++i)
+    {
+        nob_da_append(array, dplv_reference(vm, dpl_value_array_get_element(items, i)));
+    }
+    dplv_release(vm, source);
+}
+
+DPL_Value dplv_runtime_array_end(DPL_VirtualMachine *vm, DPL_Runtime_Array *array)
+{
+    DPL_Value value = dpl_value_make_array(&vm->stack_pool, array->count, array->items);
+    nob_da_free(*array);
+    return value;
+}
+
+DPL_Value dplv_runtime_concat_array(DPL_VirtualMachine *vm, DPL_Value array, DPL_Value element)
+{
+    if (dpl_value_pool_will_release_item(&vm->stack_pool, dpl_value_as_array(array)))
+    {
+        return dpl_value_array_append(&vm->stack_pool, dpl_value_as_array(array), element);
+    }
+
+    DPL_Value new_array = dpl_value_make_array_concat(&vm->stack_pool, dpl_value_as_array(array), element);
+    dplv_release(vm, array);
+    return new_array;
+}
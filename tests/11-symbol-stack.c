@@ -2,6 +2,7 @@
 // SOURCE: ./src/program.c
 // SOURCE: ./src/value.c
 // SOURCE: ./src/symbols.c
+// SOURCE: ./src/verifier.c
 
 #include <stdio.h>
 #include <dpl/symbols.h>
@@ -15,19 +15,19 @@ int main()
 
     printf("Initialization\n");
 
-    const char* hello_world = "Hello, World!\n";
+    const char* hello_world = "Hello, World!!\n";
     const DPL_Value string = dpl_value_make_string(&pool, strlen(hello_world), hello_world);
     const DPL_Value object = dpl_value_make_object(&pool, DPL_VALUES(dpl_value_make_boolean(true), dpl_value_make_number(123)));
     const DPL_Value array = dpl_value_make_array(&pool, DPL_VALUES(dpl_value_make_number(1), dpl_value_make_number(2), dpl_value_make_number(3), dpl_value_make_number(4), dpl_value_make_number(5)));
     dpl_value_pool_print(&pool);
 
     printf("Acquiring\n");
-    dpl_value_pool_acquire_item(&pool, string.as.string);
-    dpl_value_pool_acquire_item(&pool, object.as.object);
+    dpl_value_pool_acquire_item(&pool, dpl_value_as_string(string));
+    dpl_value_pool_acquire_item(&pool, dpl_value_as_object(object));
     dpl_value_pool_print(&pool);
 
     printf("Releasing array\n");
-    dpl_value_pool_release_item(&pool, array.as.array);
+    dpl_value_pool_release_item(&pool, dpl_value_as_array(array));
     dpl_value_pool_print(&pool);
 
     printf("Re-allocating another string\n");
@@ -35,11 +35,11 @@ int main()
     dpl_value_pool_print(&pool);
 
     printf("Releasing everything\n");
-    dpl_value_pool_release_item(&pool, string.as.string);
-    dpl_value_pool_release_item(&pool, string.as.string);
-    dpl_value_pool_release_item(&pool, object.as.object);
-    dpl_value_pool_release_item(&pool, object.as.object);
-    dpl_value_pool_release_item(&pool, string2.as.string);
+    dpl_value_pool_release_item(&pool, dpl_value_as_string(string));
+    dpl_value_pool_release_item(&pool, dpl_value_as_string(string));
+    dpl_value_pool_release_item(&pool, dpl_value_as_object(object));
+    dpl_value_pool_release_item(&pool, dpl_value_as_object(object));
+    dpl_value_pool_release_item(&pool, dpl_value_as_string(string2));
     dpl_value_pool_print(&pool);
 
     printf("Freeing pool\n");
@@ -0,0 +1,131 @@
+// DEFINE: DW_ERROR_STREAM=stdout
+// SOURCE: ./src/intrinsics.c
+// SOURCE: ./src/program.c
+// SOURCE: ./src/value.c
+// SOURCE: ./src/verifier.c
+
+#include <stdio.h>
+#include <dpl/verifier.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+#undef NOB_IMPLEMENTATION
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+void test_verify(const char *title, DPL_Program *program)
+{
+    printf("%s\n", title);
+    if (dplp_verify(program))
+    {
+        for (size_t i = 0; i < program->functions.count; ++i)
+        {
+            DPL_Program_Function function = program->functions.items[i];
+            printf("  function at %zu: arity %zu, max stack depth %zu\n",
+                   (size_t)function.begin_ip, function.arity, function.max_stack_depth);
+        }
+    }
+    else
+    {
+        printf("  rejected\n");
+    }
+    dplp_free(program);
+    *program = (DPL_Program){0};
+}
+
+int main()
+{
+    DPL_Program program = {0};
+
+    // function add1(x) := x + 1; add1(41) * 2
+    dplp_init(&program);
+    dplp_write_push_local(&program, 0);
+    dplp_write_push_number(&program, 1);
+    dplp_write_add_number(&program);
+    dplp_write_return(&program);
+    program.entry = program.code.count;
+    dplp_write_push_number(&program, 41);
+    dplp_write_call_user(&program, 1, 0);
+    dplp_write_push_number(&program, 2);
+    dplp_write_multiply(&program);
+    test_verify("Valid program", &program);
+
+    // if (true) "yes" else "no"
+    dplp_init(&program);
+    dplp_write_push_boolean(&program, true);
+    size_t then_jump = dplp_write_jump(&program, INST_JUMP_IF_FALSE);
+    dplp_write_pop(&program);
+    dplp_write_push_string(&program, "yes");
+    size_t else_jump = dplp_write_jump(&program, INST_JUMP);
+    dplp_patch_jump(&program, then_jump);
+    dplp_write_pop(&program);
+    dplp_write_push_string(&program, "no");
+    dplp_patch_jump(&program, else_jump);
+    test_verify("Valid conditional", &program);
+
+    dplp_init(&program);
+    dplp_write_push_number(&program, 1);
+    dplp_write_push_number(&program, 2);
+    test_verify("Values left at the end of the code", &program);
+
+    dplp_init(&program);
+    dplp_write_push_number(&program, 1);
+    dplp_write_add_number(&program);
+    test_verify("Stack underflow", &program);
+
+    dplp_init(&program);
+    dplp_write_push_number(&program, 1);
+    dplp_write_push_local(&program, 1);
+    test_verify("Invalid local slot", &program);
+
+    dplp_init(&program);
+    dplp_write_push_boolean(&program, true);
+    then_jump = dplp_write_jump(&program, INST_JUMP_IF_FALSE);
+    dplp_write_push_number(&program, 1);
+    dplp_patch_jump(&program, then_jump);
+    dplp_write_pop(&program);
+    test_verify("Inconsistent stack at jump target", &program);
+
+    dplp_init(&program);
+    dplp_write_push_boolean(&program, true);
+    dplp_write_jump(&program, INST_JUMP);
+    *(uint16_t *)(program.code.items + program.code.count - 2) = 1;
+    test_verify("Jump into the middle of an instruction", &program);
+
+    dplp_init(&program);
+    dplp_write_push_number(&program, 1);
+    dplp_write_call_intrinsic(&program, COUNT_INTRINSICS);
+    test_verify("Unknown intrinsic", &program);
+
+    dplp_init(&program);
+    dplp_write_push_number(&program, 1);
+    dplp_write_call_intrinsic(&program, INTRINSIC_ARRAY_ELEMENT);
+    test_verify("Missing intrinsic argument", &program);
+
+    dplp_init(&program);
+    dplp_write_push_string(&program, "constant");
+    *(uint64_t *)(program.code.items + program.code.count - 8) = 1000;
+    test_verify("Invalid string constant", &program);
+
+    dplp_init(&program);
+    dplp_write_push_number(&program, 1);
+    dplp_write_return(&program);
+    test_verify("Return outside of a function", &program);
+
+    dplp_init(&program);
+    dplp_write_push_number(&program, 1);
+    dplp_write_call_user(&program, 1, 1);
+    test_verify("Call into the middle of an instruction", &program);
+
+    dplp_init(&program);
+    dplp_write_push_number(&program, 1);
+    program.code.count -= 1;
+    test_verify("Truncated instruction", &program);
+
+    return 0;
+}
@@ -0,0 +1,78 @@
+// DEFINE: DPL_MEMORYVALUE_POOL_IDS
+// SOURCE: ./src/value.c
+#include <stdio.h>
+
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+
+#define ARENA_IMPLEMENTATION
+#define NOB_IMPLEMENTATION
+#include <dpl/value.h>
+
+#define ITEM_COUNT 10000
+#define ROUND_COUNT 100
+
+static DPL_MemoryValue* items[ITEM_COUNT];
+
+static size_t item_length(size_t round, size_t index)
+{
+    return (round * 7 + index * 13) % 200;
+}
+
+int main()
+{
+    DPL_MemoryValue_Pool pool = {0};
+    char data[256];
+    memset(data, 'x', sizeof(data));
+
+    printf("Churning %d items in %d rounds\n", ITEM_COUNT, ROUND_COUNT);
+    for (size_t round = 0; round < ROUND_COUNT; ++round)
+    {
+        for (size_t i = 0; i < ITEM_COUNT; ++i)
+        {
+            items[i] = dpl_value_pool_allocate_item(&pool, item_length(round, i));
+            items[i]->kind = VALUE_STRING;
+            memcpy(items[i]->data, data, items[i]->size);
+        }
+
+        for (size_t i = 0; i < ITEM_COUNT; ++i)
+        {
+            if (items[i]->size != item_length(round, i) || items[i]->capacity < items[i]->size)
+            {
+                printf("Round %zu: item %zu has wrong size.\n", round, i);
+                return 1;
+            }
+        }
+
+        for (size_t i = 0; i < ITEM_COUNT; ++i)
+        {
+            dpl_value_pool_release_item(&pool, items[i]);
+        }
+
+        if (round == 0 || round == ROUND_COUNT - 1)
+        {
+            printf("Round %zu: %llu items created\n", round, (unsigned long long)pool.next_id);
+        }
+    }
+
+    size_t free_count = 0;
+    for (size_t size_class = 0; size_class < DPL_MEMORYVALUE_POOL_SIZE_CLASSES; ++size_class)
+    {
+        for (DPL_MemoryValue* item = pool.freed[size_class]; item; item = item->next)
+        {
+            if (item->capacity != ((size_t)1 << size_class))
+            {
+                printf("Item #%llu is in the wrong size class.\n", (unsigned long long)item->id);
+                return 1;
+            }
+            free_count++;
+        }
+    }
+    printf("Free items: %zu\n", free_count);
+    printf("Used items: %s\n", pool.allocated ? "some" : "none");
+
+    dpl_value_pool_free(&pool);
+
+    stb_leakcheck_dumpmem();
+    return 0;
+}
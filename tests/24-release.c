@@ -0,0 +1,85 @@
+// DEFINE: DPL_MEMORYVALUE_POOL_IDS
+// SOURCE: ./src/intrinsics.c
+// SOURCE: ./src/program.c
+// SOURCE: ./src/value.c
+// SOURCE: ./src/verifier.c
+// SOURCE: ./src/vm.c
+// SOURCE: ./src/vm/intrinsics.c
+// SOURCE: ./src/vm/jit.c
+// SOURCE: ./src/vm/kernels.c
+#include <stdio.h>
+
+#include <dpl/vm/vm.h>
+
+#define ARENA_IMPLEMENTATION
+#include <arena.h>
+
+#define NOB_IMPLEMENTATION
+#include <nob.h>
+#include <nobx.h>
+#undef NOB_IMPLEMENTATION
+
+#define DW_BYTEBUFFER_IMPLEMENTATION
+#include <dw_byte_buffer.h>
+
+#define NESTING_DEPTH 1000000
+#define WIDE_COUNT 100
+
+size_t count_items(DPL_MemoryValue *item)
+{
+    size_t count = 0;
+    for (; item; item = item->next)
+    {
+        count++;
+    }
+    return count;
+}
+
+int main()
+{
+    DPL_VirtualMachine vm = {0};
+
+    printf("Many references\n");
+    DPL_Value string = dpl_value_make_string(&vm.stack_pool, 20, "not a small string!!");
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        dplv_reference(&vm, string);
+    }
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        dplv_release(&vm, string);
+    }
+    printf("  ref_count: %u, used items: %zu\n", dpl_value_as_string(string)->ref_count, count_items(vm.stack_pool.allocated));
+    dplv_release(&vm, string);
+    printf("  used items: %zu\n", count_items(vm.stack_pool.allocated));
+
+    printf("Deeply nested arrays\n");
+    DPL_Value array = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+    for (size_t i = 0; i < NESTING_DEPTH; ++i)
+    {
+        array = dpl_value_make_array(&vm.stack_pool, 1, &array);
+    }
+    printf("  used items: %zu\n", count_items(vm.stack_pool.allocated));
+    dplv_release(&vm, array);
+    printf("  used items: %zu\n", count_items(vm.stack_pool.allocated));
+
+    printf("Incremental release\n");
+    vm.release_budget = 10;
+    DPL_Value elements[WIDE_COUNT];
+    for (size_t i = 0; i < WIDE_COUNT; ++i)
+    {
+        elements[i] = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+    }
+    array = dpl_value_make_array(&vm.stack_pool, WIDE_COUNT, elements);
+    dplv_release(&vm, array);
+    printf("  used items: %zu, pending: %zu\n", count_items(vm.stack_pool.allocated), vm.release_queue.count);
+    DPL_Value other = dpl_value_make_array(&vm.stack_pool, 0, NULL);
+    dplv_release(&vm, other);
+    printf("  used items: %zu, pending: %zu\n", count_items(vm.stack_pool.allocated), vm.release_queue.count);
+    dplv_release_pending(&vm, 0);
+    printf("  used items: %zu, pending: %zu\n", count_items(vm.stack_pool.allocated), vm.release_queue.count);
+
+    nob_da_free(vm.release_queue);
+    dpl_value_pool_free(&vm.stack_pool);
+    return 0;
+}
@@ -0,0 +1,78 @@
+// SOURCE: ./src/value.c
+#include <stdio.h>
+
+#define STB_LEAKCHECK_IMPLEMENTATION
+#include <stb_leakcheck.h>
+
+#define ARENA_IMPLEMENTATION
+#define NOB_IMPLEMENTATION
+#include <dpl/value.h>
+
+static const char *yes_no(bool value)
+{
+    return value ? "yes" : "no";
+}
+
+static void compare(const char *title, DPL_Value value1, DPL_Value value2)
+{
+    printf("%s: equal %s, same hash %s\n", title, yes_no(dpl_value_equals(value1, value2)),
+           yes_no(dpl_value_hash(value1) == dpl_value_hash(value2)));
+}
+
+int main()
+{
+    DPL_MemoryValue_Pool pool = {0};
+
+    const char *text = "a string that is stored in the pool";
+    DPL_Value string1 = dpl_value_make_string(&pool, strlen(text), text);
+    DPL_Value string2 = dpl_value_make_string(&pool, strlen(text), text);
+    DPL_Value other = dpl_value_make_string(&pool, strlen(text), "a string that is stored in the POOL");
+    compare("Equal strings", string1, string2);
+    compare("Different strings", string1, other);
+    compare("Small strings", dpl_value_make_string(&pool, 3, "abc"), dpl_value_make_string(&pool, 3, "abc"));
+
+    printf("Hash cached: %s\n", yes_no(dpl_value_as_string(string1)->hash != 0));
+    string1 = dpl_value_string_append(&pool, dpl_value_as_string(string1), 1, "!");
+    string2 = dpl_value_string_append(&pool, dpl_value_as_string(string2), 1, "?");
+    compare("Appended strings", string1, string2);
+
+    DPL_Value numbers1 = dpl_value_make_array(&pool, DPL_VALUES(dpl_value_make_number(1), dpl_value_make_number(2)));
+    DPL_Value numbers2 = dpl_value_make_array(&pool, DPL_VALUES(dpl_value_make_number(1), dpl_value_make_number(2.000001)));
+    DPL_Value numbers3 = dpl_value_make_array(&pool, DPL_VALUES(dpl_value_make_number(1), dpl_value_make_number(3)));
+    compare("Numbers within tolerance", numbers1, numbers2);
+    compare("Different numbers", numbers1, numbers3);
+
+    dpl_value_pool_acquire_item(&pool, dpl_value_as_string(string1));
+    dpl_value_pool_acquire_item(&pool, dpl_value_as_string(string2));
+    DPL_Value object1 = dpl_value_make_object(&pool, DPL_VALUES(dpl_value_make_boolean(true), string1));
+    DPL_Value object2 = dpl_value_make_object(&pool, DPL_VALUES(dpl_value_make_boolean(true), string2));
+    compare("Objects with different strings", object1, object2);
+
+    DPL_Value fields[] = {dpl_value_make_boolean(true), string1};
+    dpl_value_pool_acquire_item(&pool, dpl_value_as_string(string1));
+    dpl_value_object_overwrite(dpl_value_as_object(object2), 2, fields);
+    dpl_value_pool_release_item(&pool, dpl_value_as_string(fields[1]));
+    compare("Overwritten object", object1, object2);
+
+    DPL_Value array1 = dpl_value_make_array(&pool, DPL_VALUES(object1));
+    dpl_value_pool_acquire_item(&pool, dpl_value_as_object(object1));
+    DPL_Value array2 = dpl_value_make_array(&pool, DPL_VALUES(object1));
+    compare("Arrays of objects", array1, array2);
+    dpl_value_pool_acquire_item(&pool, dpl_value_as_object(object2));
+    array2 = dpl_value_array_append(&pool, dpl_value_as_array(array2), object2);
+    compare("Appended array", array1, array2);
+
+    DPL_Value elements[300];
+    for (size_t i = 0; i < NOB_ARRAY_LEN(elements); ++i)
+    {
+        elements[i] = dpl_value_make_number(i);
+    }
+    DPL_Value trie = dpl_value_make_array(&pool, NOB_ARRAY_LEN(elements), elements);
+    DPL_Value flat = dpl_value_make_array_flat(&pool, dpl_value_as_array(trie));
+    compare("Flat and trie number arrays", flat, trie);
+
+    dpl_value_pool_free(&pool);
+
+    stb_leakcheck_dumpmem();
+    return 0;
+}